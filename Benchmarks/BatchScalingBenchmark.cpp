@@ -0,0 +1,107 @@
+//
+//  BatchScalingBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  Throughput of VX1BatchRenderer at 1/2/4/8/16 render threads on a synthetic
+//  batch of stereo stems, with speedup and parallel efficiency against 1 thread.
+//  Scaling is bounded by the cores actually available (printed first).
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VX1AudioFile.hpp"
+#include "VX1BatchRenderer.hpp"
+
+namespace {
+
+constexpr int kFileCount = 32;
+constexpr double kSampleRate = 48000.0;
+constexpr double kMinSeconds = 4.0;     // file lengths vary between kMinSeconds and 2·kMinSeconds
+constexpr int kThreadCounts[] = { 1, 2, 4, 8, 16 };
+
+/// Writes kFileCount stereo float WAVs of uneven length; returns their paths.
+std::vector<std::string> makeCorpus(const std::filesystem::path& directory) {
+    std::vector<std::string> paths;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (int file = 0; file < kFileCount; ++file) {
+        const int frames = (int)(kSampleRate * kMinSeconds * (1.0 + (double)(file % 8) / 8.0));
+        const std::string path = (directory / ("stem" + std::to_string(file) + ".wav")).string();
+        VX1AudioFileWriter writer(path, { 2, kSampleRate, VX1SampleEncoding::float32 }, false);
+
+        std::vector<float> interleaved((size_t)frames * 2);
+        const float pitch = 110.0f * (float)(1 + file % 5);
+        for (int i = 0; i < frames; ++i) {
+            const float t = (float)i / (float)kSampleRate;
+            const float envelope = 0.5f + 0.5f * std::sin(2.0f * (float)M_PI * 3.0f * t);
+            const float x = envelope * (0.5f * std::sin(2.0f * (float)M_PI * pitch * t) + 0.05f * noise(rng));
+            interleaved[2 * (size_t)i] = x;
+            interleaved[2 * (size_t)i + 1] = 0.8f * x;
+        }
+        writer.write(interleaved.data(), frames);
+        writer.close();
+        paths.push_back(path);
+    }
+    return paths;
+}
+
+}
+
+int main() {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / ("vx1_batch_bench_" + std::to_string(std::random_device {}()));
+    std::filesystem::create_directories(root / "out");
+
+    int status = 0;
+    try {
+        const std::vector<std::string> inputs = makeCorpus(root);
+        std::vector<VX1BatchJob> jobs;
+        for (const std::string& input : inputs) {
+            jobs.push_back({ input, (root / "out" / std::filesystem::path(input).filename()).string() });
+        }
+
+        VX1RenderSettings settings;
+        settings.setParameter("compress", 50.0f);
+        settings.setParameter("bite", 60.0f);
+        settings.setParameter("oversampling", 1.0f);
+
+        std::printf("Batch render: %d stereo stems @ %.0f Hz, hardware concurrency %u\n",
+                    kFileCount, kSampleRate, std::thread::hardware_concurrency());
+        std::printf("%-8s %12s %14s %10s %12s %18s\n", "threads", "wall s", "x realtime", "speedup", "efficiency", "slowest file (x)");
+
+        double baseline = 0.0;
+        for (int threads : kThreadCounts) {
+            VX1BatchOptions batchOptions;
+            batchOptions.threadCount = threads;
+            VX1BatchRenderer renderer(settings, VX1RenderOptions {}, batchOptions);
+
+            VX1BatchStats stats;
+            const std::vector<VX1BatchFileResult> results = renderer.render(jobs, &stats);
+            double slowest = 1e30;
+            for (const VX1BatchFileResult& result : results) {
+                if (!result.succeeded) throw std::runtime_error(result.job.inputPath + ": " + result.error);
+                slowest = std::min(slowest, result.stats.realtimeFactor());
+            }
+
+            if (threads == 1) baseline = stats.realtimeFactor();
+            const double speedup = baseline > 0.0 ? stats.realtimeFactor() / baseline : 0.0;
+            std::printf("%-8d %12.2f %14.1f %10.2f %11.0f%% %18.1f\n", threads, stats.wallSeconds,
+                        stats.realtimeFactor(), speedup, 100.0 * speedup / threads, slowest);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "vx1_batch_scaling_bench: %s\n", e.what());
+        status = 1;
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(root, error);
+    return status;
+}
@@ -0,0 +1,577 @@
+//
+//  DSPStageBenchmarks.cpp
+//  VX1 Benchmarks
+//
+//  Google Benchmark suite: time per sample of every DSP stage in VX1Extension/DSP and of
+//  the full kernel across channel counts, block sizes and sample rates.
+//
+//  JSON for regression tracking:
+//    vx1_dsp_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+//  (or `cmake --build <dir> --target vx1_dsp_benchmarks_json`), then compare two
+//  runs with Google Benchmark's tools/compare.py.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+#include "TubeSaturation.hpp"
+#include "TaylorWarmTube.hpp"
+#include "TaylorAggressiveTube.hpp"
+
+namespace {
+
+constexpr int kStageFrames = 512;
+
+/// Adds items_per_second and per_sample (seconds per channel-sample: printed as e.g.
+/// "6.4ns", stored in the JSON in seconds). kInvert on an iteration-invariant rate
+/// makes Google Benchmark divide elapsed time by (samples · iterations).
+void reportSamples(benchmark::State& state, int64_t samplesPerIteration) {
+    state.SetItemsProcessed(state.iterations() * samplesPerIteration);
+    state.counters["per_sample"] = benchmark::Counter((double)samplesPerIteration,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// Vocal-like test signal: a 180 Hz pulse train with syllable envelope and noise.
+std::vector<float> makeSignal(int frames, double sampleRate, unsigned seed = 1) {
+    std::vector<float> signal(frames);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (int i = 0; i < frames; ++i) {
+        const float t = (float)i / (float)sampleRate;
+        const float syllable = 0.5f + 0.5f * std::sin(2.0f * (float)M_PI * 4.0f * t);
+        const float voiced = std::tanh(4.0f * std::sin(2.0f * (float)M_PI * 180.0f * t));
+        signal[i] = syllable * (0.5f * voiced + 0.05f * noise(rng));
+    }
+    return signal;
+}
+
+/// Initializes the kernel for channelCount channels at the given rate with a vocal setting.
+void prepareKernel(VX1ExtensionDSPKernel& kernel, int channelCount, double sampleRate, int maxFrames) {
+    kernel.setMaximumFramesToRender((AUAudioFrameCount)maxFrames);
+    kernel.setParameter(VX1ExtensionParameterAddress::compress, 50.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::speed, 20.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::grip, 30.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::bite, 40.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::stack, 50.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::gateThreshold, -60.0f);
+    kernel.initialize(channelCount, channelCount, sampleRate);
+}
+
+// MARK: - Detection stages
+//
+// The block engine fuses these into one recursion (processBlock, stage 2). Each
+// benchmark below runs one piece of that recursion on its own with the kernel's
+// coefficients, so a regression can be attributed to a stage.
+
+void BM_Gate(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, 1, sampleRate, kStageFrames);
+    std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    for (float& x : input) x = std::abs(x);
+    std::vector<float> gate(kStageFrames);
+
+    const float threshold = kernel.mGainComputer.gateThresholdLinear();
+    float envelope = 0.0f, gateGain = 1.0f;
+    int holdCounter = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < kStageFrames; ++i) {
+            const float rawMono = input[i];
+            const float coeff = rawMono > envelope ? kernel.mDetector.gateAttackCoeff : kernel.mDetector.gateReleaseCoeff;
+            envelope = coeff * envelope + (1.0f - coeff) * rawMono;
+            if (envelope >= threshold) {
+                holdCounter = kernel.mDetector.gateHoldSamples;
+                gateGain = 1.0f;
+            } else if (holdCounter > 0) {
+                holdCounter--;
+                gateGain = 1.0f;
+            } else {
+                gateGain *= kernel.mDetector.gateReleaseCoeff;
+            }
+            gate[i] = gateGain;
+        }
+        benchmark::DoNotOptimize(gate.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+void BM_SidechainHpf(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, 1, sampleRate, kStageFrames);
+    const std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    std::vector<float> output(kStageFrames);
+
+    for (auto _ : state) {
+        for (int i = 0; i < kStageFrames; ++i) {
+            output[i] = kernel.applyHpf(input[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+/// range(1) = Grip %: 0 = RMS only, 100 = peak only.
+void BM_Detector(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    const float gripBlend = (float)state.range(1) / 100.0f;
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, 1, sampleRate, kStageFrames);
+    std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    for (float& x : input) x = std::abs(x);
+    std::vector<float> envelopeOut(kStageFrames);
+
+    const float attackCoeff = kernel.mDetector.attackCoeff * (1.0f - gripBlend) + kernel.mDetector.instantCoeff * gripBlend;
+    float rmsState = 0.0f, envelope = 0.0f;
+    for (auto _ : state) {
+        for (int i = 0; i < kStageFrames; ++i) {
+            const float absFiltered = input[i];
+            rmsState = kernel.mDetector.rmsCoeff * rmsState + (1.0f - kernel.mDetector.rmsCoeff) * (absFiltered * absFiltered);
+            const float detectionLevel = std::sqrt(rmsState) * (1.0f - gripBlend) + absFiltered * gripBlend;
+            const float coeff = detectionLevel > envelope ? attackCoeff : kernel.mDetector.releaseCoeff;
+            envelope = coeff * envelope + (1.0f - coeff) * detectionLevel;
+            envelopeOut[i] = envelope;
+        }
+        benchmark::DoNotOptimize(envelopeOut.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+void BM_GainComputer(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, 1, sampleRate, kStageFrames);
+    std::vector<float> envelope = makeSignal(kStageFrames, sampleRate);
+    for (float& x : envelope) x = std::abs(x);
+    std::vector<float> gain(kStageFrames);
+
+    const VX1ExtensionGainComputer gainComputer = kernel.mGainComputer;
+    for (auto _ : state) {
+        for (int i = 0; i < kStageFrames; ++i) {
+            gain[i] = VX1ExtensionGainComputer::gain(gainComputer.gainReductionDb(envelope[i]));
+        }
+        benchmark::DoNotOptimize(gain.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+/// Stack's second pass: detector, gain computer and overshoot on the post-pass-1 signal.
+void BM_StackPass(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, 1, sampleRate, kStageFrames);
+    std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    for (float& x : input) x = std::abs(x);
+    std::vector<float> gain(kStageFrames);
+
+    const VX1ExtensionGainComputer gainComputer = kernel.mGainComputer;
+    const float gripBlend = kernel.mParameters.gripPercent / 100.0f;
+    const float attackCoeff = kernel.mDetector.attackCoeff * (1.0f - gripBlend) + kernel.mDetector.instantCoeff * gripBlend;
+    float rmsState = 0.0f, envelope = 0.0f, prevGainReductionDb = 0.0f, overshootDb = 0.0f;
+    int overshootHoldCounter = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < kStageFrames; ++i) {
+            const float absPost1 = input[i];
+            rmsState = kernel.mDetector.rmsCoeff * rmsState + (1.0f - kernel.mDetector.rmsCoeff) * (absPost1 * absPost1);
+            const float detectionLevel = std::sqrt(rmsState) * (1.0f - gripBlend) + absPost1 * gripBlend;
+            const float coeff = detectionLevel > envelope ? attackCoeff : kernel.mDetector.releaseCoeff;
+            envelope = coeff * envelope + (1.0f - coeff) * detectionLevel;
+
+            const float gainReductionDb = gainComputer.gainReductionDb2(envelope);
+            if (gainReductionDb - prevGainReductionDb > 3.0f) {
+                overshootDb = 3.0f;
+                overshootHoldCounter = kernel.mDetector.overshootHoldSamples;
+            }
+            prevGainReductionDb = gainReductionDb;
+            if (overshootHoldCounter > 0) {
+                overshootHoldCounter--;
+            } else {
+                overshootDb *= kernel.mDetector.overshootReleaseCoeff;
+            }
+            gain[i] = VX1ExtensionGainComputer::gain(gainReductionDb + overshootDb);
+        }
+        benchmark::DoNotOptimize(gain.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+// MARK: - Saturation stages
+
+/// Block-engine Bite (applySaturationBlock, shelves SIMD across channel lanes).
+/// range(1) = oversampling index 0…3, range(2) = channels.
+void BM_BiteSaturation(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    const int channelCount = (int)state.range(2);
+    VX1ExtensionDSPKernel kernel;
+    kernel.setParameter(VX1ExtensionParameterAddress::oversampling, (float)state.range(1));
+    prepareKernel(kernel, channelCount, sampleRate, kStageFrames);
+    const std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    std::vector<std::vector<float>> buffers(channelCount, std::vector<float>(kStageFrames));
+    std::vector<float*> pointers(channelCount);
+    for (int channel = 0; channel < channelCount; ++channel) pointers[channel] = buffers[channel].data();
+
+    for (auto _ : state) {
+        for (std::vector<float>& buffer : buffers) std::copy(input.begin(), input.end(), buffer.begin());
+        kernel.applySaturationBlock(pointers, kStageFrames);
+        benchmark::DoNotOptimize(pointers.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kStageFrames * channelCount);
+}
+
+/// Scalar-engine Bite (applySaturation, one sample of one channel at a time). range(1) = channels.
+void BM_BiteSaturationScalar(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    const int channelCount = (int)state.range(1);
+    VX1ExtensionDSPKernel kernel;
+    prepareKernel(kernel, channelCount, sampleRate, kStageFrames);
+    const std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    std::vector<float> output(kStageFrames);
+
+    for (auto _ : state) {
+        for (int channel = 0; channel < channelCount; ++channel) {
+            for (int i = 0; i < kStageFrames; ++i) {
+                output[i] = kernel.applySaturation(input[i], channel);
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kStageFrames * channelCount);
+}
+
+template <typename Tube>
+void BM_Tube(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    Tube tube;
+    tube.setSampleRate(sampleRate);
+    tube.setEnabled(true);
+    const std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    std::vector<float> buffer(kStageFrames);
+
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), buffer.begin());
+        tube.processBuffer(buffer.data(), kStageFrames);
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, kStageFrames);
+}
+
+// MARK: - Output limiter
+
+/// Lookahead limiter alone, signal driven ~12 dB over the ceiling so the release
+/// and box filter never idle. range(1) = channels.
+void BM_LookaheadLimiter(benchmark::State& state) {
+    const double sampleRate = (double)state.range(0);
+    const int channelCount = (int)state.range(1);
+    VX1LookaheadLimiter limiter;
+    limiter.prepare(channelCount, sampleRate, kStageFrames);
+    limiter.setCeilingDb(-1.0f);
+    std::vector<float> input = makeSignal(kStageFrames, sampleRate);
+    for (float& sample : input) sample *= 4.0f;
+    std::vector<std::vector<float>> buffers(channelCount, std::vector<float>(kStageFrames));
+    std::vector<float*> pointers(channelCount);
+    for (int channel = 0; channel < channelCount; ++channel) pointers[channel] = buffers[channel].data();
+
+    for (auto _ : state) {
+        for (std::vector<float>& buffer : buffers) std::copy(input.begin(), input.end(), buffer.begin());
+        benchmark::DoNotOptimize(limiter.process(pointers, kStageFrames));
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kStageFrames * channelCount);
+}
+
+// MARK: - Full kernel
+
+/// range(0) = channels, range(1) = block frames, range(2) = sample rate, range(3) = engine (0 block, 1 scalar).
+/// With `automated`, every block starts a block-long ramp on compress, speed, makeup gain and
+/// mix, so the smoothed-parameter paths run on every frame.
+void runKernel(benchmark::State& state, int sidechainLink, bool automated = false) {
+    const int channelCount = (int)state.range(0);
+    const int blockFrames = (int)state.range(1);
+    const double sampleRate = (double)state.range(2);
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.setProcessingEngine(state.range(3) == 0 ? VX1ExtensionDSPKernel::Engine::block
+                                                   : VX1ExtensionDSPKernel::Engine::scalar);
+    kernel.setParameter(VX1ExtensionParameterAddress::sidechainLink, (float)sidechainLink);
+    prepareKernel(kernel, channelCount, sampleRate, blockFrames);
+
+    std::vector<std::vector<float>> input, output(channelCount, std::vector<float>(blockFrames));
+    std::vector<const float*> in(channelCount);
+    std::vector<float*> out(channelCount);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        input.push_back(makeSignal(blockFrames, sampleRate, 1 + channel));
+        in[channel] = input[channel].data();
+        out[channel] = output[channel].data();
+    }
+
+    AUEventSampleTime now = 0;
+    bool up = false;
+    for (auto _ : state) {
+        if (automated) {
+            up = !up;
+            const AUAudioFrameCount ramp = (AUAudioFrameCount)blockFrames;
+            kernel.handleParameterEvent(now, VX1ExtensionParameterAddress::compress, up ? 60.0f : 40.0f, ramp);
+            kernel.handleParameterEvent(now, VX1ExtensionParameterAddress::speed, up ? 30.0f : 10.0f, ramp);
+            kernel.handleParameterEvent(now, VX1ExtensionParameterAddress::makeupGain, up ? 6.0f : 0.0f, ramp);
+            kernel.handleParameterEvent(now, VX1ExtensionParameterAddress::mix, up ? 80.0f : 100.0f, ramp);
+        }
+        kernel.process(in, out, now, (AUAudioFrameCount)blockFrames);
+        now += blockFrames;
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)blockFrames * channelCount);
+}
+
+void BM_Kernel(benchmark::State& state) {
+    runKernel(state, 0);
+}
+
+/// BM_Kernel arguments plus range(4) = sidechain link (0 all, 1 LCR, 2 unlinked, 3 max).
+void BM_KernelLink(benchmark::State& state) {
+    runKernel(state, (int)state.range(4));
+}
+
+/// BM_Kernel arguments with compress, speed, makeup and mix ramping continuously.
+void BM_KernelAutomated(benchmark::State& state) {
+    runKernel(state, 0, true);
+}
+
+/**
+ Block engine variants: one configuration per run, with the specialized variant or the
+ generic path. range(0) = channels, range(1) = Stack on, range(2) = gate moving (threshold
+ -20 dB on a signal that crosses it; otherwise -80 dB, held open), range(3) = Bite on,
+ range(4) = mix (100 or 70 %), range(5) = specialized variants on. 512-frame blocks, 48 kHz.
+ */
+void BM_KernelVariant(benchmark::State& state) {
+    constexpr int kBlockFrames = 512;
+    constexpr double kSampleRate = 48000.0;
+    const int channelCount = (int)state.range(0);
+    const bool gateMoving = state.range(2) != 0;
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.setBlockVariants(state.range(5) != 0);
+    kernel.setParameter(VX1ExtensionParameterAddress::stack, state.range(1) != 0 ? 50.0f : 0.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::bite, state.range(3) != 0 ? 40.0f : 0.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::mix, (float)state.range(4));
+    kernel.setMaximumFramesToRender(kBlockFrames);
+    kernel.setParameter(VX1ExtensionParameterAddress::compress, 50.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::speed, 20.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::grip, 30.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::gateThreshold, gateMoving ? -20.0f : -80.0f);
+    kernel.initialize(channelCount, channelCount, kSampleRate);
+
+    // A second of signal, streamed block by block so the gate sees the syllables come and go
+    const int signalFrames = (int)kSampleRate / kBlockFrames * kBlockFrames;
+    std::vector<std::vector<float>> input, output(channelCount, std::vector<float>(kBlockFrames));
+    std::vector<const float*> in(channelCount);
+    std::vector<float*> out(channelCount);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        input.push_back(makeSignal(signalFrames, kSampleRate, 1 + channel));
+        if (gateMoving) {
+            for (float& sample : input.back()) sample *= 0.25f;
+        }
+        out[channel] = output[channel].data();
+    }
+
+    AUEventSampleTime now = 0;
+    int position = 0;
+    for (auto _ : state) {
+        for (int channel = 0; channel < channelCount; ++channel) in[channel] = input[channel].data() + position;
+        kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames);
+        now += kBlockFrames;
+        position = (position + kBlockFrames) % signalFrames;
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kBlockFrames * channelCount);
+}
+
+/**
+ Multiband cost against the single-band kernel: range(0) = channels, range(1) = multiband
+ (0 single band, 1–3 = 2–4 bands). The vocal setting with Stack off, which the bands skip,
+ so every run does the same work apart from the split; 512-frame blocks, 48 kHz.
+ */
+void BM_KernelMultiband(benchmark::State& state) {
+    constexpr int kBlockFrames = 512;
+    constexpr double kSampleRate = 48000.0;
+    const int channelCount = (int)state.range(0);
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.setParameter(VX1ExtensionParameterAddress::multiband, (float)state.range(1));
+    prepareKernel(kernel, channelCount, kSampleRate, kBlockFrames);
+    kernel.setParameter(VX1ExtensionParameterAddress::stack, 0.0f);
+
+    std::vector<std::vector<float>> input, output(channelCount, std::vector<float>(kBlockFrames));
+    std::vector<const float*> in(channelCount);
+    std::vector<float*> out(channelCount);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        input.push_back(makeSignal(kBlockFrames, kSampleRate, 1 + channel));
+        in[channel] = input[channel].data();
+        out[channel] = output[channel].data();
+    }
+
+    AUEventSampleTime now = 0;
+    for (auto _ : state) {
+        kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames);
+        now += kBlockFrames;
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kBlockFrames * channelCount);
+}
+
+/**
+ One 512-frame stereo buffer per iteration carrying range(0) parameter events,
+ evenly spaced and alternating between makeup gain and mix (per-sample automation
+ at 512). range(1) = how the buffer reaches the kernel:
+   0  one process() call per gap between events (the previous processWithEvents loop)
+   N  one process(…, timeline) call with minimum segment N (1 = split at every event)
+ */
+void BM_KernelEvents(benchmark::State& state) {
+    constexpr int kChannels = 2, kBlockFrames = 512;
+    constexpr double kSampleRate = 48000.0;
+    const int eventCount = (int)state.range(0);
+    const int minSegment = (int)state.range(1);
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.setMinimumSegmentFrames((AUAudioFrameCount)std::max(minSegment, 1));
+    prepareKernel(kernel, kChannels, kSampleRate, kBlockFrames);
+
+    std::vector<std::vector<float>> input, output(kChannels, std::vector<float>(kBlockFrames));
+    std::vector<const float*> in(kChannels);
+    std::vector<float*> out(kChannels);
+    for (int channel = 0; channel < kChannels; ++channel) {
+        input.push_back(makeSignal(kBlockFrames, kSampleRate, 1 + channel));
+        in[channel] = input[channel].data();
+        out[channel] = output[channel].data();
+    }
+
+    VX1ParameterTimeline timeline;
+    for (int event = 0; event < eventCount; ++event) {
+        const bool makeup = event % 2 == 0;
+        timeline.push((AUAudioFrameCount)(event * kBlockFrames / eventCount),
+                      makeup ? VX1ExtensionParameterAddress::makeupGain : VX1ExtensionParameterAddress::mix,
+                      makeup ? (float)(event % 7) : 70.0f + (float)(event % 30));
+    }
+    const std::span<const VX1TimelineEvent> events = timeline.events();
+
+    AUEventSampleTime now = 0;
+    std::vector<const float*> segmentIn(kChannels);
+    std::vector<float*> segmentOut(kChannels);
+    for (auto _ : state) {
+        if (minSegment > 0) {
+            kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames, timeline);
+        } else {
+            size_t next = 0;
+            int start = 0;
+            while (start < kBlockFrames) {
+                while (next < events.size() && (int)events[next].frameOffset <= start) {
+                    kernel.handleParameterEvent(now + start, events[next].address, events[next].value);
+                    ++next;
+                }
+                const int end = next < events.size() ? (int)events[next].frameOffset : kBlockFrames;
+                for (int channel = 0; channel < kChannels; ++channel) {
+                    segmentIn[channel] = in[channel] + start;
+                    segmentOut[channel] = out[channel] + start;
+                }
+                kernel.process(segmentIn, segmentOut, now + start, (AUAudioFrameCount)(end - start));
+                start = end;
+            }
+        }
+        now += kBlockFrames;
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kBlockFrames * kChannels);
+}
+
+/**
+ 512-frame stereo buffers of digital silence after a second of signal and ten seconds
+ of release, so every tail has decayed. range(0) = silent-block fast path (0 off: the
+ engine runs on the silence, with FTZ/DAZ and state flushing keeping it free of
+ subnormals; 1 on: zeros written without running the engine).
+ */
+void BM_KernelSilence(benchmark::State& state) {
+    constexpr int kChannels = 2, kBlockFrames = 512;
+    constexpr double kSampleRate = 48000.0;
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.setSilenceSkipping(state.range(0) != 0);
+    prepareKernel(kernel, kChannels, kSampleRate, kBlockFrames);
+
+    const int signalFrames = (int)kSampleRate;
+    std::vector<std::vector<float>> signal, silence(kChannels, std::vector<float>(kBlockFrames, 0.0f));
+    std::vector<std::vector<float>> output(kChannels, std::vector<float>(kBlockFrames));
+    std::vector<const float*> in(kChannels);
+    std::vector<float*> out(kChannels);
+    for (int channel = 0; channel < kChannels; ++channel) {
+        signal.push_back(makeSignal(signalFrames, kSampleRate, 1 + channel));
+        out[channel] = output[channel].data();
+    }
+
+    AUEventSampleTime now = 0;
+    for (int start = 0; start + kBlockFrames <= signalFrames; start += kBlockFrames, now += kBlockFrames) {
+        for (int channel = 0; channel < kChannels; ++channel) in[channel] = signal[channel].data() + start;
+        kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames);
+    }
+    for (int channel = 0; channel < kChannels; ++channel) in[channel] = silence[channel].data();
+    for (int block = 0; block < 10 * (int)kSampleRate / kBlockFrames; ++block, now += kBlockFrames) {
+        kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames);
+    }
+
+    for (auto _ : state) {
+        kernel.process(in, out, now, (AUAudioFrameCount)kBlockFrames);
+        now += kBlockFrames;
+        benchmark::ClobberMemory();
+    }
+    reportSamples(state, (int64_t)kBlockFrames * kChannels);
+}
+
+const std::vector<int64_t> kSampleRates = { 44100, 48000, 96000, 192000 };
+
+}
+
+BENCHMARK(BM_Gate)->ArgNames({ "rate" })->ArgsProduct({ kSampleRates });
+BENCHMARK(BM_SidechainHpf)->ArgNames({ "rate" })->ArgsProduct({ kSampleRates });
+BENCHMARK(BM_Detector)->ArgNames({ "rate", "grip" })->ArgsProduct({ { 48000 }, { 0, 50, 100 } });
+BENCHMARK(BM_GainComputer)->ArgNames({ "rate" })->ArgsProduct({ { 48000 } });
+BENCHMARK(BM_StackPass)->ArgNames({ "rate" })->ArgsProduct({ kSampleRates });
+BENCHMARK(BM_BiteSaturation)->ArgNames({ "rate", "os", "ch" })->ArgsProduct({ kSampleRates, { 0, 1, 2, 3 }, { 1 } });
+BENCHMARK(BM_BiteSaturation)->ArgNames({ "rate", "os", "ch" })->ArgsProduct({ { 48000 }, { 0 }, { 2, 3, 4, 6, 8, 16 } });
+BENCHMARK(BM_BiteSaturationScalar)->ArgNames({ "rate", "ch" })->ArgsProduct({ { 48000 }, { 1, 2, 6, 8, 16 } });
+BENCHMARK(BM_Tube<TubeSaturation>)->ArgNames({ "rate" })->ArgsProduct({ { 48000 } });
+BENCHMARK(BM_Tube<TaylorWarmTube>)->ArgNames({ "rate" })->ArgsProduct({ { 48000 } });
+BENCHMARK(BM_Tube<TaylorAggressiveTube>)->ArgNames({ "rate" })->ArgsProduct({ { 48000 } });
+BENCHMARK(BM_LookaheadLimiter)->ArgNames({ "rate", "ch" })->ArgsProduct({ kSampleRates, { 1, 2, 6 } });
+BENCHMARK(BM_Kernel)
+    ->ArgNames({ "ch", "block", "rate", "scalar" })
+    ->ArgsProduct({ { 1, 2, 6, 8 }, { 16, 64, 256, 1024, 4096 }, kSampleRates, { 0 } });
+BENCHMARK(BM_Kernel)
+    ->ArgNames({ "ch", "block", "rate", "scalar" })
+    ->ArgsProduct({ { 1, 2, 6, 8 }, { 512 }, { 48000 }, { 1 } });
+BENCHMARK(BM_KernelAutomated)
+    ->ArgNames({ "ch", "block", "rate", "scalar" })
+    ->ArgsProduct({ { 2 }, { 64, 512 }, { 48000 }, { 0, 1 } });
+BENCHMARK(BM_KernelEvents)
+    ->ArgNames({ "events", "min_segment" })
+    ->ArgsProduct({ { 0, 8, 64, 512 }, { 0, 1, VX1ExtensionDSPKernel::kDefaultMinSegmentFrames } });
+BENCHMARK(BM_KernelVariant)
+    ->ArgNames({ "ch", "stack", "gate", "bite", "mix", "variants" })
+    ->ArgsProduct({ { 1, 2 }, { 0, 1 }, { 0, 1 }, { 0, 1 }, { 100, 70 }, { 0, 1 } });
+BENCHMARK(BM_KernelMultiband)->ArgNames({ "ch", "multiband" })->ArgsProduct({ { 1, 2 }, { 0, 1, 2, 3 } });
+BENCHMARK(BM_KernelSilence)->ArgNames({ "skip" })->ArgsProduct({ { 0, 1 } });
+BENCHMARK(BM_KernelLink)
+    ->ArgNames({ "ch", "block", "rate", "scalar", "link" })
+    ->ArgsProduct({ { 2, 6, 12, 16 }, { 512 }, { 48000 }, { 0 }, { 0, 1, 2, 3 } });
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+//
+//  DetectorPrecisionBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  Render cost and noise floor of the two detector precisions (single, double) at
+//  44.1–192 kHz. The noise floor is the RMS and peak of the single render's
+//  difference from the double render, in dB relative to full scale, on a slow,
+//  RMS-heavy setting where the detector's coefficients sit closest to 1.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+
+namespace {
+
+using Precision = VX1ExtensionDSPKernel::DetectorPrecision;
+
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 512;
+constexpr double kSeconds = 4.0;
+constexpr int kRepetitions = 3;         // best of
+constexpr double kSampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0 };
+
+struct Combination {
+    Precision precision;
+    const char* name;
+};
+
+constexpr Combination kCombinations[] = {
+    { Precision::single,  "single" },
+    { Precision::double_, "double" },
+};
+
+/// A sung phrase: pitched pulse with vibrato, a syllable envelope, breath noise and
+/// quiet tails between phrases, so the gate, the RMS window and the release all work.
+std::vector<std::vector<float>> makeInput(double sampleRate) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const size_t frames = (size_t)(kSeconds * sampleRate);
+    std::vector<std::vector<float>> input(kChannels, std::vector<float>(frames));
+    double phase = 0.0;
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = (double)i / sampleRate;
+        phase += 2.0 * M_PI * 180.0 * (1.0 + 0.01 * std::sin(2.0 * M_PI * 5.5 * t)) / sampleRate;
+        const double syllable = std::max(0.0, std::sin(2.0 * M_PI * 2.2 * t)) * (std::fmod(t, 2.0) < 1.6 ? 1.0 : 0.02);
+        const double voiced = std::tanh(3.0 * std::sin(phase));
+        const float breath = 0.01f * noise(rng);
+        input[0][i] = (float)(0.7 * syllable * voiced) + breath;
+        input[1][i] = (float)(0.6 * syllable * voiced) + breath;
+    }
+    return input;
+}
+
+struct Run {
+    double seconds = 1e30;      // best of kRepetitions
+    std::vector<std::vector<float>> output;
+};
+
+Run render(Precision precision, double sampleRate, const std::vector<std::vector<float>>& input) {
+    Run run;
+    run.output.assign(kChannels, std::vector<float>(input[0].size()));
+    for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+        VX1ExtensionDSPKernel kernel;
+        kernel.setParameter(VX1ExtensionParameterAddress::compress, 70.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::speed, 40.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::stack, 50.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::gateThreshold, -60.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::bite, 0.0f);
+        kernel.setMaximumFramesToRender(kBlockFrames);
+        kernel.initialize(kChannels, kChannels, sampleRate);
+        kernel.setDetectorPrecision(precision);
+
+        std::vector<const float*> in(kChannels);
+        std::vector<float*> out(kChannels);
+        const size_t frames = input[0].size();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+            const AUAudioFrameCount blockFrames = (AUAudioFrameCount)std::min<size_t>(kBlockFrames, frames - offset);
+            for (int c = 0; c < kChannels; ++c) {
+                in[c] = input[c].data() + offset;
+                out[c] = run.output[c].data() + offset;
+            }
+            kernel.process(in, out, (AUEventSampleTime)offset, blockFrames);
+        }
+        run.seconds = std::min(run.seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return run;
+}
+
+double toDb(double value) {
+    return value > 0.0 ? 20.0 * std::log10(value) : -INFINITY;
+}
+
+}
+
+int main() {
+    std::printf("VX1 detector precision: stereo, %d-frame blocks, %.0f s per rate, best of %d\n",
+                kBlockFrames, kSeconds, kRepetitions);
+    std::printf("noise floor = difference from the double render (dBFS)\n");
+    std::printf("%-9s %-24s %10s %10s %12s %12s\n", "rate", "precision", "ns/smp", "vs single",
+                "rms diff", "peak diff");
+
+    for (double sampleRate : kSampleRates) {
+        const std::vector<std::vector<float>> input = makeInput(sampleRate);
+        std::vector<Run> runs;
+        for (const Combination& combination : kCombinations) {
+            runs.push_back(render(combination.precision, sampleRate, input));
+        }
+        const Run& reference = runs.back();
+
+        const double samples = (double)kChannels * (double)input[0].size();
+        for (size_t r = 0; r < runs.size(); ++r) {
+            double sumSquares = 0.0, peak = 0.0;
+            for (int c = 0; c < kChannels; ++c) {
+                for (size_t i = 0; i < input[c].size(); ++i) {
+                    const double difference = (double)runs[r].output[c][i] - (double)reference.output[c][i];
+                    sumSquares += difference * difference;
+                    peak = std::max(peak, std::abs(difference));
+                }
+            }
+            std::printf("%-9.0f %-24s %10.2f %9.2fx %12.1f %12.1f\n", sampleRate, kCombinations[r].name,
+                        runs[r].seconds * 1e9 / samples, runs[r].seconds / runs[0].seconds,
+                        toDb(std::sqrt(sumSquares / samples)), toDb(peak));
+        }
+    }
+    return 0;
+}
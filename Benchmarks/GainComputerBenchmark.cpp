@@ -0,0 +1,153 @@
+//
+//  GainComputerBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  Cycles/sample of the per-sample gain computer path (both passes, Stack on),
+//  comparing the original inline std::pow/std::log10 code ("before") with
+//  VX1GainComputer at each precision ("after"), at 44.1, 48 and 96 kHz.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#define VX1_HAS_TSC 1
+#endif
+
+#include "VX1ExtensionGainComputer.hpp"
+
+using vx1::fastmath::Precision;
+
+namespace {
+
+// Volatile so the "before" variant cannot constant-fold its per-sample std::pow calls.
+volatile float kThresholdDb = -30.0f;
+volatile float kRatio = 8.0f;
+volatile float kStackPercent = 50.0f;
+volatile float kGateThresholdDb = -60.0f;
+constexpr int kRepeats = 20;
+
+/// One second of detector envelope at the given rate: syllable-like bursts through a 10 ms follower.
+std::vector<float> makeEnvelope(double sampleRate) {
+    const int frames = (int)sampleRate;
+    std::vector<float> envelope(frames);
+    const float coeff = std::exp(-1.0f / (0.010f * (float)sampleRate));
+    float level = 0.0f;
+    for (int i = 0; i < frames; ++i) {
+        const float t = (float)i / (float)sampleRate;
+        const float burst = 0.5f + 0.5f * std::sin(2.0f * (float)M_PI * 4.0f * t);
+        const float x = std::abs(burst * burst * std::sin(2.0f * (float)M_PI * 180.0f * t));
+        level = coeff * level + (1.0f - coeff) * x;
+        envelope[i] = level;
+    }
+    return envelope;
+}
+
+/// The gain computer as it was written inline in process(): every value recomputed per sample.
+float runBefore(const std::vector<float>& envelope) {
+    const float thresholdDb = kThresholdDb, ratio = kRatio, stackPercent = kStackPercent;
+    const float gateThresholdDb = kGateThresholdDb;
+    float sink = 0.0f;
+    for (float env : envelope) {
+        float gateThresholdLinear = std::pow(10.0f, gateThresholdDb / 20.0f);
+        sink += (env >= gateThresholdLinear) ? 1e-9f : 0.0f;
+
+        float gainReductionDb = 0.0f;
+        float gainReduction = 1.0f;
+        float overThresholdDb = 20.0f * std::log10(std::max(env, 1e-6f)) - thresholdDb;
+        if (overThresholdDb > 0.0f) {
+            gainReductionDb = overThresholdDb * (1.0f - 1.0f / ratio);
+            gainReduction = std::pow(10.0f, -gainReductionDb / 20.0f);
+        }
+        float gainReductionTotal = std::pow(10.0f, -gainReductionDb / 20.0f);
+
+        float stackBlend = stackPercent / 100.0f;
+        float thresholdDb2 = thresholdDb + (thresholdDb * stackBlend * 0.5f);
+        float gainReductionDb2 = 0.0f;
+        float overThresholdDb2 = 20.0f * std::log10(std::max(env * gainReductionTotal, 1e-6f)) - thresholdDb2;
+        if (overThresholdDb2 > 0.0f) {
+            gainReductionDb2 = overThresholdDb2 * (1.0f - 1.0f / ratio);
+        }
+        float gainReductionTotal2 = std::pow(10.0f, -gainReductionDb2 / 20.0f);
+
+        float extraThresholdDb = thresholdDb * stackBlend * 0.5f;
+        float stackMakeupGain = std::pow(10.0f, -extraThresholdDb * (1.0f - 1.0f / ratio) / 20.0f);
+
+        sink += gainReduction * 1e-9f + gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+    }
+    return sink;
+}
+
+template <Precision P>
+float runAfter(const std::vector<float>& envelope) {
+    VX1GainComputer<P> gainComputer;
+    gainComputer.setCompression(kThresholdDb, kRatio);
+    gainComputer.setStack(kStackPercent);
+    gainComputer.setGateThreshold(kGateThresholdDb);
+
+    float sink = 0.0f;
+    for (float env : envelope) {
+        sink += (env >= gainComputer.gateThresholdLinear()) ? 1e-9f : 0.0f;
+        float gainReductionTotal = VX1GainComputer<P>::gain(gainComputer.gainReductionDb(env));
+        float gainReductionTotal2 = VX1GainComputer<P>::gain(gainComputer.gainReductionDb2(env * gainReductionTotal));
+        sink += gainReductionTotal * gainReductionTotal2 * gainComputer.stackMakeupGain();
+    }
+    return sink;
+}
+
+struct Measurement {
+    double cyclesPerSample;
+    double nsPerSample;
+};
+
+template <typename Fn>
+Measurement measure(const std::vector<float>& envelope, Fn&& fn) {
+    volatile float sink = fn(envelope);  // warm-up
+    const auto start = std::chrono::steady_clock::now();
+#ifdef VX1_HAS_TSC
+    const unsigned long long startCycles = __rdtsc();
+#endif
+    for (int r = 0; r < kRepeats; ++r) {
+        sink = sink + fn(envelope);
+    }
+#ifdef VX1_HAS_TSC
+    const double cycles = (double)(__rdtsc() - startCycles);
+#else
+    const double cycles = 0.0;
+#endif
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const double samples = (double)envelope.size() * kRepeats;
+    return { cycles / samples, ns / samples };
+}
+
+}
+
+int main() {
+#ifdef VX1_HAS_TSC
+    std::printf("Gain computer, both passes + Stack makeup (cycles = TSC reference cycles)\n");
+#else
+    std::printf("Gain computer, both passes + Stack makeup (no TSC on this target; cycles column is 0)\n");
+#endif
+    std::printf("%-8s %-14s %14s %12s\n", "rate", "variant", "cycles/sample", "ns/sample");
+
+    for (double sampleRate : { 44100.0, 48000.0, 96000.0 }) {
+        const std::vector<float> envelope = makeEnvelope(sampleRate);
+        const struct {
+            const char* name;
+            Measurement result;
+        } rows[] = {
+            { "before",       measure(envelope, runBefore) },
+            { "after/exact",  measure(envelope, runAfter<Precision::exact>) },
+            { "after/high",   measure(envelope, runAfter<Precision::high>) },
+            { "after/fast",   measure(envelope, runAfter<Precision::fast>) },
+        };
+        for (const auto& row : rows) {
+            std::printf("%-8.1f %-14s %14.2f %12.2f\n", sampleRate / 1000.0, row.name,
+                        row.result.cyclesPerSample, row.result.nsPerSample);
+        }
+    }
+    return 0;
+}
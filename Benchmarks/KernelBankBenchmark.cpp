@@ -0,0 +1,135 @@
+//
+//  KernelBankBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  Render cost of 1…64 stereo VX1 instances as separate kernels and as one
+//  VX1KernelBank, per instance and in total, with the largest difference between
+//  the two renders (exits non-zero past the block engine tolerance).
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "VX1ExtensionKernelBank.hpp"
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 512;
+constexpr int kBlocks = 94;             // ~1 s of audio per instance
+constexpr int kRepetitions = 3;         // best of
+constexpr int kInstanceCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+/// Mic-like input per instance: a pitched pulse with a syllable envelope and some noise,
+/// each at its own pitch, rate and level so the detectors do not move in step.
+std::vector<float> makeInput(int instance, int channel) {
+    std::mt19937 rng(11 + instance * 31 + channel);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const float pitch = 90.0f + 23.0f * (float)(instance % 11);
+    const float syllableHz = 2.5f + 0.35f * (float)(instance % 7);
+    const float level = std::pow(10.0f, -(float)(instance % 5) * 3.0f / 20.0f) * (channel == 0 ? 1.0f : 0.8f);
+    std::vector<float> signal((size_t)kBlocks * kBlockFrames);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        const float t = (float)i / (float)kSampleRate;
+        const float syllable = std::max(0.0f, std::sin(2.0f * (float)M_PI * syllableHz * t));
+        const float voiced = std::tanh(4.0f * std::sin(2.0f * (float)M_PI * pitch * t));
+        signal[i] = level * syllable * (0.5f * voiced + 0.05f * noise(rng));
+    }
+    return signal;
+}
+
+/// Every instance set up differently: compress, speed, grip, Stack and the gate vary.
+void configure(VX1KernelBank& bank) {
+    for (int instance = 0; instance < bank.instanceCount(); ++instance) {
+        VX1ExtensionDSPKernel& kernel = bank.kernel(instance);
+        kernel.setParameterRamped(VX1ExtensionParameterAddress::compress, 30.0f + (float)(instance * 7 % 60), 0);
+        kernel.setParameterRamped(VX1ExtensionParameterAddress::speed, 2.0f + (float)(instance * 5 % 40), 0);
+        kernel.setParameterRamped(VX1ExtensionParameterAddress::grip, (float)(instance * 13 % 100), 0);
+        kernel.setParameterRamped(VX1ExtensionParameterAddress::stack, instance % 3 == 0 ? 50.0f : 0.0f, 0);
+        kernel.setParameterRamped(VX1ExtensionParameterAddress::gateThreshold, instance % 4 == 0 ? -50.0f : -80.0f, 0);
+    }
+}
+
+struct Run {
+    double seconds = 0.0;       // best of kRepetitions
+    int bankedInstances = 0;    // of the last block
+    std::vector<std::vector<float>> output;   // [instance · kChannels + channel]
+};
+
+Run render(int instanceCount, bool banking, const std::vector<std::vector<float>>& input) {
+    Run run;
+    run.seconds = 1e30;
+    run.output.assign(input.size(), std::vector<float>(input[0].size()));
+    for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+        VX1KernelBank bank;
+        bank.initialize(instanceCount, kChannels, kSampleRate, kBlockFrames);
+        bank.setBanking(banking);
+        configure(bank);
+
+        std::vector<const float*> inputPointers(input.size());
+        std::vector<float*> outputPointers(input.size());
+        std::vector<VX1KernelBank::InstanceBuffers> buffers(instanceCount);
+        for (int instance = 0; instance < instanceCount; ++instance) {
+            buffers[instance] = { std::span(inputPointers.data() + instance * kChannels, kChannels),
+                                  std::span(outputPointers.data() + instance * kChannels, kChannels) };
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int block = 0; block < kBlocks; ++block) {
+            const size_t offset = (size_t)block * kBlockFrames;
+            for (size_t c = 0; c < input.size(); ++c) {
+                inputPointers[c] = input[c].data() + offset;
+                outputPointers[c] = run.output[c].data() + offset;
+            }
+            bank.process(buffers, (AUEventSampleTime)offset, kBlockFrames);
+        }
+        run.seconds = std::min(run.seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        run.bankedInstances = bank.bankedInstanceCount();
+    }
+    return run;
+}
+
+}
+
+int main() {
+    std::printf("VX1KernelBank: stereo instances, %d-frame blocks @ %.0f Hz, %d lanes per step, best of %d\n",
+                kBlockFrames, kSampleRate, VX1KernelBank::kLanes, kRepetitions);
+    std::printf("%-10s %8s %16s %16s %10s %14s\n", "instances", "banked", "separate ns/smp", "banked ns/smp",
+                "speedup", "max |diff|");
+
+    float worstDifference = 0.0f;
+    for (int instanceCount : kInstanceCounts) {
+        std::vector<std::vector<float>> input;
+        for (int instance = 0; instance < instanceCount; ++instance) {
+            for (int channel = 0; channel < kChannels; ++channel) input.push_back(makeInput(instance, channel));
+        }
+
+        const Run separate = render(instanceCount, false, input);
+        const Run banked = render(instanceCount, true, input);
+
+        float difference = 0.0f;
+        for (size_t c = 0; c < input.size(); ++c) {
+            for (size_t i = 0; i < input[c].size(); ++i) {
+                difference = std::max(difference, std::abs(separate.output[c][i] - banked.output[c][i]));
+            }
+        }
+        worstDifference = std::max(worstDifference, difference);
+
+        // Nanoseconds per sample of one channel of one instance
+        const double samples = (double)instanceCount * kChannels * kBlocks * kBlockFrames;
+        std::printf("%-10d %8d %16.2f %16.2f %9.2fx %14.3g\n", instanceCount, banked.bankedInstances,
+                    separate.seconds * 1e9 / samples, banked.seconds * 1e9 / samples,
+                    separate.seconds / banked.seconds, difference);
+    }
+
+    if (worstDifference > VX1ExtensionDSPKernel::kBlockEngineTolerance) {
+        std::printf("FAIL: banked output differs from separate kernels by %g\n", worstDifference);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+//
+//  OversamplingBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  Cycles/sample of the full kernel (block engine, stereo, 512-frame blocks) with
+//  Bite oversampling off, 2x, 4x and 8x, and the oversampling overhead on top of
+//  1x. Exits non-zero if 4x on stereo exceeds kBudgetCyclesPerSample.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#define VX1_HAS_TSC 1
+#endif
+
+#include "VX1ExtensionDSPKernel.hpp"
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 512;
+constexpr int kRepeats = 10;
+
+/// Budget for the whole kernel at 4x, per channel-sample, in TSC reference cycles.
+constexpr double kBudgetCyclesPerSample = 200.0;
+
+struct Measurement {
+    double cyclesPerSample;
+    double nsPerSample;
+};
+
+/// One second of a bright vocal-like test signal: a 180 Hz pulse train with noise bursts.
+std::vector<std::vector<float>> makeInput(double sampleRate) {
+    const int frames = (int)sampleRate;
+    std::vector<std::vector<float>> input(kChannels, std::vector<float>(frames));
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (int i = 0; i < frames; ++i) {
+        const float t = (float)i / (float)sampleRate;
+        const float syllable = 0.5f + 0.5f * std::sin(2.0f * (float)M_PI * 4.0f * t);
+        const float voiced = std::tanh(4.0f * std::sin(2.0f * (float)M_PI * 180.0f * t));
+        const float x = syllable * (0.5f * voiced + 0.05f * noise(rng));
+        input[0][i] = x;
+        input[1][i] = 0.8f * x;
+    }
+    return input;
+}
+
+Measurement measure(const std::vector<std::vector<float>>& input, double sampleRate, int oversamplingIndex) {
+    VX1ExtensionDSPKernel kernel;
+    kernel.setMaximumFramesToRender(kBlockFrames);
+    kernel.setParameter(VX1ExtensionParameterAddress::compress, 50.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::bite, 75.0f);
+    kernel.setParameter(VX1ExtensionParameterAddress::oversampling, (float)oversamplingIndex);
+    kernel.initialize(kChannels, kChannels, sampleRate);
+
+    const int frames = (int)input[0].size();
+    std::vector<std::vector<float>> output(kChannels, std::vector<float>(frames));
+
+    auto runOnce = [&] {
+        for (int offset = 0; offset < frames; offset += kBlockFrames) {
+            const int blockFrames = std::min(kBlockFrames, frames - offset);
+            const float* in[kChannels];
+            float* out[kChannels];
+            for (int channel = 0; channel < kChannels; ++channel) {
+                in[channel] = input[channel].data() + offset;
+                out[channel] = output[channel].data() + offset;
+            }
+            kernel.process(std::span<const float*>(in, kChannels), std::span<float*>(out, kChannels),
+                           offset, (AUAudioFrameCount)blockFrames);
+        }
+    };
+
+    runOnce();  // warm-up
+    const auto start = std::chrono::steady_clock::now();
+#ifdef VX1_HAS_TSC
+    const unsigned long long startCycles = __rdtsc();
+#endif
+    for (int r = 0; r < kRepeats; ++r) {
+        runOnce();
+    }
+#ifdef VX1_HAS_TSC
+    const double cycles = (double)(__rdtsc() - startCycles);
+#else
+    const double cycles = 0.0;
+#endif
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const double samples = (double)frames * kChannels * kRepeats;
+    return { cycles / samples, ns / samples };
+}
+
+}
+
+int main() {
+#ifdef VX1_HAS_TSC
+    std::printf("Kernel with Bite oversampling, stereo, %d-frame blocks (cycles = TSC reference cycles)\n", kBlockFrames);
+#else
+    std::printf("Kernel with Bite oversampling, stereo, %d-frame blocks (no TSC on this target; cycles column is 0)\n", kBlockFrames);
+#endif
+    std::printf("%-8s %-6s %8s %14s %12s %16s\n", "rate", "factor", "latency", "cycles/sample", "ns/sample", "overhead cycles");
+
+    bool withinBudget = true;
+    for (double sampleRate : { 44100.0, 48000.0 }) {
+        const auto input = makeInput(sampleRate);
+        Measurement baseline {};
+        for (int index = 0; index <= 3; ++index) {
+            const int factor = 1 << index;
+            const Measurement result = measure(input, sampleRate, index);
+            if (index == 0) baseline = result;
+            std::printf("%-8.1f %-6d %8d %14.2f %12.2f %16.2f\n", sampleRate / 1000.0, factor,
+                        VX1Oversampler::latencySamples(factor), result.cyclesPerSample, result.nsPerSample,
+                        result.cyclesPerSample - baseline.cyclesPerSample);
+#ifdef VX1_HAS_TSC
+            if (factor == 4 && result.cyclesPerSample > kBudgetCyclesPerSample) {
+                withinBudget = false;
+            }
+#endif
+        }
+    }
+
+#ifdef VX1_HAS_TSC
+    std::printf("4x stereo budget: %.0f cycles/sample — %s\n", kBudgetCyclesPerSample, withinBudget ? "OK" : "EXCEEDED");
+#endif
+    return withinBudget ? 0 : 1;
+}
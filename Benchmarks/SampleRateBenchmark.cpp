@@ -0,0 +1,145 @@
+//
+//  SampleRateBenchmark.cpp
+//  VX1 Benchmarks
+//
+//  The kernel from 44.1 to 768 kHz. For every rate: the sidechain HPF's response
+//  at 80 Hz and the presence shelf's at 3.5 kHz from the coefficients initialize()
+//  computed (exits non-zero if either is off its design by more than 0.05 dB), then
+//  the render cost per second of audio with the full-rate and the reduced-rate
+//  linked detector, and the difference between the two renders.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+
+namespace {
+
+using Rate = VX1ExtensionDSPKernel::SidechainRate;
+
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 512;
+constexpr double kSeconds = 2.0;
+constexpr int kRepetitions = 3;         // best of
+constexpr double kSampleRates[] = { 44100.0, 48000.0, 96000.0, 176400.0, 192000.0, 352800.0, 384000.0, 768000.0 };
+constexpr double kTolerance = 0.05;     // dB
+
+// The designs: 80 Hz Butterworth high-pass (-3.01 dB at the corner), and a +5 dB
+// first-order shelf whose bilinear corner gain is sqrt((G² + 1) / 2)
+const double kHpfCornerDb = -10.0 * std::log10(2.0);
+const double kShelfCornerDb = 10.0 * std::log10((std::pow(10.0, 10.0 / 20.0) + 1.0) / 2.0);
+
+double responseDb(std::complex<double> numerator, std::complex<double> denominator) {
+    return 20.0 * std::log10(std::abs(numerator / denominator));
+}
+
+/// Mic-like input: a pitched pulse with vibrato and a syllable envelope, plus breath noise.
+std::vector<std::vector<float>> makeInput(double sampleRate) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const size_t frames = (size_t)(kSeconds * sampleRate);
+    std::vector<std::vector<float>> input(kChannels, std::vector<float>(frames));
+    double phase = 0.0;
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = (double)i / sampleRate;
+        phase += 2.0 * M_PI * 160.0 * (1.0 + 0.01 * std::sin(2.0 * M_PI * 5.0 * t)) / sampleRate;
+        const double syllable = std::max(0.0, std::sin(2.0 * M_PI * 2.5 * t));
+        const double voiced = std::tanh(3.0 * std::sin(phase));
+        const float breath = 0.02f * noise(rng);
+        for (int c = 0; c < kChannels; ++c) {
+            input[c][i] = (float)((c == 0 ? 0.7 : 0.55) * syllable * voiced) + breath;
+        }
+    }
+    return input;
+}
+
+struct Run {
+    double seconds = 1e30;      // best of kRepetitions
+    std::vector<std::vector<float>> output;
+};
+
+Run render(Rate rate, double sampleRate, const std::vector<std::vector<float>>& input) {
+    Run run;
+    run.output.assign(kChannels, std::vector<float>(input[0].size()));
+    for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+        VX1ExtensionDSPKernel kernel;
+        kernel.setParameter(VX1ExtensionParameterAddress::compress, 60.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::speed, 10.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::grip, 30.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::stack, 40.0f);
+        kernel.setParameter(VX1ExtensionParameterAddress::sidechainRate, (float)(int)rate);
+        kernel.setMaximumFramesToRender(kBlockFrames);
+        kernel.initialize(kChannels, kChannels, sampleRate);
+
+        std::vector<const float*> in(kChannels);
+        std::vector<float*> out(kChannels);
+        const size_t frames = input[0].size();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+            const AUAudioFrameCount blockFrames = (AUAudioFrameCount)std::min<size_t>(kBlockFrames, frames - offset);
+            for (int c = 0; c < kChannels; ++c) {
+                in[c] = input[c].data() + offset;
+                out[c] = run.output[c].data() + offset;
+            }
+            kernel.process(in, out, (AUEventSampleTime)offset, blockFrames);
+        }
+        run.seconds = std::min(run.seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return run;
+}
+
+}
+
+int main() {
+    std::printf("VX1 sample rates: stereo, %d-frame blocks, %.0f s per rate, best of %d\n",
+                kBlockFrames, kSeconds, kRepetitions);
+    std::printf("design: HPF %.2f dB at 80 Hz, presence shelf %+.2f dB at 3.5 kHz\n", kHpfCornerDb, kShelfCornerDb);
+    std::printf("%-9s %9s %9s %7s %14s %14s %9s %12s\n", "rate", "HPF@80", "shelf@3.5k", "factor",
+                "full ms/s", "reduced ms/s", "speedup", "rms diff dB");
+
+    bool withinDesign = true;
+    for (double sampleRate : kSampleRates) {
+        VX1ExtensionDSPKernel kernel;
+        kernel.initialize(kChannels, kChannels, sampleRate);
+
+        // Responses of the float coefficients the engines actually run
+        const VX1DetectorState& hpf = kernel.mDetector;
+        const std::complex<double> z80 = std::polar(1.0, -2.0 * M_PI * 80.0 / sampleRate);
+        const double hpfDb = responseDb((double)hpf.hpfA0 + (double)hpf.hpfA1 * z80 + (double)hpf.hpfA2 * z80 * z80,
+                                        1.0 + (double)hpf.hpfB1 * z80 + (double)hpf.hpfB2 * z80 * z80);
+        const std::complex<double> z3k5 = std::polar(1.0, -2.0 * M_PI * 3500.0 / sampleRate);
+        const double shelfDb = responseDb((double)kernel.mShelfB0Pre + (double)kernel.mShelfB1Pre * z3k5,
+                                          1.0 + (double)kernel.mShelfA1Pre * z3k5);
+        withinDesign = withinDesign && std::abs(hpfDb - kHpfCornerDb) <= kTolerance
+                    && std::abs(shelfDb - kShelfCornerDb) <= kTolerance;
+
+        const std::vector<std::vector<float>> input = makeInput(sampleRate);
+        const Run full = render(Rate::full, sampleRate, input);
+        const Run reduced = render(Rate::reduced, sampleRate, input);
+
+        double sumSquares = 0.0;
+        for (int c = 0; c < kChannels; ++c) {
+            for (size_t i = 0; i < input[c].size(); ++i) {
+                const double difference = (double)full.output[c][i] - (double)reduced.output[c][i];
+                sumSquares += difference * difference;
+            }
+        }
+        const double rmsDifference = std::sqrt(sumSquares / ((double)kChannels * (double)input[0].size()));
+
+        std::printf("%-9.0f %9.3f %9.3f %7d %14.1f %14.1f %8.2fx %12.1f\n", sampleRate, hpfDb, shelfDb,
+                    kernel.mSidechainDecimation, full.seconds * 1e3 / kSeconds, reduced.seconds * 1e3 / kSeconds,
+                    full.seconds / reduced.seconds, rmsDifference > 0.0 ? 20.0 * std::log10(rmsDifference) : -INFINITY);
+    }
+
+    if (!withinDesign) {
+        std::printf("FAIL: a filter is more than %.2f dB off its design\n", kTolerance);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+//  vx1_kernel_bank.cpp
+//  VX1 Tests
+//
+//  Keeps VX1KernelBank's lane recursion (processGroup) on the kernel's own linked
+//  detector: renders the same instances with banking on and off and fails if any
+//  output sample differs by more than kBlockEngineTolerance. The instances mix Stack
+//  on and off, open and closing gates, abrupt onsets that fire the VCA overshoot and
+//  a spread of Grip and Speed settings. One lane group runs without Stack, a leftover
+//  pair renders alone, parameter ramps move instances out of the lanes and back, and
+//  there is a silent stretch. Also fails if the banked render never banked.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "VX1ExtensionKernelBank.hpp"
+
+namespace {
+
+using Address = VX1ExtensionParameterAddress;
+
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 256;
+constexpr int kBlocks = 200;                  // ~1 s at 48 kHz
+constexpr int kInstances = 10;                // two lane groups and a leftover pair
+constexpr int kSilentBlocks[] = { 120, 150 }; // [first, last): every instance silent
+constexpr int kRampBlocks[] = { 40, 90 };     // one instance per block set off on a ramp
+
+/// Mic-like input per instance: a pitched pulse with a syllable envelope, some noise and
+/// quiet gaps, each at its own pitch, rate and level so the detectors do not move in step.
+std::vector<float> makeInput(int instance, int channel, double sampleRate) {
+    std::mt19937 rng(5 + instance * 17 + channel);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const double pitch = 110.0 + 29.0 * (double)instance;
+    const double syllableHz = 2.0 + 0.45 * (double)instance;
+    const double level = std::pow(10.0, -(double)(instance % 4) * 6.0 / 20.0) * (channel == 0 ? 1.0 : 0.7);
+    std::vector<float> signal((size_t)kBlocks * kBlockFrames);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        const int block = (int)(i / kBlockFrames);
+        if (block >= kSilentBlocks[0] && block < kSilentBlocks[1]) continue;
+        const double t = (double)i / sampleRate;
+        // Every third instance starts its syllables abruptly, so its VCA overshoot fires
+        const double phase = std::sin(2.0 * M_PI * syllableHz * t);
+        const double syllable = instance % 3 == 0 ? (phase > 0.0 ? 1.0 : 0.0) : std::max(0.0, phase);
+        const double voiced = std::tanh(4.0 * std::sin(2.0 * M_PI * pitch * t));
+        signal[i] = (float)(level * syllable * (0.6 * voiced + 0.03 * (double)noise(rng)));
+    }
+    return signal;
+}
+
+/// Lanes 0–3 mix Stack and gates, lanes 4–7 have no Stack (the group compiles it out),
+/// 8–9 are the leftover pair.
+void configure(VX1KernelBank& bank) {
+    for (int instance = 0; instance < bank.instanceCount(); ++instance) {
+        VX1ExtensionDSPKernel& kernel = bank.kernel(instance);
+        const bool stack = instance < 4 ? instance % 2 == 0 : instance >= 8;
+        kernel.setParameterRamped(Address::compress, 20.0f + (float)(instance * 9 % 75), 0);
+        kernel.setParameterRamped(Address::speed, instance % 3 == 0 ? 1.0f : 10.0f + (float)(instance * 11 % 80), 0);
+        kernel.setParameterRamped(Address::grip, instance % 3 == 0 ? 100.0f : (float)(instance * 23 % 101), 0);
+        kernel.setParameterRamped(Address::stack, stack ? 35.0f + 10.0f * (float)(instance % 3) : 0.0f, 0);
+        kernel.setParameterRamped(Address::gateThreshold, instance % 2 == 1 ? -30.0f : -80.0f, 0);
+    }
+}
+
+struct Run {
+    std::vector<std::vector<float>> output;   // [instance · kChannels + channel]
+    int bankedBlocks = 0;                     // blocks that ran at least one lane group
+};
+
+Run render(bool banking, double sampleRate, const std::vector<std::vector<float>>& input) {
+    VX1KernelBank bank;
+    bank.initialize(kInstances, kChannels, sampleRate, kBlockFrames);
+    bank.setBanking(banking);
+    configure(bank);
+
+    Run run;
+    run.output.assign(input.size(), std::vector<float>(input[0].size()));
+    std::vector<const float*> inputPointers(input.size());
+    std::vector<float*> outputPointers(input.size());
+    std::vector<VX1KernelBank::InstanceBuffers> buffers(kInstances);
+    for (int instance = 0; instance < kInstances; ++instance) {
+        buffers[instance] = { std::span(inputPointers.data() + instance * kChannels, kChannels),
+                              std::span(outputPointers.data() + instance * kChannels, kChannels) };
+    }
+
+    for (int block = 0; block < kBlocks; ++block) {
+        // A smoothed compress or speed change takes the instance out of the lanes until it lands
+        if (block >= kRampBlocks[0] && block < kRampBlocks[1] && block % 5 == 0) {
+            const int instance = block / 5 % kInstances;
+            const Address address = block % 10 == 0 ? Address::compress : Address::speed;
+            bank.kernel(instance).setParameter(address, 15.0f + (float)(block % 60));
+        }
+        const size_t offset = (size_t)block * kBlockFrames;
+        for (size_t c = 0; c < input.size(); ++c) {
+            inputPointers[c] = input[c].data() + offset;
+            outputPointers[c] = run.output[c].data() + offset;
+        }
+        bank.process(buffers, (AUEventSampleTime)offset, kBlockFrames);
+        if (bank.bankedInstanceCount() > 0) ++run.bankedBlocks;
+    }
+    return run;
+}
+
+}
+
+int main() {
+    std::printf("VX1KernelBank vs separate kernels: %d stereo instances, %d-frame blocks\n", kInstances, kBlockFrames);
+
+    int failures = 0;
+    for (double sampleRate : { 48000.0, 96000.0 }) {
+        std::vector<std::vector<float>> input;
+        for (int instance = 0; instance < kInstances; ++instance) {
+            for (int channel = 0; channel < kChannels; ++channel) input.push_back(makeInput(instance, channel, sampleRate));
+        }
+        const Run separate = render(false, sampleRate, input);
+        const Run banked = render(true, sampleRate, input);
+
+        float difference = 0.0f;
+        for (size_t c = 0; c < input.size(); ++c) {
+            for (size_t i = 0; i < input[c].size(); ++i) {
+                difference = std::max(difference, std::abs(separate.output[c][i] - banked.output[c][i]));
+            }
+        }
+        const bool passed = difference <= VX1ExtensionDSPKernel::kBlockEngineTolerance && banked.bankedBlocks > 0;
+        std::printf("%-9.0f banked blocks %3d of %d, max |diff| %-10.3g %s\n", sampleRate, banked.bankedBlocks,
+                    kBlocks, difference, passed ? "ok" : "FAIL");
+        if (!passed) ++failures;
+    }
+
+    if (failures > 0) {
+        std::printf("%d rate(s) failed (tolerance %g)\n", failures, VX1ExtensionDSPKernel::kBlockEngineTolerance);
+        return 1;
+    }
+    return 0;
+}
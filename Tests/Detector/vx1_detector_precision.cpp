@@ -0,0 +1,121 @@
+//
+//  vx1_detector_precision.cpp
+//  VX1 Tests
+//
+//  The double-precision linked detector and its handoff with the float one. A vocal
+//  phrase with silent gaps (the silent-block path puts mDetector at rest), parameter
+//  ramps and release tails (flushDecayingState() writes mDetector after each block)
+//  is rendered three ways: all single, all double, and switching precision every few
+//  blocks. Every render has to stay within kMaxDifference of the all-double one. A
+//  double detector that lost a sync with mDetector would carry on from stale state
+//  and miss by whole dB of gain. Exits 1 if a check fails.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+
+namespace {
+
+using Precision = VX1ExtensionDSPKernel::DetectorPrecision;
+using Address = VX1ExtensionParameterAddress;
+
+constexpr int kChannels = 2;
+constexpr int kBlockFrames = 512;
+constexpr double kSeconds = 6.0;
+constexpr int kSwitchBlocks = 7;          // switching render: blocks per precision
+constexpr float kMaxDifference = 1e-3f;   // -60 dBFS; single's own floor is far lower
+
+enum class Schedule { single, double_, switching };
+
+/// Syllables at two phrase levels with silent gaps long enough for the silent-block path.
+std::vector<std::vector<float>> makeInput(double sampleRate) {
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const size_t frames = (size_t)(kSeconds * sampleRate);
+    std::vector<std::vector<float>> input(kChannels, std::vector<float>(frames));
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = (double)i / sampleRate;
+        if (std::fmod(t, 2.0) >= 1.4) continue;
+        const double syllable = std::max(0.0, std::sin(2.0 * M_PI * 3.0 * t)) * (std::fmod(t, 4.0) < 2.0 ? 1.0 : 0.3);
+        const double voiced = std::tanh(3.0 * std::sin(2.0 * M_PI * 170.0 * t));
+        for (int c = 0; c < kChannels; ++c) {
+            input[c][i] = (float)((c == 0 ? 0.7 : 0.5) * syllable * voiced) + 0.005f * noise(rng);
+        }
+    }
+    return input;
+}
+
+std::vector<std::vector<float>> render(Schedule schedule, double sampleRate, const std::vector<std::vector<float>>& input) {
+    VX1ExtensionDSPKernel kernel;
+    kernel.setParameter(Address::compress, 70.0f);
+    kernel.setParameter(Address::speed, 40.0f);
+    kernel.setParameter(Address::stack, 50.0f);
+    kernel.setParameter(Address::gateThreshold, -50.0f);
+    kernel.setMaximumFramesToRender(kBlockFrames);
+    kernel.initialize(kChannels, kChannels, sampleRate);
+    kernel.setDetectorPrecision(schedule == Schedule::single ? Precision::single : Precision::double_);
+
+    const size_t frames = input[0].size();
+    std::vector<std::vector<float>> output(kChannels, std::vector<float>(frames));
+    std::vector<const float*> in(kChannels);
+    std::vector<float*> out(kChannels);
+    int block = 0;
+    for (size_t offset = 0; offset < frames; offset += kBlockFrames, ++block) {
+        if (schedule == Schedule::switching) {
+            kernel.setDetectorPrecision(block / kSwitchBlocks % 2 == 0 ? Precision::double_ : Precision::single);
+        }
+        // Compress and speed ramps partway through each phrase
+        if (block % 150 == 40) {
+            kernel.setParameter(Address::compress, block % 300 == 40 ? 55.0f : 70.0f);
+            kernel.setParameter(Address::speed, block % 300 == 40 ? 10.0f : 40.0f);
+        }
+        const AUAudioFrameCount blockFrames = (AUAudioFrameCount)std::min<size_t>(kBlockFrames, frames - offset);
+        for (int c = 0; c < kChannels; ++c) {
+            in[c] = input[c].data() + offset;
+            out[c] = output[c].data() + offset;
+        }
+        kernel.process(in, out, (AUEventSampleTime)offset, blockFrames);
+    }
+    return output;
+}
+
+float maxDifference(const std::vector<std::vector<float>>& a, const std::vector<std::vector<float>>& b) {
+    float difference = 0.0f;
+    for (size_t c = 0; c < a.size(); ++c) {
+        for (size_t i = 0; i < a[c].size(); ++i) {
+            difference = std::max(difference, std::abs(a[c][i] - b[c][i]));
+        }
+    }
+    return difference;
+}
+
+}
+
+int main() {
+    std::printf("VX1 detector precision: single and switching renders vs all double (max |diff| %g)\n",
+                kMaxDifference);
+
+    int failures = 0;
+    for (double sampleRate : { 48000.0, 192000.0 }) {
+        const std::vector<std::vector<float>> input = makeInput(sampleRate);
+        const std::vector<std::vector<float>> reference = render(Schedule::double_, sampleRate, input);
+        const float single = maxDifference(render(Schedule::single, sampleRate, input), reference);
+        const float switching = maxDifference(render(Schedule::switching, sampleRate, input), reference);
+        const bool passed = single <= kMaxDifference && switching <= kMaxDifference;
+        std::printf("%-9.0f single %-10.3g switching %-10.3g %s\n", sampleRate, single, switching,
+                    passed ? "ok" : "FAIL");
+        if (!passed) ++failures;
+    }
+
+    if (failures > 0) {
+        std::printf("%d rate(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+//
+//  VX1GoldenCompare.cpp
+//  VX1 Tests
+//
+//  Output-vs-reference comparison for the golden-output regression harness.
+//
+
+#include "VX1GoldenCompare.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr int kFftSize = 2048;
+constexpr int kHopSize = kFftSize / 2;
+
+/// In-place iterative radix-2 FFT.
+void fft(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t length = 2; length <= n; length <<= 1) {
+        const double angle = -2.0 * M_PI / (double)length;
+        const std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += length) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < length / 2; ++k) {
+                const std::complex<double> even = data[start + k];
+                const std::complex<double> odd = data[start + k + length / 2] * w;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+/// Accumulates Σ(|Y|−|R|)² and Σ|R|² over every frame of one channel.
+void accumulateSpectralError(std::span<const float> output, std::span<const float> reference,
+                             int channel, int channelCount, double& errorEnergy, double& referenceEnergy) {
+    const int64_t frames = (int64_t)reference.size() / channelCount;
+    std::vector<double> window(kFftSize);
+    for (int i = 0; i < kFftSize; ++i) {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * M_PI * i / kFftSize);
+    }
+
+    std::vector<std::complex<double>> y(kFftSize), r(kFftSize);
+    // Zero-padded past the end so short cases still get one frame
+    for (int64_t start = 0; start < std::max<int64_t>(frames - kHopSize, 1); start += kHopSize) {
+        for (int i = 0; i < kFftSize; ++i) {
+            const int64_t frame = start + i;
+            const size_t index = (size_t)(frame * channelCount + channel);
+            const bool inside = frame < frames;
+            y[i] = inside ? output[index] * window[i] : 0.0;
+            r[i] = inside ? reference[index] * window[i] : 0.0;
+        }
+        fft(y);
+        fft(r);
+        for (int bin = 0; bin <= kFftSize / 2; ++bin) {
+            const double difference = std::abs(y[bin]) - std::abs(r[bin]);
+            errorEnergy += difference * difference;
+            referenceEnergy += std::norm(r[bin]);
+        }
+    }
+}
+
+}
+
+bool VX1GoldenComparison::passes(const VX1GoldenTolerance& tolerance) const {
+    if (tolerance.bitExact && !bitExact) return false;
+    if (tolerance.maxAbsError >= 0.0 && !(maxAbsError <= tolerance.maxAbsError)) return false;
+    if (tolerance.spectralDb <= 0.0 && !(spectralDb <= tolerance.spectralDb)) return false;
+    return true;
+}
+
+std::string VX1GoldenComparison::describe() const {
+    if (bitExact) return "bit-exact";
+    char text[160];
+    std::snprintf(text, sizeof(text), "max abs %.3g at frame %lld, spectral %.1f dB",
+                  maxAbsError, (long long)maxAbsErrorFrame, spectralDb);
+    return text;
+}
+
+VX1GoldenComparison vx1CompareGolden(std::span<const float> output, std::span<const float> reference, int channelCount) {
+    VX1GoldenComparison result;
+    if (output.size() != reference.size()) {
+        result.bitExact = false;
+        result.maxAbsError = std::numeric_limits<double>::infinity();
+        result.spectralDb = std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    for (size_t i = 0; i < output.size(); ++i) {
+        // NaN where the reference has NaN too counts as unchanged
+        const bool identical = output[i] == reference[i] || (std::isnan(output[i]) && std::isnan(reference[i]));
+        if (identical) continue;
+        result.bitExact = false;
+        const double error = std::isfinite(output[i]) ? std::abs((double)output[i] - (double)reference[i])
+                                                      : std::numeric_limits<double>::infinity();
+        if (error > result.maxAbsError || result.maxAbsErrorFrame < 0) {
+            result.maxAbsError = error;
+            result.maxAbsErrorFrame = (int64_t)(i / channelCount);
+        }
+    }
+
+    if (result.bitExact) {
+        result.spectralDb = -std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    for (int channel = 0; channel < channelCount; ++channel) {
+        accumulateSpectralError(output, reference, channel, channelCount, errorEnergy, referenceEnergy);
+    }
+    if (errorEnergy == 0.0) {
+        result.spectralDb = -std::numeric_limits<double>::infinity();
+    } else if (referenceEnergy == 0.0 || !std::isfinite(errorEnergy)) {
+        result.spectralDb = std::numeric_limits<double>::infinity();
+    } else {
+        result.spectralDb = 10.0 * std::log10(errorEnergy / referenceEnergy);
+    }
+    return result;
+}
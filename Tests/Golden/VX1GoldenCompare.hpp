@@ -0,0 +1,42 @@
+//
+//  VX1GoldenCompare.hpp
+//  VX1 Tests
+//
+//  Output-vs-reference comparison for the golden-output regression harness.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ Which checks a comparison must pass. Every enabled check must hold:
+ - bitExact:    every sample identical (same build configuration only)
+ - maxAbsError: largest |output − reference| over all samples
+ - spectralDb:  magnitude-spectrum error, 10·log10(Σ(|Y|−|R|)² / Σ|R|²) over
+                Hann-windowed 2048-point frames (hop 1024) of every channel.
+                Phase-blind, so it tolerates tiny timing changes but catches
+                changes in level or harmonic content.
+
+ The defaults accept the block/scalar engine difference (kBlockEngineTolerance)
+ and fast-math changes of the same order, and nothing audible.
+ */
+struct VX1GoldenTolerance {
+    bool bitExact = false;
+    double maxAbsError = 1e-5;      // < 0 disables
+    double spectralDb = -80.0;      // > 0 disables
+};
+
+struct VX1GoldenComparison {
+    bool bitExact = true;
+    double maxAbsError = 0.0;
+    int64_t maxAbsErrorFrame = -1;   // frame of the largest error, -1 when identical
+    double spectralDb = 0.0;         // -inf when the magnitude spectra are identical
+
+    bool passes(const VX1GoldenTolerance& tolerance) const;
+    std::string describe() const;
+};
+
+VX1GoldenComparison vx1CompareGolden(std::span<const float> output, std::span<const float> reference, int channelCount);
@@ -0,0 +1,338 @@
+//
+//  VX1GoldenCorpus.cpp
+//  VX1 Tests
+//
+//  Fixed test corpus for the golden-output regression harness.
+//
+
+#include "VX1GoldenCorpus.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+/// Deterministic white noise in [-1, 1) (64-bit LCG, top 24 bits).
+class Noise {
+public:
+    explicit Noise(uint64_t seed) : mState(seed) {}
+
+    double next() {
+        mState = mState * 6364136223846793005ull + 1442695040888963407ull;
+        return (double)(mState >> 40) / (double)(1ull << 23) - 1.0;
+    }
+
+private:
+    uint64_t mState;
+};
+
+double dbToGain(double db) {
+    return std::pow(10.0, db / 20.0);
+}
+
+/// Writes the same mono signal to every channel, the right channel(s) scaled
+/// slightly so linked detection sees a real stereo image.
+template <typename Signal>
+std::vector<float> fill(const VX1GoldenCase& goldenCase, Signal signal) {
+    std::vector<float> interleaved((size_t)goldenCase.frameCount * goldenCase.channelCount);
+    for (int i = 0; i < goldenCase.frameCount; ++i) {
+        const double x = signal(i, (double)i / goldenCase.sampleRate);
+        for (int channel = 0; channel < goldenCase.channelCount; ++channel) {
+            interleaved[(size_t)i * goldenCase.channelCount + channel] = (float)(x * (channel == 0 ? 1.0 : 0.8));
+        }
+    }
+    return interleaved;
+}
+
+std::vector<float> sine100(const VX1GoldenCase& c) {
+    return fill(c, [](int, double t) { return dbToGain(-6.0) * std::sin(kTwoPi * 100.0 * t); });
+}
+
+std::vector<float> sine1k(const VX1GoldenCase& c) {
+    return fill(c, [](int, double t) { return dbToGain(-12.0) * std::sin(kTwoPi * 1000.0 * t); });
+}
+
+std::vector<float> sine7k(const VX1GoldenCase& c) {
+    return fill(c, [](int, double t) { return dbToGain(-3.0) * std::sin(kTwoPi * 7000.0 * t); });
+}
+
+/// Exponential sweep 20 Hz → 20 kHz over the case length.
+std::vector<float> logSweep(const VX1GoldenCase& c) {
+    const double duration = c.frameCount / c.sampleRate;
+    const double k = std::log(20000.0 / 20.0);
+    return fill(c, [&](int, double t) {
+        return dbToGain(-6.0) * std::sin(kTwoPi * 20.0 * duration / k * (std::exp(k * t / duration) - 1.0));
+    });
+}
+
+/// 40 ms noise bursts every 100 ms, alternating -6 and -24 dBFS.
+std::vector<float> noiseBursts(const VX1GoldenCase& c) {
+    Noise noise(0x5eed);
+    const int period = (int)(0.100 * c.sampleRate);
+    const int burst = (int)(0.040 * c.sampleRate);
+    return fill(c, [&](int i, double) {
+        const double n = noise.next();
+        if (i % period >= burst) return 0.0;
+        return n * dbToGain((i / period) % 2 == 0 ? -6.0 : -24.0);
+    });
+}
+
+/// Full-scale single-sample impulses every 50 ms.
+std::vector<float> impulseTrain(const VX1GoldenCase& c) {
+    const int period = (int)(0.050 * c.sampleRate);
+    return fill(c, [&](int i, double) { return i % period == 0 ? 1.0 : 0.0; });
+}
+
+/// 100 ms of digital silence, then a drum-like hit: 180 Hz body plus a noise crack, 60 ms decay.
+std::vector<float> silenceToTransient(const VX1GoldenCase& c) {
+    Noise noise(0xd2a5);
+    const int onset = (int)(0.100 * c.sampleRate);
+    return fill(c, [&](int i, double) {
+        const double n = noise.next();
+        if (i < onset) return 0.0;
+        const double t = (i - onset) / c.sampleRate;
+        const double decay = std::exp(-t / 0.060);
+        return decay * (0.7 * std::sin(kTwoPi * 180.0 * t) + 0.3 * n);
+    });
+}
+
+/// Vocal-like source for the parameter sweeps: a 180 Hz pulse train with a 4 Hz
+/// syllable envelope that dips to silence (so the gate has something to close on).
+std::vector<float> vocal(const VX1GoldenCase& c) {
+    Noise noise(0x70ca1);
+    return fill(c, [&](int, double t) {
+        const double syllable = std::max(0.0, std::sin(kTwoPi * 4.0 * t));
+        const double voiced = std::tanh(4.0 * std::sin(kTwoPi * 180.0 * t));
+        return syllable * (0.5 * voiced + 0.05 * noise.next());
+    });
+}
+
+/// Mono sidechain key: a 55 Hz kick with a 120 ms decay on every beat at 120 BPM.
+std::vector<float> kickKey(const VX1GoldenCase& c) {
+    const int period = (int)(0.500 * c.sampleRate);
+    std::vector<float> key((size_t)c.frameCount);
+    for (int i = 0; i < c.frameCount; ++i) {
+        const double t = (i % period) / c.sampleRate;
+        key[(size_t)i] = (float)(dbToGain(-3.0) * std::exp(-t / 0.120) * std::sin(kTwoPi * 55.0 * t));
+    }
+    return key;
+}
+
+/// Multichannel bed with different material per channel (SMPTE order for the first six):
+/// vocal in L/R/C, a 45 Hz LFE pulse, and noise bursts in the surrounds and beyond,
+/// staggered so the link modes see genuinely different channel levels.
+std::vector<float> surround(const VX1GoldenCase& c) {
+    std::vector<float> interleaved((size_t)c.frameCount * c.channelCount);
+    Noise noise(0x5a17);
+    const int burst = (int)(0.030 * c.sampleRate);
+    for (int i = 0; i < c.frameCount; ++i) {
+        const double t = i / c.sampleRate;
+        const double syllable = std::max(0.0, std::sin(kTwoPi * 4.0 * t));
+        const double voiced = syllable * std::tanh(4.0 * std::sin(kTwoPi * 180.0 * t));
+        for (int channel = 0; channel < c.channelCount; ++channel) {
+            double x;
+            if (channel < 3) {
+                x = voiced * (channel == 2 ? 0.6 : 0.3);
+            } else if (channel == 3) {
+                x = dbToGain(-6.0) * std::sin(kTwoPi * 45.0 * t) * (std::sin(kTwoPi * 2.0 * t) > 0.0 ? 1.0 : 0.1);
+            } else {
+                const int period = (int)((0.080 + 0.011 * channel) * c.sampleRate);
+                const double n = noise.next();
+                x = (i % period) < burst ? n * dbToGain(-3.0 - 2.0 * (channel % 4)) : 0.0;
+            }
+            interleaved[(size_t)i * c.channelCount + channel] = (float)x;
+        }
+    }
+    return interleaved;
+}
+
+VX1GoldenCase makeCase(std::string name, std::string description, int channelCount, int frameCount,
+                       std::vector<float> (*generate)(const VX1GoldenCase&)) {
+    VX1GoldenCase goldenCase;
+    goldenCase.name = std::move(name);
+    goldenCase.description = std::move(description);
+    goldenCase.channelCount = channelCount;
+    goldenCase.frameCount = frameCount;
+    goldenCase.generate = generate;
+    return goldenCase;
+}
+
+/// Steps `parameter` from `from` to `to` in 16 equal steps across the case.
+VX1GoldenCase makeSweepCase(const char* parameter, float from, float to) {
+    VX1GoldenCase goldenCase = makeCase(std::string("sweep_") + parameter,
+                                        std::string(parameter) + " stepped across its range on a vocal-like source",
+                                        1, 32768, vocal);
+    goldenCase.settings.setParameter("compress", 50.0f);
+    constexpr int kSteps = 16;
+    for (int step = 0; step < kSteps; ++step) {
+        const AUEventSampleTime sampleTime = (AUEventSampleTime)step * goldenCase.frameCount / kSteps;
+        goldenCase.settings.addAutomationPoint(parameter, sampleTime, from + (to - from) * (float)step / (kSteps - 1));
+    }
+    return goldenCase;
+}
+
+std::vector<VX1GoldenCase> buildCorpus() {
+    std::vector<VX1GoldenCase> corpus;
+
+    corpus.push_back(makeCase("sine_100hz", "100 Hz sine at -6 dBFS, default settings", 2, 16384, sine100));
+
+    corpus.push_back(makeCase("sine_1khz_bite", "1 kHz sine at -12 dBFS, heavy compression and Bite", 2, 16384, sine1k));
+    corpus.back().settings.setParameter("compress", 80.0f);
+    corpus.back().settings.setParameter("bite", 80.0f);
+    corpus.back().settings.setParameter("makeupGain", 6.0f);
+
+    corpus.push_back(makeCase("sine_7khz_os4x", "7 kHz sine at -3 dBFS, Bite 100 with 4x oversampling", 2, 16384, sine7k));
+    corpus.back().settings.setParameter("bite", 100.0f);
+    corpus.back().settings.setParameter("oversampling", 2.0f);
+
+    corpus.push_back(makeCase("sweep_log", "20 Hz–20 kHz exponential sweep at -6 dBFS", 2, 16384, logSweep));
+    corpus.back().settings.setParameter("compress", 60.0f);
+
+    corpus.push_back(makeCase("noise_bursts", "white noise bursts at -6/-24 dBFS, Stack and Grip", 2, 16384, noiseBursts));
+    corpus.back().settings.setParameter("compress", 60.0f);
+    corpus.back().settings.setParameter("stack", 60.0f);
+    corpus.back().settings.setParameter("grip", 70.0f);
+
+    corpus.push_back(makeCase("impulse_train", "full-scale impulses every 50 ms, fastest speed", 2, 16384, impulseTrain));
+    corpus.back().settings.setParameter("compress", 70.0f);
+    corpus.back().settings.setParameter("speed", 0.1f);
+    corpus.back().settings.setParameter("mix", 60.0f);
+
+    corpus.push_back(makeCase("silence_to_transient", "digital silence into a drum-like hit, gate armed", 2, 16384, silenceToTransient));
+    corpus.back().settings.setParameter("compress", 50.0f);
+    corpus.back().settings.setParameter("gateThreshold", -50.0f);
+
+    // Sidechain link modes on a 5.1 bed, and unlinked lanes across a full 16-channel layout
+    constexpr const char* kLinkNames[] = { "all", "lcr", "unlinked", "max" };
+    for (int link = 0; link < 4; ++link) {
+        corpus.push_back(makeCase(std::string("surround_link_") + kLinkNames[link],
+                                  std::string("5.1 bed, sidechain link ") + kLinkNames[link] + ", Stack and Bite",
+                                  6, 16384, surround));
+        corpus.back().settings.setParameter("compress", 60.0f);
+        corpus.back().settings.setParameter("stack", 40.0f);
+        corpus.back().settings.setParameter("bite", 60.0f);
+        corpus.back().settings.setParameter("gateThreshold", -50.0f);
+        corpus.back().settings.setParameter("sidechainLink", (float)link);
+    }
+    corpus.push_back(makeCase("unlinked_16ch", "16-channel bed, unlinked, Bite 4x oversampled", 16, 8192, surround));
+    corpus.back().settings.setParameter("compress", 70.0f);
+    corpus.back().settings.setParameter("bite", 80.0f);
+    corpus.back().settings.setParameter("oversampling", 2.0f);
+    corpus.back().settings.setParameter("sidechainLink", 2.0f);
+
+    corpus.push_back(makeCase("limiter_noise_bursts", "noise bursts driven +12 dB into the -1 dBFS lookahead limiter",
+                              2, 16384, noiseBursts));
+    corpus.back().settings.setParameter("compress", 40.0f);
+    corpus.back().settings.setParameter("grip", 100.0f);
+    corpus.back().settings.setParameter("makeupGain", 12.0f);
+    corpus.back().settings.setParameter("limiter", 1.0f);
+    corpus.back().settings.setParameter("limiterCeiling", -1.0f);
+
+    corpus.push_back(makeCase("multiband_4band", "20 Hz–20 kHz exponential sweep, four bands, Grip and Bite",
+                              2, 16384, logSweep));
+    corpus.back().settings.setParameter("compress", 60.0f);
+    corpus.back().settings.setParameter("grip", 40.0f);
+    corpus.back().settings.setParameter("bite", 40.0f);
+    corpus.back().settings.setParameter("multiband", 3.0f);
+
+    // External key: Internal, then External, then Mix, a third of the case each
+    corpus.push_back(makeCase("sidechain_key", "vocal-like source keyed by a kick on the sidechain, every source mode",
+                              2, 49152, vocal));
+    corpus.back().sidechainChannelCount = 1;
+    corpus.back().generateSidechain = kickKey;
+    corpus.back().settings.setParameter("compress", 60.0f);
+    corpus.back().settings.addAutomationPoint("sidechainSource", 16384, 1.0f);
+    corpus.back().settings.addAutomationPoint("sidechainSource", 32768, 2.0f);
+
+    // AU-style ramp events (explicit durations) on every smoothed parameter, plus a de-zippered step
+    corpus.push_back(makeCase("ramps_smoothed", "compress, speed, makeup and mix ramps on a vocal-like source",
+                              2, 32768, vocal));
+    corpus.back().settings.setParameter("stack", 50.0f);
+    corpus.back().settings.addAutomationPoint("compress", 4096, 80.0f, 8192);
+    corpus.back().settings.addAutomationPoint("speed", 8192, 1.0f, 4096);
+    corpus.back().settings.addAutomationPoint("makeupGain", 12288, 9.0f, 6000);
+    corpus.back().settings.addAutomationPoint("mix", 20000, 40.0f, 3000);
+    corpus.back().settings.addAutomationPoint("makeupGain", 26000, -3.0f);
+
+    // High rates: DXD at the full detector rate, and 768 kHz with the reduced-rate detector (8x)
+    corpus.push_back(makeCase("noise_bursts_352k8", "noise bursts at 352.8 kHz, Stack and Grip", 1, 65536, noiseBursts));
+    corpus.back().sampleRate = 352800.0;
+    corpus.back().settings.setParameter("compress", 60.0f);
+    corpus.back().settings.setParameter("stack", 40.0f);
+    corpus.back().settings.setParameter("grip", 50.0f);
+
+    corpus.push_back(makeCase("noise_bursts_768k_reduced", "noise bursts at 768 kHz, reduced-rate sidechain, Stack and gate",
+                              1, 131072, noiseBursts));
+    corpus.back().sampleRate = 768000.0;
+    corpus.back().settings.setParameter("compress", 60.0f);
+    corpus.back().settings.setParameter("stack", 40.0f);
+    corpus.back().settings.setParameter("gateThreshold", -40.0f);
+    corpus.back().settings.setParameter("sidechainRate", 1.0f);
+
+    // The double-precision linked detector on a slow, RMS-heavy setting, where its state
+    // sits closest to 1, at a base rate and at 192 kHz
+    for (double sampleRate : { 48000.0, 192000.0 }) {
+        const int kiloHertz = (int)(sampleRate / 1000.0);
+        corpus.push_back(makeCase("vocal_double_" + std::to_string(kiloHertz) + "k",
+                                  "vocal-like source at " + std::to_string(kiloHertz) + " kHz, double-precision detector, Stack and gate",
+                                  2, sampleRate > 48000.0 ? 65536 : 32768, vocal));
+        corpus.back().sampleRate = sampleRate;
+        corpus.back().detectorPrecision = VX1ExtensionDSPKernel::DetectorPrecision::double_;
+        corpus.back().settings.setParameter("compress", 70.0f);
+        corpus.back().settings.setParameter("speed", 40.0f);
+        corpus.back().settings.setParameter("stack", 50.0f);
+        corpus.back().settings.setParameter("gateThreshold", -60.0f);
+        corpus.back().settings.addAutomationPoint("compress", corpus.back().frameCount / 2, 50.0f);
+    }
+
+    corpus.push_back(makeSweepCase("compress", 0.0f, 100.0f));
+    corpus.push_back(makeSweepCase("speed", 0.1f, 200.0f));
+    corpus.push_back(makeSweepCase("grip", 0.0f, 100.0f));
+    corpus.push_back(makeSweepCase("bite", 0.0f, 100.0f));
+    corpus.push_back(makeSweepCase("stack", 0.0f, 100.0f));
+    corpus.push_back(makeSweepCase("gateThreshold", -80.0f, -20.0f));
+    corpus.push_back(makeSweepCase("tube", 0.0f, 3.0f));
+    corpus.push_back(makeSweepCase("multiband", 0.0f, 3.0f));
+
+    for (VX1GoldenCase& goldenCase : corpus) {
+        goldenCase.settings.finalize();
+    }
+    return corpus;
+}
+
+}
+
+std::span<const VX1GoldenCase> vx1GoldenCorpus() {
+    static const std::vector<VX1GoldenCase> corpus = buildCorpus();
+    return corpus;
+}
+
+std::vector<float> vx1RenderGoldenCase(const VX1GoldenCase& goldenCase, VX1ExtensionDSPKernel::Engine engine) {
+    const std::vector<float> input = goldenCase.generate(goldenCase);
+    const std::vector<float> sidechain = goldenCase.generateSidechain ? goldenCase.generateSidechain(goldenCase)
+                                                                      : std::vector<float>();
+
+    VX1RenderOptions options;
+    options.blockFrames = 512;
+    options.chunkFrames = goldenCase.frameCount;
+    options.engine = engine;
+    options.detectorPrecision = goldenCase.detectorPrecision;
+    VX1StreamRenderer renderer(goldenCase.settings, options);
+    renderer.prepare(goldenCase.channelCount, goldenCase.sampleRate, goldenCase.sidechainChannelCount);
+
+    std::vector<float> output(input.size());
+    const int frames = renderer.process(input.data(), output.data(), goldenCase.frameCount,
+                                        sidechain.empty() ? nullptr : sidechain.data());
+    int written = frames;
+    while (written < goldenCase.frameCount) {
+        const int tail = renderer.flush(output.data() + (size_t)written * goldenCase.channelCount,
+                                        goldenCase.frameCount - written);
+        if (tail == 0) throw std::runtime_error(goldenCase.name + ": renderer produced too few frames");
+        written += tail;
+    }
+    return output;
+}
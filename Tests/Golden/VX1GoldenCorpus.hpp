@@ -0,0 +1,47 @@
+//
+//  VX1GoldenCorpus.hpp
+//  VX1 Tests
+//
+//  Fixed test corpus for the golden-output regression harness.
+//
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "VX1RenderSettings.hpp"
+#include "VX1StreamRenderer.hpp"
+
+/**
+ VX1GoldenCase
+
+ One corpus entry: a deterministic input signal, the parameters it is rendered
+ with and any automation. Signals are generated in double precision from a
+ fixed-seed LCG (not <random>, whose distributions differ between standard
+ libraries), so every platform feeds the kernel the same samples.
+ */
+struct VX1GoldenCase {
+    std::string name;
+    std::string description;
+    int channelCount = 2;
+    double sampleRate = 48000.0;
+    int frameCount = 16384;
+    VX1RenderSettings settings;
+    VX1ExtensionDSPKernel::DetectorPrecision detectorPrecision = VX1ExtensionDSPKernel::DetectorPrecision::single;
+
+    /// Interleaved input, channelCount × frameCount.
+    std::vector<float> (*generate)(const VX1GoldenCase&) = nullptr;
+
+    /// External sidechain key, interleaved sidechainChannelCount × frameCount (none if 0).
+    int sidechainChannelCount = 0;
+    std::vector<float> (*generateSidechain)(const VX1GoldenCase&) = nullptr;
+};
+
+/// The whole corpus, in a stable order.
+std::span<const VX1GoldenCase> vx1GoldenCorpus();
+
+/// Renders one case through VX1StreamRenderer (512-frame blocks, latency compensated).
+/// Returns interleaved output with the same length as the input.
+std::vector<float> vx1RenderGoldenCase(const VX1GoldenCase& goldenCase, VX1ExtensionDSPKernel::Engine engine);
@@ -0,0 +1,157 @@
+//
+//  vx1_golden.cpp
+//  VX1 Tests
+//
+//  Golden-output regression harness: renders the corpus through the kernel and
+//  compares against the stored references in Tests/Golden/References.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VX1GoldenCompare.hpp"
+#include "VX1GoldenCorpus.hpp"
+
+namespace {
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: vx1_golden --references DIR [options]\n"
+        "\n"
+        "Renders every corpus case and compares it with DIR/<case>.f32\n"
+        "(raw interleaved little-endian float32). Exits 1 if any case fails.\n"
+        "\n"
+        "options:\n"
+        "  --update                 (re)write the references instead of comparing\n"
+        "  --engine block|scalar    kernel engine (default block)\n"
+        "  --bit-exact              require identical samples\n"
+        "  --max-abs X              max absolute sample error (default 1e-5; negative disables)\n"
+        "  --spectral-db X          max magnitude-spectrum error in dB (default -80; positive disables)\n"
+        "  --filter TEXT            only cases whose name contains TEXT\n"
+        "  --write-failures DIR     write failing outputs to DIR/<case>.f32 for inspection\n"
+        "  --list                   list the corpus and exit\n");
+}
+
+std::vector<float> readReference(const std::filesystem::path& path, size_t sampleCount) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error(path.string() + ": missing reference (run with --update)");
+    std::vector<float> samples(sampleCount);
+    file.read(reinterpret_cast<char*>(samples.data()), (std::streamsize)(sampleCount * sizeof(float)));
+    if ((size_t)file.gcount() != sampleCount * sizeof(float) || file.peek() != std::char_traits<char>::eof()) {
+        throw std::runtime_error(path.string() + ": reference length does not match the case");
+    }
+    return samples;
+}
+
+void writeSamples(const std::filesystem::path& path, const std::vector<float>& samples) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(samples.data()), (std::streamsize)(samples.size() * sizeof(float)));
+    if (!file) throw std::runtime_error(path.string() + ": write failed");
+}
+
+double parseNumber(const char* text, const std::string& option) {
+    char* end = nullptr;
+    const double value = std::strtod(text, &end);
+    if (end == text || *end != '\0') throw std::runtime_error(option + " expects a number");
+    return value;
+}
+
+}
+
+int main(int argc, char** argv) {
+    static_assert(sizeof(float) == 4, "references are float32");
+    try {
+        std::filesystem::path referenceDirectory, failureDirectory;
+        VX1GoldenTolerance tolerance;
+        VX1ExtensionDSPKernel::Engine engine = VX1ExtensionDSPKernel::Engine::block;
+        std::string filter;
+        bool update = false;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> const char* {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " expects a value");
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--list") {
+                for (const VX1GoldenCase& goldenCase : vx1GoldenCorpus()) {
+                    std::printf("%-22s %d ch, %d frames @ %.0f Hz — %s\n", goldenCase.name.c_str(), goldenCase.channelCount,
+                                goldenCase.frameCount, goldenCase.sampleRate, goldenCase.description.c_str());
+                }
+                return 0;
+            } else if (arg == "--references") {
+                referenceDirectory = value();
+            } else if (arg == "--update") {
+                update = true;
+            } else if (arg == "--engine") {
+                const std::string name = value();
+                if (name == "block") {
+                    engine = VX1ExtensionDSPKernel::Engine::block;
+                } else if (name == "scalar") {
+                    engine = VX1ExtensionDSPKernel::Engine::scalar;
+                } else {
+                    throw std::runtime_error("--engine expects block or scalar");
+                }
+            } else if (arg == "--bit-exact") {
+                tolerance.bitExact = true;
+            } else if (arg == "--max-abs") {
+                tolerance.maxAbsError = parseNumber(value(), arg);
+            } else if (arg == "--spectral-db") {
+                tolerance.spectralDb = parseNumber(value(), arg);
+            } else if (arg == "--filter") {
+                filter = value();
+            } else if (arg == "--write-failures") {
+                failureDirectory = value();
+            } else {
+                throw std::runtime_error("unknown argument " + arg);
+            }
+        }
+        if (referenceDirectory.empty()) {
+            printUsage();
+            return 2;
+        }
+        if (update) std::filesystem::create_directories(referenceDirectory);
+        if (!failureDirectory.empty()) std::filesystem::create_directories(failureDirectory);
+
+        int failures = 0, cases = 0;
+        for (const VX1GoldenCase& goldenCase : vx1GoldenCorpus()) {
+            if (!filter.empty() && goldenCase.name.find(filter) == std::string::npos) continue;
+            ++cases;
+            const std::vector<float> output = vx1RenderGoldenCase(goldenCase, engine);
+            const std::filesystem::path referencePath = referenceDirectory / (goldenCase.name + ".f32");
+
+            if (update) {
+                writeSamples(referencePath, output);
+                std::printf("%-22s written\n", goldenCase.name.c_str());
+                continue;
+            }
+
+            const std::vector<float> reference = readReference(referencePath, output.size());
+            const VX1GoldenComparison comparison = vx1CompareGolden(output, reference, goldenCase.channelCount);
+            const bool passed = comparison.passes(tolerance);
+            std::printf("%-22s %s  %s\n", goldenCase.name.c_str(), passed ? "PASS" : "FAIL", comparison.describe().c_str());
+            if (!passed) {
+                ++failures;
+                if (!failureDirectory.empty()) {
+                    writeSamples(failureDirectory / (goldenCase.name + ".f32"), output);
+                }
+            }
+        }
+
+        if (!update) {
+            std::printf("%d/%d cases passed\n", cases - failures, cases);
+        }
+        return failures == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "vx1_golden: %s\n", e.what());
+        return 1;
+    }
+}
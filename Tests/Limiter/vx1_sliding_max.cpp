@@ -0,0 +1,81 @@
+//
+//  vx1_sliding_max.cpp
+//  VX1 Tests
+//
+//  VX1SlidingMax against a brute-force maximum of the last `window` samples, for
+//  every window up to the prepared capacity (window == capacity included) on
+//  falling, rising, random and plateaued input. Exits 1 on the first mismatch per
+//  case.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "VX1ExtensionLookaheadLimiter.hpp"
+
+namespace {
+
+constexpr int kFrames = 1000;
+int gFailures = 0;
+
+/// Pushes `input` through a VX1SlidingMax prepared for `capacity` and checks every output.
+bool matchesBruteForce(const std::vector<float>& input, int capacity, int window) {
+    VX1SlidingMax slidingMax;
+    slidingMax.prepare(capacity);
+    slidingMax.setWindow(window);
+    for (size_t n = 0; n < input.size(); ++n) {
+        const size_t first = n + 1 >= (size_t)window ? n + 1 - (size_t)window : 0;
+        const float expected = *std::max_element(input.begin() + first, input.begin() + n + 1);
+        const float actual = slidingMax.push(input[n]);
+        if (actual != expected) {
+            std::printf("  capacity %d, window %d, frame %zu: %g, expected %g\n", capacity, window, n,
+                        actual, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+void expect(const std::string& name, bool passed) {
+    std::printf("%-48s %s\n", name.c_str(), passed ? "ok" : "FAIL");
+    if (!passed) ++gFailures;
+}
+
+}
+
+int main() {
+    std::printf("VX1SlidingMax vs brute force (%d frames per case)\n", kFrames);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::vector<float> falling(kFrames), rising(kFrames), random(kFrames), plateaus(kFrames);
+    for (int n = 0; n < kFrames; ++n) {
+        falling[n] = (float)(kFrames - n);
+        rising[n] = (float)n;
+        random[n] = uniform(rng);
+        plateaus[n] = (float)((n / 7) % 5);
+    }
+    const std::pair<const char*, const std::vector<float>*> inputs[] = {
+        { "falling", &falling }, { "rising", &rising }, { "random", &random }, { "plateaus", &plateaus },
+    };
+
+    // Powers of two (ring exactly full at window == capacity) and sizes that round up
+    for (int capacity : { 1, 2, 4, 5, 16, 64, 65 }) {
+        for (const auto& [name, input] : inputs) {
+            bool passed = true;
+            for (int window = 1; window <= capacity && passed; ++window) {
+                passed = matchesBruteForce(*input, capacity, window);
+            }
+            expect("capacity " + std::to_string(capacity) + ", " + name, passed);
+        }
+    }
+
+    if (gFailures > 0) {
+        std::printf("%d case(s) failed\n", gFailures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,280 @@
+//
+//  vx1_realtime_alloc.cpp
+//  VX1 Tests
+//
+//  Realtime-safety check: counts heap allocations (malloc and friends, hooked for
+//  the whole process) while the kernel renders every feature, resets and
+//  re-initializes at other sample rates and channel counts. Exits 1 if any render,
+//  reset() or repeated initialize() allocated. Linux/glibc only.
+//
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+#include "VX1ExtensionKernelBank.hpp"
+
+// MARK: - malloc hook
+
+// glibc's own entry points, so the replacements below can forward to them
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+
+namespace {
+
+// Counting is per thread: only allocations made by the thread under test count
+thread_local bool tCounting = false;
+std::atomic<long> gAllocations { 0 };
+
+void countAllocation() {
+    if (tCounting) gAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+extern "C" {
+
+void* malloc(size_t bytes) {
+    countAllocation();
+    return __libc_malloc(bytes);
+}
+
+void* calloc(size_t count, size_t bytes) {
+    countAllocation();
+    return __libc_calloc(count, bytes);
+}
+
+void* realloc(void* pointer, size_t bytes) {
+    countAllocation();
+    return __libc_realloc(pointer, bytes);
+}
+
+void* memalign(size_t alignment, size_t bytes) {
+    countAllocation();
+    return __libc_memalign(alignment, bytes);
+}
+
+void* aligned_alloc(size_t alignment, size_t bytes) {
+    countAllocation();
+    return __libc_memalign(alignment, bytes);
+}
+
+int posix_memalign(void** pointer, size_t alignment, size_t bytes) {
+    countAllocation();
+    *pointer = __libc_memalign(alignment, bytes);
+    return *pointer != nullptr ? 0 : 12;   // ENOMEM
+}
+
+void free(void* pointer) {
+    __libc_free(pointer);
+}
+
+}
+
+// MARK: - Checks
+
+namespace {
+
+constexpr int kBlockFrames = 512;
+int gFailures = 0;
+
+/// Runs `body` with allocation counting on and reports how many allocations it made.
+void expectNoAllocations(const std::string& name, const std::function<void()>& body) {
+    gAllocations.store(0);
+    tCounting = true;
+    body();
+    tCounting = false;
+    const long allocations = gAllocations.load();
+    std::printf("%-48s %s", name.c_str(), allocations == 0 ? "ok\n" : "FAIL");
+    if (allocations != 0) {
+        std::printf(" (%ld allocations)\n", allocations);
+        ++gFailures;
+    }
+}
+
+/// Buffers for one kernel: channelCount planar input, output and key channels.
+struct Buffers {
+    std::vector<std::vector<float>> input, output, key;
+    std::vector<const float*> inputPointers, keyPointers;
+    std::vector<float*> outputPointers;
+
+    explicit Buffers(int channelCount)
+        : input(channelCount, std::vector<float>(kBlockFrames)), output(channelCount, std::vector<float>(kBlockFrames)),
+          key(channelCount, std::vector<float>(kBlockFrames)) {
+        for (int c = 0; c < channelCount; ++c) {
+            inputPointers.push_back(input[c].data());
+            outputPointers.push_back(output[c].data());
+            keyPointers.push_back(key[c].data());
+        }
+    }
+
+    /// A syllable-shaped tone per channel, continuing from `block`; silence when `silent`.
+    void fill(int block, bool silent = false) {
+        for (size_t c = 0; c < input.size(); ++c) {
+            for (int i = 0; i < kBlockFrames; ++i) {
+                const double t = (double)(block * kBlockFrames + i) / 48000.0;
+                const double syllable = std::max(0.0, std::sin(2.0 * M_PI * 3.0 * t));
+                input[c][i] = silent ? 0.0f : (float)(0.6 * syllable * std::sin(2.0 * M_PI * (180.0 + 40.0 * (double)c) * t));
+                key[c][i] = silent ? 0.0f : (float)(0.8 * std::sin(2.0 * M_PI * 60.0 * t) * (std::fmod(t, 0.5) < 0.1 ? 1.0 : 0.0));
+            }
+        }
+    }
+
+    std::span<float const*> in() { return inputPointers; }
+    std::span<float const*> sidechain() { return keyPointers; }
+    std::span<float*> out() { return outputPointers; }
+};
+
+void render(VX1ExtensionDSPKernel& kernel, Buffers& buffers, int blocks, int& block, bool silent = false) {
+    static const VX1ParameterTimeline noEvents(0);
+    for (int b = 0; b < blocks; ++b, ++block) {
+        buffers.fill(block, silent);
+        kernel.process(buffers.in(), buffers.sidechain(), buffers.out(), (AUEventSampleTime)block * kBlockFrames,
+                       kBlockFrames, noEvents);
+    }
+}
+
+/// Every feature on in turn, with parameter changes (and so ramps) between blocks.
+void renderEveryFeature(VX1ExtensionDSPKernel& kernel, Buffers& buffers) {
+    using Address = VX1ExtensionParameterAddress;
+    VX1TelemetryFrame frame;
+    int block = 0;
+
+    kernel.setTelemetryEnabled(true);
+    render(kernel, buffers, 4, block);
+    while (kernel.popTelemetry(frame)) {}
+
+    kernel.setParameter(Address::compress, 80.0f);
+    kernel.setParameter(Address::speed, 3.0f);
+    kernel.setParameter(Address::makeupGain, 6.0f);
+    kernel.setParameter(Address::mix, 60.0f);
+    kernel.setParameter(Address::grip, 70.0f);
+    kernel.setParameter(Address::bite, 80.0f);
+    kernel.setParameter(Address::stack, 100.0f);
+    kernel.setParameter(Address::gateThreshold, -40.0f);
+    render(kernel, buffers, 4, block);
+
+    for (float factor : { 1.0f, 2.0f, 3.0f, 0.0f }) {
+        kernel.setParameter(Address::oversampling, factor);
+        render(kernel, buffers, 2, block);
+    }
+    for (float link : { 1.0f, 2.0f, 3.0f, 0.0f }) {
+        kernel.setParameter(Address::sidechainLink, link);
+        render(kernel, buffers, 2, block);
+    }
+    kernel.setParameter(Address::limiter, 1.0f);
+    kernel.setParameter(Address::limiterCeiling, -6.0f);
+    for (float tube : { 1.0f, 2.0f, 3.0f }) {
+        kernel.setParameter(Address::tube, tube);
+        render(kernel, buffers, 2, block);
+    }
+    for (float bands : { 1.0f, 2.0f, 3.0f, 0.0f }) {
+        kernel.setParameter(Address::multiband, bands);
+        kernel.setParameter(Address::crossoverHigh, 4000.0f + 500.0f * bands);
+        render(kernel, buffers, 2, block);
+    }
+    for (float source : { 1.0f, 2.0f, 0.0f }) {
+        kernel.setParameter(Address::sidechainSource, source);
+        render(kernel, buffers, 2, block);
+    }
+    for (float rate : { 1.0f, 0.0f }) {
+        kernel.setParameter(Address::sidechainRate, rate);
+        render(kernel, buffers, 2, block);
+    }
+    using Precision = VX1ExtensionDSPKernel::DetectorPrecision;
+    for (Precision precision : { Precision::double_, Precision::single }) {
+        kernel.setDetectorPrecision(precision);
+        render(kernel, buffers, 2, block);
+    }
+    kernel.setProcessingEngine(VX1ExtensionDSPKernel::Engine::scalar);
+    render(kernel, buffers, 2, block);
+    kernel.setProcessingEngine(VX1ExtensionDSPKernel::Engine::block);
+    kernel.setBypass(true);
+    render(kernel, buffers, 1, block);
+    kernel.setBypass(false);
+
+    // Long enough for the silent-block fast path to engage
+    render(kernel, buffers, 600, block, true);
+    render(kernel, buffers, 2, block);
+    while (kernel.popTelemetry(frame)) {}
+}
+
+}
+
+int main() {
+    std::printf("VX1 realtime allocation check (%d-frame blocks)\n", kBlockFrames);
+
+    // The hook has to see allocations for the checks below to mean anything
+    gAllocations.store(0);
+    tCounting = true;
+    std::vector<float>* probe = new std::vector<float>(16);
+    tCounting = false;
+    delete probe;
+    if (gAllocations.load() < 2) {
+        std::printf("malloc hook is not active\n");
+        return 1;
+    }
+
+    VX1ExtensionDSPKernel kernel;
+    kernel.initialize(8, 8, 48000.0);
+    Buffers eight(8), stereo(2), mono(1);
+
+    expectNoAllocations("process(): every feature, 8 channels", [&] { renderEveryFeature(kernel, eight); });
+    expectNoAllocations("reset()", [&] { kernel.reset(); });
+    expectNoAllocations("deInitialize() + initialize() 96 kHz, 8 ch", [&] {
+        kernel.deInitialize();
+        kernel.initialize(8, 8, 96000.0);
+    });
+    expectNoAllocations("initialize() 44.1 kHz, 2 ch", [&] { kernel.initialize(2, 2, 44100.0); });
+    expectNoAllocations("process(): every feature, 2 channels", [&] { renderEveryFeature(kernel, stereo); });
+    expectNoAllocations("initialize() 192 kHz, 1 ch", [&] { kernel.initialize(1, 1, 192000.0); });
+    expectNoAllocations("process(): every feature, 1 channel", [&] { renderEveryFeature(kernel, mono); });
+    expectNoAllocations("initialize() 48 kHz, 8 ch", [&] { kernel.initialize(8, 8, 48000.0); });
+
+    VX1KernelBank bank;
+    bank.initialize(6, 2, 48000.0, kBlockFrames);
+    std::vector<Buffers> instanceBuffers;
+    instanceBuffers.reserve(6);   // the spans below point into each element
+    for (int instance = 0; instance < 6; ++instance) instanceBuffers.emplace_back(2);
+    std::vector<VX1KernelBank::InstanceBuffers> instances;
+    for (Buffers& buffers : instanceBuffers) {
+        instances.push_back({ buffers.in(), buffers.out() });
+    }
+    expectNoAllocations("VX1KernelBank::process(), 6 instances", [&] {
+        for (int block = 0; block < 32; ++block) {
+            for (Buffers& buffers : instanceBuffers) buffers.fill(block);
+            bank.process(instances, (AUEventSampleTime)block * kBlockFrames, kBlockFrames);
+        }
+    });
+
+#if VX1_REALTIME_ALLOCATION_TRAP
+    // The trap itself: an allocation inside a scope reaches the handler, one outside does not
+    static std::atomic<int> trapped { 0 };
+    vx1::realtime::setAllocationHandler([](size_t) { trapped.fetch_add(1); });
+    delete new int(1);
+    {
+        const VX1RealtimeScope scope;
+        delete new int(2);
+    }
+    vx1::realtime::setAllocationHandler(nullptr);
+    std::printf("%-48s %s\n", "allocation trap", trapped.load() == 1 ? "ok" : "FAIL");
+    if (trapped.load() != 1) ++gFailures;
+#endif
+
+    if (gFailures > 0) {
+        std::printf("%d check(s) allocated on the render path\n", gFailures);
+        return 1;
+    }
+    return 0;
+}
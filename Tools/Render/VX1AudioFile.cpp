@@ -0,0 +1,407 @@
+//
+//  VX1AudioFile.cpp
+//  VX1 Tools
+//
+//  Streaming WAV / raw float32 reader and writer for the offline renderers.
+//
+
+#include "VX1AudioFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatIeeeFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+constexpr uint32_t kUnknownSize32 = 0xFFFFFFFFu;
+
+// Header layout written by VX1AudioFileWriter: RIFF + JUNK(28, becomes ds64) + fmt + data
+constexpr long kRiffSizeOffset = 4;
+constexpr long kJunkOffset = 12;
+
+uint16_t readLE16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+uint32_t readLE32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+uint64_t readLE64(const uint8_t* p) { return (uint64_t)readLE32(p) | ((uint64_t)readLE32(p + 4) << 32); }
+
+void writeLE16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+void writeLE32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+void writeLE64(uint8_t* p, uint64_t v) { for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+
+[[noreturn]] void fail(const std::string& path, const std::string& message) {
+    throw std::runtime_error(path + ": " + message);
+}
+
+void readExactly(std::FILE* file, const std::string& path, void* destination, size_t bytes) {
+    if (std::fread(destination, 1, bytes, file) != bytes) {
+        fail(path, "unexpected end of file in header");
+    }
+}
+
+/// Skips bytes without relying on fseek, so headers can be parsed from a pipe.
+void skipBytes(std::FILE* file, const std::string& path, uint64_t bytes) {
+    uint8_t discard[4096];
+    while (bytes > 0) {
+        const size_t chunk = (size_t)std::min<uint64_t>(bytes, sizeof discard);
+        readExactly(file, path, discard, chunk);
+        bytes -= chunk;
+    }
+}
+
+}
+
+int vx1BytesPerSample(VX1SampleEncoding encoding) {
+    switch (encoding) {
+        case VX1SampleEncoding::float32: return 4;
+        case VX1SampleEncoding::float64: return 8;
+        case VX1SampleEncoding::pcm16:   return 2;
+        case VX1SampleEncoding::pcm24:   return 3;
+        case VX1SampleEncoding::pcm32:   return 4;
+    }
+    return 4;
+}
+
+VX1SampleEncoding vx1ParseSampleEncoding(const std::string& name) {
+    if (name == "f32") return VX1SampleEncoding::float32;
+    if (name == "f64") return VX1SampleEncoding::float64;
+    if (name == "s16") return VX1SampleEncoding::pcm16;
+    if (name == "s24") return VX1SampleEncoding::pcm24;
+    if (name == "s32") return VX1SampleEncoding::pcm32;
+    throw std::runtime_error("unknown sample format '" + name + "' (expected f32, f64, s16, s24 or s32)");
+}
+
+bool vx1IsRawPath(const std::string& path) {
+    auto endsWith = [&](const char* suffix) {
+        const size_t length = std::strlen(suffix);
+        return path.size() >= length && path.compare(path.size() - length, length, suffix) == 0;
+    };
+    return endsWith(".raw") || endsWith(".f32");
+}
+
+// MARK: - Reader
+
+VX1AudioFileReader::VX1AudioFileReader(const std::string& path) : mPath(path) {
+    openFile();
+    parseWavHeader();
+}
+
+VX1AudioFileReader::VX1AudioFileReader(const std::string& path, int channelCount, double sampleRate) : mPath(path) {
+    if (channelCount < 1 || sampleRate <= 0.0) {
+        fail(path, "raw input needs a positive channel count and sample rate");
+    }
+    mFormat.channelCount = channelCount;
+    mFormat.sampleRate = sampleRate;
+    mFormat.encoding = VX1SampleEncoding::float32;
+    openFile();
+}
+
+VX1AudioFileReader::~VX1AudioFileReader() {
+    if (mFile && mOwnsFile) {
+        std::fclose(mFile);
+    }
+}
+
+void VX1AudioFileReader::openFile() {
+    if (mPath == "-") {
+        mFile = stdin;
+        mOwnsFile = false;
+    } else {
+        mFile = std::fopen(mPath.c_str(), "rb");
+    }
+    if (!mFile) {
+        fail(mPath, "cannot open for reading");
+    }
+}
+
+void VX1AudioFileReader::parseWavHeader() {
+    uint8_t header[12];
+    readExactly(mFile, mPath, header, sizeof header);
+    const bool isRf64 = std::memcmp(header, "RF64", 4) == 0;
+    if ((!isRf64 && std::memcmp(header, "RIFF", 4) != 0) || std::memcmp(header + 8, "WAVE", 4) != 0) {
+        fail(mPath, "not a RIFF/WAVE or RF64 file");
+    }
+
+    uint64_t ds64DataSize = 0;
+    bool haveFormat = false;
+    for (;;) {
+        uint8_t chunkHeader[8];
+        readExactly(mFile, mPath, chunkHeader, sizeof chunkHeader);
+        const uint32_t chunkSize = readLE32(chunkHeader + 4);
+
+        if (std::memcmp(chunkHeader, "ds64", 4) == 0) {
+            std::vector<uint8_t> ds64(chunkSize);
+            readExactly(mFile, mPath, ds64.data(), chunkSize);
+            if (chunkSize >= 16) ds64DataSize = readLE64(ds64.data() + 8);
+        } else if (std::memcmp(chunkHeader, "fmt ", 4) == 0) {
+            std::vector<uint8_t> fmt(chunkSize);
+            readExactly(mFile, mPath, fmt.data(), chunkSize);
+            if (chunkSize < 16) fail(mPath, "fmt chunk too short");
+            uint16_t formatTag = readLE16(fmt.data());
+            mFormat.channelCount = readLE16(fmt.data() + 2);
+            mFormat.sampleRate = (double)readLE32(fmt.data() + 4);
+            const uint16_t bitsPerSample = readLE16(fmt.data() + 14);
+            if (formatTag == kFormatExtensible && chunkSize >= 26) {
+                formatTag = readLE16(fmt.data() + 24);   // first two bytes of the sub-format GUID
+            }
+            if (formatTag == kFormatIeeeFloat && bitsPerSample == 32) {
+                mFormat.encoding = VX1SampleEncoding::float32;
+            } else if (formatTag == kFormatIeeeFloat && bitsPerSample == 64) {
+                mFormat.encoding = VX1SampleEncoding::float64;
+            } else if (formatTag == kFormatPcm && bitsPerSample == 16) {
+                mFormat.encoding = VX1SampleEncoding::pcm16;
+            } else if (formatTag == kFormatPcm && bitsPerSample == 24) {
+                mFormat.encoding = VX1SampleEncoding::pcm24;
+            } else if (formatTag == kFormatPcm && bitsPerSample == 32) {
+                mFormat.encoding = VX1SampleEncoding::pcm32;
+            } else {
+                fail(mPath, "unsupported sample format (tag " + std::to_string(formatTag) + ", "
+                            + std::to_string(bitsPerSample) + " bits)");
+            }
+            if (mFormat.channelCount < 1) fail(mPath, "no channels");
+            haveFormat = true;
+        } else if (std::memcmp(chunkHeader, "data", 4) == 0) {
+            if (!haveFormat) fail(mPath, "data chunk before fmt chunk");
+            const int frameBytes = mFormat.channelCount * vx1BytesPerSample(mFormat.encoding);
+            if (isRf64 && chunkSize == kUnknownSize32) {
+                mTotalFrames = (int64_t)(ds64DataSize / (uint64_t)frameBytes);
+            } else if (chunkSize == kUnknownSize32 || chunkSize == 0) {
+                mTotalFrames = -1;    // streamed WAV: read until end of file
+            } else {
+                mTotalFrames = (int64_t)(chunkSize / (uint32_t)frameBytes);
+            }
+            mFramesRemaining = mTotalFrames;
+            return;
+        } else {
+            skipBytes(mFile, mPath, (uint64_t)chunkSize + (chunkSize & 1u));
+        }
+    }
+}
+
+int VX1AudioFileReader::read(float* interleaved, int maxFrames) {
+    int frames = maxFrames;
+    if (mFramesRemaining >= 0) {
+        frames = (int)std::min<int64_t>(frames, mFramesRemaining);
+    }
+    if (frames <= 0) return 0;
+
+    const int channels = mFormat.channelCount;
+    const int sampleBytes = vx1BytesPerSample(mFormat.encoding);
+    const size_t frameBytes = (size_t)channels * (size_t)sampleBytes;
+
+    if (mFormat.encoding == VX1SampleEncoding::float32) {
+        // Little-endian float32 is the in-memory layout on every supported target
+        const size_t got = std::fread(interleaved, frameBytes, (size_t)frames, mFile);
+        if (mFramesRemaining >= 0) mFramesRemaining -= (int64_t)got;
+        return (int)got;
+    }
+
+    mBytes.resize(frameBytes * (size_t)frames);
+    const size_t got = std::fread(mBytes.data(), frameBytes, (size_t)frames, mFile);
+    const size_t samples = got * (size_t)channels;
+    const uint8_t* p = mBytes.data();
+    switch (mFormat.encoding) {
+        case VX1SampleEncoding::float64:
+            for (size_t i = 0; i < samples; ++i, p += 8) {
+                const uint64_t bits = readLE64(p);
+                double value;
+                std::memcpy(&value, &bits, sizeof value);
+                interleaved[i] = (float)value;
+            }
+            break;
+        case VX1SampleEncoding::pcm16:
+            for (size_t i = 0; i < samples; ++i, p += 2) {
+                interleaved[i] = (float)(int16_t)readLE16(p) * (1.0f / 32768.0f);
+            }
+            break;
+        case VX1SampleEncoding::pcm24:
+            for (size_t i = 0; i < samples; ++i, p += 3) {
+                const int32_t value = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+                interleaved[i] = (float)value * (1.0f / 8388608.0f);
+            }
+            break;
+        case VX1SampleEncoding::pcm32:
+            for (size_t i = 0; i < samples; ++i, p += 4) {
+                interleaved[i] = (float)((double)(int32_t)readLE32(p) * (1.0 / 2147483648.0));
+            }
+            break;
+        case VX1SampleEncoding::float32:
+            break;
+    }
+    if (mFramesRemaining >= 0) mFramesRemaining -= (int64_t)got;
+    return (int)got;
+}
+
+// MARK: - Writer
+
+VX1AudioFileWriter::VX1AudioFileWriter(const std::string& path, const VX1AudioFormat& format, bool raw)
+: mPath(path), mRaw(raw), mFormat(format) {
+    if (mRaw) {
+        mFormat.encoding = VX1SampleEncoding::float32;
+    }
+    if (mPath == "-") {
+        mFile = stdout;
+        mOwnsFile = false;
+    } else {
+        mFile = std::fopen(mPath.c_str(), "wb");
+    }
+    if (!mFile) {
+        fail(mPath, "cannot open for writing");
+    }
+    if (!mRaw) {
+        writeWavHeader();
+    }
+}
+
+VX1AudioFileWriter::~VX1AudioFileWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() explicitly to see write errors
+    }
+}
+
+void VX1AudioFileWriter::writeWavHeader() {
+    const int channels = mFormat.channelCount;
+    const int sampleBytes = vx1BytesPerSample(mFormat.encoding);
+    const bool isFloat = mFormat.encoding == VX1SampleEncoding::float32 || mFormat.encoding == VX1SampleEncoding::float64;
+    const bool extensible = channels > 2;
+    const uint32_t fmtSize = extensible ? 40 : (isFloat ? 18 : 16);
+
+    std::vector<uint8_t> header;
+    auto append = [&](const void* data, size_t bytes) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        header.insert(header.end(), p, p + bytes);
+    };
+    auto append16 = [&](uint16_t v) { uint8_t b[2]; writeLE16(b, v); append(b, 2); };
+    auto append32 = [&](uint32_t v) { uint8_t b[4]; writeLE32(b, v); append(b, 4); };
+
+    append("RIFF", 4); append32(kUnknownSize32); append("WAVE", 4);
+    // Reserved for the ds64 chunk should the file grow past 4 GB
+    append("JUNK", 4); append32(28); header.insert(header.end(), 28, 0);
+
+    append("fmt ", 4); append32(fmtSize);
+    const uint16_t formatTag = isFloat ? kFormatIeeeFloat : kFormatPcm;
+    append16(extensible ? kFormatExtensible : formatTag);
+    append16((uint16_t)channels);
+    append32((uint32_t)std::lround(mFormat.sampleRate));
+    append32((uint32_t)(std::lround(mFormat.sampleRate) * channels * sampleBytes));
+    append16((uint16_t)(channels * sampleBytes));
+    append16((uint16_t)(sampleBytes * 8));
+    if (extensible) {
+        append16(22);                              // cbSize
+        append16((uint16_t)(sampleBytes * 8));     // valid bits
+        append32(0);                               // channel mask: unspecified
+        static const uint8_t kGuidTail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00,
+                                               0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+        append16(formatTag);
+        append(kGuidTail, sizeof kGuidTail);
+    } else if (isFloat) {
+        append16(0);                               // cbSize
+    }
+
+    append("data", 4); append32(kUnknownSize32);
+
+    if (std::fwrite(header.data(), 1, header.size(), mFile) != header.size()) {
+        fail(mPath, "write failed");
+    }
+}
+
+void VX1AudioFileWriter::write(const float* interleaved, int frames) {
+    if (!mFile) fail(mPath, "write after close");
+    if (frames <= 0) return;
+
+    const size_t samples = (size_t)frames * (size_t)mFormat.channelCount;
+    size_t written = 0;
+    size_t expected = 0;
+    if (mFormat.encoding == VX1SampleEncoding::float32) {
+        written = std::fwrite(interleaved, sizeof(float), samples, mFile);
+        expected = samples;
+    } else {
+        const int sampleBytes = vx1BytesPerSample(mFormat.encoding);
+        mBytes.resize(samples * (size_t)sampleBytes);
+        uint8_t* p = mBytes.data();
+        for (size_t i = 0; i < samples; ++i, p += sampleBytes) {
+            const float x = interleaved[i];
+            switch (mFormat.encoding) {
+                case VX1SampleEncoding::float64: {
+                    const double value = x;
+                    uint64_t bits;
+                    std::memcpy(&bits, &value, sizeof bits);
+                    writeLE64(p, bits);
+                    break;
+                }
+                case VX1SampleEncoding::pcm16:
+                    writeLE16(p, (uint16_t)(int16_t)std::clamp(std::lrint((double)x * 32768.0), -32768L, 32767L));
+                    break;
+                case VX1SampleEncoding::pcm24: {
+                    const long value = std::clamp(std::lrint((double)x * 8388608.0), -8388608L, 8388607L);
+                    p[0] = (uint8_t)value; p[1] = (uint8_t)(value >> 8); p[2] = (uint8_t)(value >> 16);
+                    break;
+                }
+                case VX1SampleEncoding::pcm32:
+                    writeLE32(p, (uint32_t)(int32_t)std::clamp(std::llrint((double)x * 2147483648.0), -2147483648LL, 2147483647LL));
+                    break;
+                case VX1SampleEncoding::float32:
+                    break;
+            }
+        }
+        written = std::fwrite(mBytes.data(), 1, mBytes.size(), mFile);
+        expected = mBytes.size();
+    }
+    if (written != expected) {
+        fail(mPath, "write failed");
+    }
+    mFramesWritten += frames;
+}
+
+void VX1AudioFileWriter::patchWavHeader() {
+    const uint64_t dataBytes = (uint64_t)mFramesWritten * (uint64_t)mFormat.channelCount
+                             * (uint64_t)vx1BytesPerSample(mFormat.encoding);
+    if (dataBytes & 1u) {
+        std::fputc(0, mFile);   // RIFF chunks are word aligned
+    }
+    const long end = std::ftell(mFile);
+    if (end < 0) return;        // not seekable (stdout pipe): leave the streaming sizes
+    const uint64_t fileBytes = (uint64_t)end;
+    const long dataSizeOffset = end - (long)(dataBytes + (dataBytes & 1u)) - 4;
+
+    uint8_t b[8];
+    if (fileBytes - 8 <= kUnknownSize32 && dataBytes <= kUnknownSize32) {
+        std::fseek(mFile, kRiffSizeOffset, SEEK_SET);
+        writeLE32(b, (uint32_t)(fileBytes - 8));
+        std::fwrite(b, 1, 4, mFile);
+        std::fseek(mFile, dataSizeOffset, SEEK_SET);
+        writeLE32(b, (uint32_t)dataBytes);
+        std::fwrite(b, 1, 4, mFile);
+    } else {
+        // RF64: sizes move to the ds64 chunk that replaces the JUNK placeholder
+        std::fseek(mFile, 0, SEEK_SET);
+        std::fwrite("RF64", 1, 4, mFile);
+        std::fseek(mFile, kJunkOffset, SEEK_SET);
+        uint8_t ds64[36] = {};
+        std::memcpy(ds64, "ds64", 4);
+        writeLE32(ds64 + 4, 28);
+        writeLE64(ds64 + 8, fileBytes - 8);
+        writeLE64(ds64 + 16, dataBytes);
+        writeLE64(ds64 + 24, (uint64_t)mFramesWritten);
+        std::fwrite(ds64, 1, sizeof ds64, mFile);
+    }
+}
+
+void VX1AudioFileWriter::close() {
+    if (!mFile) return;
+    if (!mRaw) {
+        patchWavHeader();
+    }
+    const bool ok = std::fflush(mFile) == 0;
+    if (mOwnsFile) {
+        std::fclose(mFile);
+    }
+    mFile = nullptr;
+    if (!ok) {
+        fail(mPath, "write failed");
+    }
+}
@@ -0,0 +1,113 @@
+//
+//  VX1AudioFile.hpp
+//  VX1 Tools
+//
+//  Streaming WAV / raw float32 reader and writer for the offline renderers.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Sample encodings the offline tools read and write.
+enum class VX1SampleEncoding { float32, float64, pcm16, pcm24, pcm32 };
+
+struct VX1AudioFormat {
+    int channelCount = 2;
+    double sampleRate = 48000.0;
+    VX1SampleEncoding encoding = VX1SampleEncoding::float32;
+};
+
+/// Bytes per sample for an encoding.
+int vx1BytesPerSample(VX1SampleEncoding encoding);
+
+/// Parses "f32", "f64", "s16", "s24" or "s32". Throws std::runtime_error otherwise.
+VX1SampleEncoding vx1ParseSampleEncoding(const std::string& name);
+
+/// True for paths that should be treated as headerless float32 (".raw", ".f32").
+bool vx1IsRawPath(const std::string& path);
+
+/**
+ VX1AudioFileReader
+
+ Reads interleaved float frames in caller-sized chunks, so memory use does not
+ depend on the file length. Understands RIFF/WAVE (PCM 16/24/32, IEEE float
+ 32/64, WAVE_FORMAT_EXTENSIBLE) and RF64 for files over 4 GB. A raw reader takes
+ its channel count and rate from the caller. "-" reads from stdin.
+
+ All errors throw std::runtime_error with the file name in the message.
+ */
+class VX1AudioFileReader {
+public:
+    /// Opens a WAV (or RF64) file.
+    explicit VX1AudioFileReader(const std::string& path);
+    /// Opens headerless interleaved little-endian float32 with the given layout.
+    VX1AudioFileReader(const std::string& path, int channelCount, double sampleRate);
+    ~VX1AudioFileReader();
+
+    VX1AudioFileReader(const VX1AudioFileReader&) = delete;
+    VX1AudioFileReader& operator=(const VX1AudioFileReader&) = delete;
+
+    const VX1AudioFormat& format() const { return mFormat; }
+    const std::string& path() const { return mPath; }
+
+    /// Total frames, or -1 when unknown (raw or streamed input).
+    int64_t totalFrames() const { return mTotalFrames; }
+
+    /// Reads up to maxFrames interleaved frames; returns the number read (0 at end of file).
+    int read(float* interleaved, int maxFrames);
+
+private:
+    void openFile();
+    void parseWavHeader();
+
+    std::string mPath;
+    std::FILE* mFile = nullptr;
+    bool mOwnsFile = true;
+    VX1AudioFormat mFormat;
+    int64_t mTotalFrames = -1;
+    int64_t mFramesRemaining = -1;   // -1 = read to end of file
+    std::vector<uint8_t> mBytes;
+};
+
+/**
+ VX1AudioFileWriter
+
+ Writes interleaved float frames as WAV or raw float32. The WAV header is written
+ up front with a JUNK chunk reserved for an RF64 ds64 chunk, and patched in close():
+ plain RIFF below 4 GB of data, RF64 above. "-" writes to stdout (sizes left at
+ the streaming maximum because stdout cannot seek). Integer encodings are
+ rounded and clipped.
+ */
+class VX1AudioFileWriter {
+public:
+    VX1AudioFileWriter(const std::string& path, const VX1AudioFormat& format, bool raw);
+    ~VX1AudioFileWriter();
+
+    VX1AudioFileWriter(const VX1AudioFileWriter&) = delete;
+    VX1AudioFileWriter& operator=(const VX1AudioFileWriter&) = delete;
+
+    const VX1AudioFormat& format() const { return mFormat; }
+    const std::string& path() const { return mPath; }
+    int64_t framesWritten() const { return mFramesWritten; }
+
+    void write(const float* interleaved, int frames);
+
+    /// Finalizes the header and closes the file. Called by the destructor if needed.
+    void close();
+
+private:
+    void writeWavHeader();
+    void patchWavHeader();
+
+    std::string mPath;
+    std::FILE* mFile = nullptr;
+    bool mOwnsFile = true;
+    bool mRaw = false;
+    VX1AudioFormat mFormat;
+    int64_t mFramesWritten = 0;
+    std::vector<uint8_t> mBytes;
+};
@@ -0,0 +1,296 @@
+//
+//  VX1BatchRenderer.cpp
+//  VX1 Tools
+//
+//  Renders many files in parallel, one VX1StreamRenderer (kernel) per file.
+//
+
+#include "VX1BatchRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "VX1BoundedQueue.hpp"
+#include "VX1WorkStealingPool.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct InputChunk {
+    std::vector<float> samples;
+    int frames = 0;
+};
+
+/// Everything one file's render task shares with the two I/O threads.
+struct FileState {
+    FileState(size_t readAheadChunks, size_t writeBehindChunks)
+    : filled(readAheadChunks), freeInput(readAheadChunks), freeOutput(writeBehindChunks) {}
+
+    VX1BatchFileResult result;
+    std::unique_ptr<VX1AudioFileReader> reader;
+    std::unique_ptr<VX1AudioFileWriter> writer;
+    VX1BoundedQueue<InputChunk> filled;                 // reader → render; closed at end of input
+    VX1BoundedQueue<std::vector<float>> freeInput;      // render → reader
+    VX1BoundedQueue<std::vector<float>> freeOutput;     // writer → render
+    std::string readError;                              // set before `filled` is closed
+    Clock::time_point start;
+};
+
+struct WriteItem {
+    FileState* file = nullptr;
+    std::vector<float> samples;
+    int frames = 0;
+    bool last = false;
+    std::string error;      // last item only: why rendering stopped early
+};
+
+/**
+ Services every file that is currently being rendered, one chunk per file per
+ round, whenever that file has a free input buffer. Sleeps when no file does.
+ */
+class ReadAheadThread {
+public:
+    explicit ReadAheadThread(int chunkFrames) : mChunkFrames(chunkFrames), mThread([this] { run(); }) {}
+
+    ~ReadAheadThread() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_one();
+        mThread.join();
+    }
+
+    void add(FileState* file) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPending.push_back(file);
+            ++mGeneration;
+        }
+        mWake.notify_one();
+    }
+
+    /// Call after returning a buffer to a file's freeInput queue.
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mGeneration;
+        }
+        mWake.notify_one();
+    }
+
+private:
+    void run() {
+        std::vector<FileState*> active;
+        uint64_t seen = 0;
+        bool progress = false;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                if (!progress) {
+                    mWake.wait(lock, [&] { return mStopping || mGeneration != seen; });
+                }
+                if (mStopping) return;
+                seen = mGeneration;
+                active.insert(active.end(), mPending.begin(), mPending.end());
+                mPending.clear();
+            }
+
+            progress = false;
+            for (auto it = active.begin(); it != active.end();) {
+                FileState& file = **it;
+                std::optional<std::vector<float>> buffer = file.freeInput.tryPop();
+                if (!buffer) {
+                    ++it;
+                    continue;
+                }
+                progress = true;
+
+                int frames = 0;
+                try {
+                    frames = file.reader->read(buffer->data(), mChunkFrames);
+                } catch (const std::exception& e) {
+                    file.readError = e.what();
+                }
+                if (frames > 0) {
+                    file.filled.push(InputChunk { std::move(*buffer), frames });   // never blocks: one slot per buffer
+                    ++it;
+                } else {
+                    file.filled.close();
+                    it = active.erase(it);
+                }
+            }
+        }
+    }
+
+    const int mChunkFrames;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::vector<FileState*> mPending;
+    uint64_t mGeneration = 0;
+    bool mStopping = false;
+    std::thread mThread;
+};
+
+void closeFile(FileState& file) {
+    try {
+        if (file.writer && file.result.error.empty()) {
+            file.writer->close();
+        }
+    } catch (const std::exception& e) {
+        file.result.error = e.what();
+    }
+    file.writer.reset();
+    while (file.freeOutput.tryPop()) {}
+
+    file.result.stats.wallSeconds = std::chrono::duration<double>(Clock::now() - file.start).count();
+    file.result.succeeded = file.result.error.empty();
+}
+
+}
+
+VX1BatchRenderer::VX1BatchRenderer(const VX1RenderSettings& settings, const VX1RenderOptions& renderOptions,
+                                   const VX1BatchOptions& batchOptions)
+: mSettings(settings), mRenderOptions(renderOptions), mBatchOptions(batchOptions) {
+    if (mRenderOptions.blockFrames < 1 || mRenderOptions.chunkFrames < 1) {
+        throw std::runtime_error("block size and chunk size must be positive");
+    }
+    if (mBatchOptions.readAheadChunks < 1 || mBatchOptions.writeBehindChunks < 1) {
+        throw std::runtime_error("read-ahead and write-behind must be at least one chunk");
+    }
+    mSettings.finalize();
+}
+
+std::vector<VX1BatchFileResult> VX1BatchRenderer::render(const std::vector<VX1BatchJob>& jobs, VX1BatchStats* stats) {
+    const auto batchStart = Clock::now();
+
+    std::vector<std::unique_ptr<FileState>> files;
+    files.reserve(jobs.size());
+    for (const VX1BatchJob& job : jobs) {
+        files.push_back(std::make_unique<FileState>(mBatchOptions.readAheadChunks, mBatchOptions.writeBehindChunks));
+        files.back()->result.job = job;
+    }
+
+    // Longest first, using the input size as a proxy for length
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::vector<uintmax_t> sizes(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        std::error_code error;
+        const uintmax_t size = std::filesystem::file_size(jobs[i].inputPath, error);
+        sizes[i] = error ? 0 : size;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    {
+        VX1WorkStealingPool pool(mBatchOptions.threadCount);
+        ReadAheadThread readAhead(mRenderOptions.chunkFrames);
+        VX1BoundedQueue<WriteItem> writeQueue((size_t)pool.threadCount() * (size_t)(mBatchOptions.writeBehindChunks + 1));
+
+        std::thread writerThread([&] {
+            while (std::optional<WriteItem> item = writeQueue.pop()) {
+                FileState& file = *item->file;
+                if (item->frames > 0 && file.result.error.empty()) {
+                    try {
+                        file.writer->write(item->samples.data(), item->frames);
+                    } catch (const std::exception& e) {
+                        file.result.error = e.what();
+                    }
+                }
+                if (item->last) {
+                    if (file.result.error.empty()) file.result.error = std::move(item->error);
+                    closeFile(file);
+                    if (mFileFinished) mFileFinished(file.result);
+                } else {
+                    file.freeOutput.push(std::move(item->samples));
+                }
+            }
+        });
+
+        for (size_t index : order) {
+            FileState* file = files[index].get();
+            pool.submit([this, file, &readAhead, &writeQueue] {
+                file->start = Clock::now();
+                VX1RenderStats& fileStats = file->result.stats;
+                std::string error;
+                try {
+                    const VX1BatchJob& job = file->result.job;
+                    file->reader = mBatchOptions.rawInputChannels > 0
+                        ? std::make_unique<VX1AudioFileReader>(job.inputPath, mBatchOptions.rawInputChannels,
+                                                               mBatchOptions.rawInputSampleRate)
+                        : std::make_unique<VX1AudioFileReader>(job.inputPath);
+                    VX1AudioFormat format = file->reader->format();
+                    format.encoding = mBatchOptions.outputEncoding;
+                    file->writer = std::make_unique<VX1AudioFileWriter>(job.outputPath, format,
+                                                                        mBatchOptions.rawOutput || vx1IsRawPath(job.outputPath));
+
+                    VX1StreamRenderer renderer(mSettings, mRenderOptions);
+                    renderer.prepare(format.channelCount, format.sampleRate);
+
+                    const size_t chunkSamples = (size_t)mRenderOptions.chunkFrames * (size_t)format.channelCount;
+                    for (int i = 0; i < mBatchOptions.readAheadChunks; ++i) {
+                        file->freeInput.push(std::vector<float>(chunkSamples));
+                    }
+                    for (int i = 0; i < mBatchOptions.writeBehindChunks; ++i) {
+                        file->freeOutput.push(std::vector<float>(chunkSamples));
+                    }
+                    readAhead.add(file);
+
+                    while (std::optional<InputChunk> chunk = file->filled.pop()) {
+                        std::vector<float> output = std::move(*file->freeOutput.pop());
+                        const int frames = renderer.process(chunk->samples.data(), output.data(), chunk->frames);
+                        fileStats.frames += chunk->frames;
+                        file->freeInput.push(std::move(chunk->samples));
+                        readAhead.wake();
+                        writeQueue.push(WriteItem { file, std::move(output), frames, false, {} });
+                    }
+                    // The reader has dropped the file once `filled` is closed
+                    while (file->freeInput.tryPop()) {}
+                    file->reader.reset();
+                    if (!file->readError.empty()) {
+                        throw std::runtime_error(file->readError);
+                    }
+
+                    for (;;) {
+                        std::vector<float> output = std::move(*file->freeOutput.pop());
+                        const int frames = renderer.flush(output.data(), mRenderOptions.chunkFrames);
+                        if (frames == 0) break;
+                        writeQueue.push(WriteItem { file, std::move(output), frames, false, {} });
+                    }
+                    fileStats.audioSeconds = (double)fileStats.frames / format.sampleRate;
+                } catch (const std::exception& e) {
+                    error = e.what();
+                }
+                writeQueue.push(WriteItem { file, {}, 0, true, std::move(error) });
+            });
+        }
+
+        pool.wait();
+        writeQueue.close();
+        writerThread.join();
+    }
+
+    std::vector<VX1BatchFileResult> results;
+    results.reserve(files.size());
+    VX1BatchStats batch;
+    for (const std::unique_ptr<FileState>& file : files) {
+        ++batch.fileCount;
+        if (file->result.succeeded) {
+            batch.audioSeconds += file->result.stats.audioSeconds;
+        } else {
+            ++batch.failedCount;
+        }
+        results.push_back(std::move(file->result));
+    }
+    batch.wallSeconds = std::chrono::duration<double>(Clock::now() - batchStart).count();
+    if (stats) *stats = batch;
+    return results;
+}
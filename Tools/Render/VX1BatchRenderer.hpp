@@ -0,0 +1,88 @@
+//
+//  VX1BatchRenderer.hpp
+//  VX1 Tools
+//
+//  Renders many files in parallel, one VX1StreamRenderer (kernel) per file.
+//
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "VX1AudioFile.hpp"
+#include "VX1RenderSettings.hpp"
+#include "VX1StreamRenderer.hpp"
+
+struct VX1BatchJob {
+    std::string inputPath;
+    std::string outputPath;
+};
+
+struct VX1BatchOptions {
+    int threadCount = 0;            // render threads; ≤ 0 = hardware concurrency
+    int readAheadChunks = 4;        // decoded input chunks buffered per file
+    int writeBehindChunks = 4;      // rendered chunks queued for the writer per file
+    int rawInputChannels = 0;       // > 0: every input is raw float32 with this layout
+    double rawInputSampleRate = 0.0;
+    bool rawOutput = false;
+    VX1SampleEncoding outputEncoding = VX1SampleEncoding::float32;
+};
+
+struct VX1BatchFileResult {
+    VX1BatchJob job;
+    VX1RenderStats stats;           // wallSeconds runs from render start to the output being closed
+    bool succeeded = false;
+    std::string error;
+};
+
+struct VX1BatchStats {
+    int fileCount = 0;
+    int failedCount = 0;
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+
+    /// Aggregate seconds of audio rendered per second of wall time.
+    double realtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+};
+
+/**
+ VX1BatchRenderer
+
+ Every file is one task on a VX1WorkStealingPool sized to the machine, and owns
+ its own kernel, so render threads share no DSP state. Files are submitted
+ longest-first so the stragglers at the end of a batch are short ones.
+
+ Disk I/O runs on two dedicated threads so a render thread never waits on a
+ read() or write() syscall:
+ - the reader keeps up to readAheadChunks decoded chunks queued for every file
+   that is being rendered, recycling a fixed set of buffers per file;
+ - the writer drains rendered chunks into the output files. Each file has
+   writeBehindChunks output buffers; a render thread only blocks when all of
+   them are still waiting to be written, which is what bounds memory.
+
+ Per file that is at most (readAheadChunks + writeBehindChunks) chunks in
+ flight, only while the file is being rendered. A failing file (unreadable
+ input, unwritable output) is reported in its result and does not stop the
+ batch.
+ */
+class VX1BatchRenderer {
+public:
+    VX1BatchRenderer(const VX1RenderSettings& settings, const VX1RenderOptions& renderOptions,
+                     const VX1BatchOptions& batchOptions);
+
+    /// Called on the writer thread as each file completes (in completion order).
+    void setFileFinishedCallback(std::function<void(const VX1BatchFileResult&)> callback) {
+        mFileFinished = std::move(callback);
+    }
+
+    /// Renders every job; results are returned in job order.
+    std::vector<VX1BatchFileResult> render(const std::vector<VX1BatchJob>& jobs, VX1BatchStats* stats = nullptr);
+
+private:
+    VX1RenderSettings mSettings;
+    VX1RenderOptions mRenderOptions;
+    VX1BatchOptions mBatchOptions;
+    std::function<void(const VX1BatchFileResult&)> mFileFinished;
+};
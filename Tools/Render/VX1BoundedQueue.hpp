@@ -0,0 +1,82 @@
+//
+//  VX1BoundedQueue.hpp
+//  VX1 Tools
+//
+//  Blocking FIFO with a fixed capacity, for the batch renderer's I/O pipeline.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ VX1BoundedQueue
+
+ push() blocks while the queue is full and pop() while it is empty, which is what
+ bounds read-ahead and write-behind memory. close() wakes every waiter: pushes
+ are then dropped and pop() drains what is left before returning std::nullopt.
+ */
+template <typename T>
+class VX1BoundedQueue {
+public:
+    explicit VX1BoundedQueue(size_t capacity) : mCapacity(capacity > 0 ? capacity : 1) {}
+
+    /// Blocks until there is room. Returns false if the queue was closed.
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotFull.wait(lock, [&] { return mClosed || mItems.size() < mCapacity; });
+        if (mClosed) return false;
+        mItems.push_back(std::move(value));
+        mNotEmpty.notify_one();
+        return true;
+    }
+
+    /// Non-blocking push. Returns false if full or closed (value is left untouched).
+    bool tryPush(T& value) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed || mItems.size() >= mCapacity) return false;
+        mItems.push_back(std::move(value));
+        mNotEmpty.notify_one();
+        return true;
+    }
+
+    /// Blocks until an item is available; std::nullopt once closed and drained.
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mNotEmpty.wait(lock, [&] { return mClosed || !mItems.empty(); });
+        return takeFront();
+    }
+
+    /// Non-blocking pop.
+    std::optional<T> tryPop() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return takeFront();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        mNotEmpty.notify_all();
+        mNotFull.notify_all();
+    }
+
+    size_t capacity() const { return mCapacity; }
+
+private:
+    std::optional<T> takeFront() {
+        if (mItems.empty()) return std::nullopt;
+        T value = std::move(mItems.front());
+        mItems.pop_front();
+        mNotFull.notify_one();
+        return value;
+    }
+
+    const size_t mCapacity;
+    std::mutex mMutex;
+    std::condition_variable mNotEmpty, mNotFull;
+    std::deque<T> mItems;
+    bool mClosed = false;
+};
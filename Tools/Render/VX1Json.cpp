@@ -0,0 +1,161 @@
+//
+//  VX1Json.cpp
+//  VX1 Tools
+//
+//  Minimal JSON reader for render presets.
+//
+
+#include "VX1Json.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+class Parser {
+public:
+    explicit Parser(const std::string& text) : mText(text) {}
+
+    VX1JsonValue parseDocument() {
+        VX1JsonValue value = parseValue();
+        skipWhitespace();
+        if (mPosition != mText.size()) error("trailing characters after JSON value");
+        return value;
+    }
+
+private:
+    [[noreturn]] void error(const std::string& message) const {
+        int line = 1;
+        for (size_t i = 0; i < mPosition && i < mText.size(); ++i) {
+            if (mText[i] == '\n') ++line;
+        }
+        throw std::runtime_error("JSON line " + std::to_string(line) + ": " + message);
+    }
+
+    void skipWhitespace() {
+        while (mPosition < mText.size() && (mText[mPosition] == ' ' || mText[mPosition] == '\t'
+                                            || mText[mPosition] == '\n' || mText[mPosition] == '\r')) {
+            ++mPosition;
+        }
+    }
+
+    char peek() {
+        skipWhitespace();
+        if (mPosition >= mText.size()) error("unexpected end of input");
+        return mText[mPosition];
+    }
+
+    void expect(char c) {
+        if (peek() != c) error(std::string("expected '") + c + "'");
+        ++mPosition;
+    }
+
+    bool consumeLiteral(const char* literal) {
+        const std::string word(literal);
+        if (mText.compare(mPosition, word.size(), word) == 0) {
+            mPosition += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    VX1JsonValue parseValue() {
+        VX1JsonValue value;
+        const char c = peek();
+        if (c == '{') {
+            value.type = VX1JsonValue::Type::object;
+            ++mPosition;
+            if (peek() == '}') { ++mPosition; return value; }
+            for (;;) {
+                if (peek() != '"') error("expected a string key");
+                std::string key = parseString();
+                expect(':');
+                value.object[key] = parseValue();
+                if (peek() == ',') { ++mPosition; continue; }
+                expect('}');
+                return value;
+            }
+        }
+        if (c == '[') {
+            value.type = VX1JsonValue::Type::array;
+            ++mPosition;
+            if (peek() == ']') { ++mPosition; return value; }
+            for (;;) {
+                value.array.push_back(parseValue());
+                if (peek() == ',') { ++mPosition; continue; }
+                expect(']');
+                return value;
+            }
+        }
+        if (c == '"') {
+            value.type = VX1JsonValue::Type::string;
+            value.string = parseString();
+            return value;
+        }
+        if (consumeLiteral("true"))  { value.type = VX1JsonValue::Type::boolean; value.boolean = true;  return value; }
+        if (consumeLiteral("false")) { value.type = VX1JsonValue::Type::boolean; value.boolean = false; return value; }
+        if (consumeLiteral("null"))  { return value; }
+
+        const char* start = mText.c_str() + mPosition;
+        char* end = nullptr;
+        value.number = std::strtod(start, &end);
+        if (end == start) error("unexpected character");
+        value.type = VX1JsonValue::Type::number;
+        mPosition += (size_t)(end - start);
+        return value;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string result;
+        while (mPosition < mText.size()) {
+            const char c = mText[mPosition++];
+            if (c == '"') return result;
+            if (c != '\\') { result += c; continue; }
+            if (mPosition >= mText.size()) break;
+            const char escape = mText[mPosition++];
+            switch (escape) {
+                case 'n': result += '\n'; break;
+                case 't': result += '\t'; break;
+                case 'r': result += '\r'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'u': {
+                    // Presets only need ASCII; anything else is kept as '?'
+                    if (mPosition + 4 > mText.size()) error("truncated \\u escape");
+                    const long code = std::strtol(mText.substr(mPosition, 4).c_str(), nullptr, 16);
+                    result += code < 0x80 ? (char)code : '?';
+                    mPosition += 4;
+                    break;
+                }
+                default: result += escape; break;
+            }
+        }
+        error("unterminated string");
+    }
+
+    const std::string& mText;
+    size_t mPosition = 0;
+};
+
+}
+
+VX1JsonValue vx1ParseJson(const std::string& text) {
+    return Parser(text).parseDocument();
+}
+
+VX1JsonValue vx1ParseJsonFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error(path + ": cannot open");
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    try {
+        return vx1ParseJson(buffer.str());
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  VX1Json.hpp
+//  VX1 Tools
+//
+//  Minimal JSON reader for render presets.
+//
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ VX1JsonValue
+
+ Just enough JSON for preset files: objects, arrays, numbers, strings, booleans
+ and null. Numbers are doubles (sample positions up to 2^53 stay exact).
+ vx1ParseJson() throws std::runtime_error with the line number on malformed input.
+ */
+struct VX1JsonValue {
+    enum class Type { null, boolean, number, string, array, object };
+
+    Type type = Type::null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<VX1JsonValue> array;
+    std::map<std::string, VX1JsonValue> object;
+
+    bool isNumber() const { return type == Type::number; }
+    bool isArray() const  { return type == Type::array; }
+    bool isObject() const { return type == Type::object; }
+
+    /// Member lookup on an object; nullptr if absent or not an object.
+    const VX1JsonValue* find(const std::string& key) const {
+        if (type != Type::object) return nullptr;
+        const auto it = object.find(key);
+        return it == object.end() ? nullptr : &it->second;
+    }
+};
+
+VX1JsonValue vx1ParseJson(const std::string& text);
+
+/// Reads and parses a whole file. Throws std::runtime_error on I/O or syntax errors.
+VX1JsonValue vx1ParseJsonFile(const std::string& path);
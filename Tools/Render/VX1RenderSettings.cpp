@@ -0,0 +1,171 @@
+//
+//  VX1RenderSettings.cpp
+//  VX1 Tools
+//
+//  Parameter table, presets and automation lanes for offline rendering.
+//
+
+#include "VX1RenderSettings.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+#include "VX1ExtensionParameterAddresses.h"
+#include "VX1Json.hpp"
+
+namespace {
+
+// Keep in sync with VX1ExtensionParameterSpecs (Parameters.swift). The read-only
+// gainReductionMeter is not a render setting and is left out.
+constexpr VX1ParameterInfo kParameters[] = {
+    { "compress",      VX1ExtensionParameterAddress::compress,        0.0f, 100.0f,  30.0f },
+    { "speed",         VX1ExtensionParameterAddress::speed,           0.1f, 200.0f,  10.0f },
+    { "makeupGain",    VX1ExtensionParameterAddress::makeupGain,    -20.0f,  50.0f,   0.0f },
+    { "bypass",        VX1ExtensionParameterAddress::bypass,          0.0f,   1.0f,   0.0f },
+    { "mix",           VX1ExtensionParameterAddress::mix,             0.0f, 100.0f, 100.0f },
+    { "grip",          VX1ExtensionParameterAddress::grip,            0.0f, 100.0f,   0.0f },
+    { "bite",          VX1ExtensionParameterAddress::bite,            0.0f, 100.0f,  25.0f },
+    { "stack",         VX1ExtensionParameterAddress::stack,           0.0f, 100.0f,   0.0f },
+    { "gateThreshold", VX1ExtensionParameterAddress::gateThreshold, -80.0f, -20.0f, -80.0f },
+    { "oversampling",  VX1ExtensionParameterAddress::oversampling,    0.0f,   3.0f,   0.0f },
+    { "sidechainLink", VX1ExtensionParameterAddress::sidechainLink,   0.0f,   3.0f,   0.0f },
+    { "limiter",       VX1ExtensionParameterAddress::limiter,         0.0f,   1.0f,   0.0f },
+    { "limiterCeiling", VX1ExtensionParameterAddress::limiterCeiling, -12.0f,  0.0f,  -1.0f },
+    { "tube",          VX1ExtensionParameterAddress::tube,            0.0f,   3.0f,   0.0f },
+    { "multiband",     VX1ExtensionParameterAddress::multiband,       0.0f,   3.0f,   0.0f },
+    { "crossoverLow",  VX1ExtensionParameterAddress::crossoverLow,   40.0f, 1000.0f, 200.0f },
+    { "crossoverMid",  VX1ExtensionParameterAddress::crossoverMid,  300.0f, 5000.0f, 1500.0f },
+    { "crossoverHigh", VX1ExtensionParameterAddress::crossoverHigh, 1000.0f, 16000.0f, 5000.0f },
+    { "sidechainSource", VX1ExtensionParameterAddress::sidechainSource, 0.0f, 2.0f, 0.0f },
+    { "sidechainRate", VX1ExtensionParameterAddress::sidechainRate,   0.0f,   1.0f,   0.0f },
+};
+
+const VX1ParameterInfo& requireParameter(std::string_view name) {
+    const VX1ParameterInfo* info = vx1FindParameter(name);
+    if (!info) {
+        throw std::runtime_error("unknown parameter '" + std::string(name) + "' (see --list-parameters)");
+    }
+    return *info;
+}
+
+AUValue clampToRange(const VX1ParameterInfo& info, AUValue value) {
+    if (!std::isfinite(value)) {
+        throw std::runtime_error(std::string("non-finite value for ") + info.identifier);
+    }
+    return std::clamp(value, info.minValue, info.maxValue);
+}
+
+template <typename T>
+T parseNumber(std::string_view text, std::string_view context) {
+    T value {};
+    const char* begin = text.data();
+    const char* end = text.data() + text.size();
+    const auto result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc() || result.ptr != end) {
+        throw std::runtime_error("bad number '" + std::string(text) + "' in '" + std::string(context) + "'");
+    }
+    return value;
+}
+
+AUEventSampleTime sampleTimeFromJson(const VX1JsonValue& value, std::string_view name) {
+    if (!value.isNumber() || value.number < 0.0 || value.number != std::floor(value.number)) {
+        throw std::runtime_error("automation for '" + std::string(name) + "': sample times and ramps must be non-negative integers");
+    }
+    return (AUEventSampleTime)value.number;
+}
+
+}
+
+std::span<const VX1ParameterInfo> vx1Parameters() {
+    return kParameters;
+}
+
+const VX1ParameterInfo* vx1FindParameter(std::string_view name) {
+    for (const VX1ParameterInfo& info : kParameters) {
+        if (name == info.identifier) return &info;
+    }
+    AUParameterAddress address = 0;
+    const auto result = std::from_chars(name.data(), name.data() + name.size(), address);
+    if (result.ec == std::errc() && result.ptr == name.data() + name.size()) {
+        for (const VX1ParameterInfo& info : kParameters) {
+            if (info.address == address) return &info;
+        }
+    }
+    return nullptr;
+}
+
+void VX1RenderSettings::setParameter(std::string_view name, AUValue value) {
+    const VX1ParameterInfo& info = requireParameter(name);
+    parameters[info.address] = clampToRange(info, value);
+}
+
+void VX1RenderSettings::addAutomationPoint(std::string_view name, AUEventSampleTime sampleTime, AUValue value,
+                                           AUAudioFrameCount rampFrames) {
+    const VX1ParameterInfo& info = requireParameter(name);
+    if (sampleTime < 0) {
+        throw std::runtime_error("automation for '" + std::string(name) + "': negative sample time");
+    }
+    automation.push_back({ sampleTime, info.address, clampToRange(info, value), rampFrames });
+}
+
+void VX1RenderSettings::loadPreset(const std::string& path) {
+    const VX1JsonValue root = vx1ParseJsonFile(path);
+    if (!root.isObject()) {
+        throw std::runtime_error(path + ": preset must be a JSON object");
+    }
+
+    if (const VX1JsonValue* values = root.find("parameters")) {
+        if (!values->isObject()) throw std::runtime_error(path + ": \"parameters\" must be an object");
+        for (const auto& [name, value] : values->object) {
+            if (!value.isNumber()) throw std::runtime_error(path + ": parameter '" + name + "' must be a number");
+            setParameter(name, (AUValue)value.number);
+        }
+    }
+
+    if (const VX1JsonValue* lanes = root.find("automation")) {
+        if (!lanes->isObject()) throw std::runtime_error(path + ": \"automation\" must be an object of lanes");
+        for (const auto& [name, lane] : lanes->object) {
+            if (!lane.isArray()) throw std::runtime_error(path + ": lane '" + name + "' must be an array of [sample, value]");
+            for (const VX1JsonValue& point : lane.array) {
+                if (!point.isArray() || point.array.size() < 2 || point.array.size() > 3 || !point.array[1].isNumber()) {
+                    throw std::runtime_error(path + ": lane '" + name + "' points must be [sample, value] or [sample, value, rampFrames]");
+                }
+                const AUAudioFrameCount rampFrames = point.array.size() == 3
+                    ? (AUAudioFrameCount)sampleTimeFromJson(point.array[2], name) : 0;
+                addAutomationPoint(name, sampleTimeFromJson(point.array[0], name), (AUValue)point.array[1].number, rampFrames);
+            }
+        }
+    }
+}
+
+void VX1RenderSettings::parseParameterArgument(std::string_view argument) {
+    const size_t equals = argument.find('=');
+    if (equals == std::string_view::npos) {
+        throw std::runtime_error("expected name=value, got '" + std::string(argument) + "'");
+    }
+    setParameter(argument.substr(0, equals), parseNumber<float>(argument.substr(equals + 1), argument));
+}
+
+void VX1RenderSettings::parseAutomationArgument(std::string_view argument) {
+    const size_t at = argument.find('@');
+    const size_t equals = argument.find('=');
+    if (at == std::string_view::npos || equals == std::string_view::npos || equals < at) {
+        throw std::runtime_error("expected name@sample=value[/rampFrames], got '" + std::string(argument) + "'");
+    }
+    std::string_view value = argument.substr(equals + 1);
+    AUAudioFrameCount rampFrames = 0;
+    if (const size_t slash = value.find('/'); slash != std::string_view::npos) {
+        rampFrames = parseNumber<AUAudioFrameCount>(value.substr(slash + 1), argument);
+        value = value.substr(0, slash);
+    }
+    addAutomationPoint(argument.substr(0, at),
+                       parseNumber<AUEventSampleTime>(argument.substr(at + 1, equals - at - 1), argument),
+                       parseNumber<float>(value, argument), rampFrames);
+}
+
+void VX1RenderSettings::finalize() {
+    std::stable_sort(automation.begin(), automation.end(),
+                     [](const VX1ParameterEvent& a, const VX1ParameterEvent& b) { return a.sampleTime < b.sampleTime; });
+}
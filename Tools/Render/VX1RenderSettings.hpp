@@ -0,0 +1,79 @@
+//
+//  VX1RenderSettings.hpp
+//  VX1 Tools
+//
+//  Parameter table, presets and automation lanes for offline rendering.
+//
+
+#pragma once
+
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "VX1ExtensionDSPTypes.h"
+
+/// One writable VX1 parameter, mirroring VX1ExtensionParameterSpecs in Parameters.swift.
+struct VX1ParameterInfo {
+    const char* identifier;
+    AUParameterAddress address;
+    AUValue minValue;
+    AUValue maxValue;
+    AUValue defaultValue;
+};
+
+/// Every writable parameter, in address order.
+std::span<const VX1ParameterInfo> vx1Parameters();
+
+/// Looks a parameter up by identifier ("bite") or numeric address ("9"); nullptr if unknown.
+const VX1ParameterInfo* vx1FindParameter(std::string_view name);
+
+/// A parameter change at an absolute sample position, as the AU delivers AURenderEventParameter
+/// (rampFrames is AUParameterEvent::rampDurationSampleFrames; 0 = step).
+struct VX1ParameterEvent {
+    AUEventSampleTime sampleTime;
+    AUParameterAddress address;
+    AUValue value;
+    AUAudioFrameCount rampFrames = 0;
+};
+
+/**
+ VX1RenderSettings
+
+ Initial parameter values plus automation for one render. Sources are merged in
+ call order, so command-line values given after a preset override it:
+
+   preset JSON  { "parameters": { "compress": 45, "bite": 60 },
+                  "automation": { "bite": [[0, 25], [96000, 80]],
+                                  "mix":  [[48000, 40, 4800]] } }
+   --set        bite=60
+   --automate   bite@96000=80   or   mix@48000=40/4800
+
+ Automation points are changes at exact sample positions (the value holds until
+ the next point), applied with VX1ExtensionDSPKernel::handleParameterEvent. An
+ optional third element / "/frames" suffix is the ramp duration in samples,
+ exactly like an AU ramp event; without it the kernel's de-zipper ramp applies.
+ Values are clamped to each parameter's range. Errors throw std::runtime_error.
+ */
+struct VX1RenderSettings {
+    std::map<AUParameterAddress, AUValue> parameters;
+    std::vector<VX1ParameterEvent> automation;   // sorted by sampleTime after finalize()
+
+    void setParameter(std::string_view name, AUValue value);
+    void addAutomationPoint(std::string_view name, AUEventSampleTime sampleTime, AUValue value,
+                            AUAudioFrameCount rampFrames = 0);
+
+    /// Merges a JSON preset file.
+    void loadPreset(const std::string& path);
+
+    /// Parses "name=value".
+    void parseParameterArgument(std::string_view argument);
+
+    /// Parses "name@sample=value" or "name@sample=value/rampFrames".
+    void parseAutomationArgument(std::string_view argument);
+
+    /// Stable-sorts automation by time; events at the same sample keep their order.
+    void finalize();
+};
@@ -0,0 +1,202 @@
+//
+//  VX1StreamRenderer.cpp
+//  VX1 Tools
+//
+//  Chunked, constant-memory offline rendering through VX1ExtensionDSPKernel.
+//
+
+#include "VX1StreamRenderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "VX1AudioFile.hpp"
+
+VX1StreamRenderer::VX1StreamRenderer(const VX1RenderSettings& settings, const VX1RenderOptions& options)
+: mSettings(settings), mOptions(options) {
+    if (mOptions.blockFrames < 1 || mOptions.chunkFrames < 1) {
+        throw std::runtime_error("block size and chunk size must be positive");
+    }
+    mSettings.finalize();
+}
+
+void VX1StreamRenderer::setTelemetrySink(TelemetrySink sink) {
+    mTelemetrySink = std::move(sink);
+    mKernel.setTelemetryEnabled((bool)mTelemetrySink);
+}
+
+void VX1StreamRenderer::prepare(int channelCount, double sampleRate, int sidechainChannelCount) {
+    if (channelCount < 1 || channelCount > VX1ExtensionDSPKernel::kMaxChannels) {
+        throw std::runtime_error("unsupported channel count " + std::to_string(channelCount) + " (1–"
+                                 + std::to_string(VX1ExtensionDSPKernel::kMaxChannels) + ")");
+    }
+    if (sidechainChannelCount < 0 || sidechainChannelCount > VX1ExtensionDSPKernel::kMaxChannels) {
+        throw std::runtime_error("unsupported sidechain channel count " + std::to_string(sidechainChannelCount));
+    }
+    mChannelCount = channelCount;
+    mSidechainChannelCount = sidechainChannelCount;
+
+    // Defaults first, exactly like setupParameterTree() does in the AU
+    for (const VX1ParameterInfo& info : vx1Parameters()) {
+        mKernel.setParameter(info.address, info.defaultValue);
+    }
+    for (const auto& [address, value] : mSettings.parameters) {
+        mKernel.setParameter(address, value);
+    }
+    mKernel.setProcessingEngine(mOptions.engine);
+    mKernel.setDetectorPrecision(mOptions.detectorPrecision);
+    mKernel.setMaximumFramesToRender((AUAudioFrameCount)mOptions.blockFrames);
+    mKernel.setMinimumSegmentFrames((AUAudioFrameCount)mOptions.minSegmentFrames);
+    mKernel.initialize(channelCount, channelCount, sampleRate);
+
+    mInput.assign(channelCount, std::vector<float>(mOptions.chunkFrames, 0.0f));
+    mOutput.assign(channelCount, std::vector<float>(mOptions.chunkFrames, 0.0f));
+    mSidechain.assign(sidechainChannelCount, std::vector<float>(mOptions.chunkFrames, 0.0f));
+    mInputPointers.assign(channelCount, nullptr);
+    mSidechainPointers.assign(sidechainChannelCount, nullptr);
+    mOutputPointers.assign(channelCount, nullptr);
+
+    mNow = 0;
+    mNextEvent = 0;
+    mLatencySamples = mKernel.latencySamples();
+    mFramesToTrim = mOptions.compensateLatency ? mLatencySamples : 0;
+    mTailRemaining = mFramesToTrim;
+}
+
+int VX1StreamRenderer::process(const float* interleavedInput, float* interleavedOutput, int frameCount,
+                               const float* interleavedSidechain) {
+    frameCount = std::min(frameCount, mOptions.chunkFrames);
+    for (int channel = 0; channel < mChannelCount; ++channel) {
+        float* planar = mInput[channel].data();
+        for (int i = 0; i < frameCount; ++i) {
+            planar[i] = interleavedInput[(size_t)i * mChannelCount + channel];
+        }
+    }
+    for (int channel = 0; channel < mSidechainChannelCount; ++channel) {
+        float* planar = mSidechain[channel].data();
+        for (int i = 0; i < frameCount; ++i) {
+            planar[i] = interleavedSidechain ? interleavedSidechain[(size_t)i * mSidechainChannelCount + channel] : 0.0f;
+        }
+    }
+    renderPlanar(frameCount);
+    return emit(interleavedOutput, frameCount);
+}
+
+int VX1StreamRenderer::flush(float* interleavedOutput, int maxFrames) {
+    const int frameCount = (int)std::min<int64_t>({ mTailRemaining, (int64_t)maxFrames, (int64_t)mOptions.chunkFrames });
+    if (frameCount <= 0) return 0;
+    for (std::vector<float>& planar : mInput) {
+        std::fill_n(planar.begin(), frameCount, 0.0f);
+    }
+    for (std::vector<float>& planar : mSidechain) {
+        std::fill_n(planar.begin(), frameCount, 0.0f);
+    }
+    renderPlanar(frameCount);
+    mTailRemaining -= frameCount;
+    return emit(interleavedOutput, frameCount);
+}
+
+void VX1StreamRenderer::renderPlanar(int frameCount) {
+    const std::vector<VX1ParameterEvent>& events = mSettings.automation;
+    int offset = 0;
+    while (offset < frameCount) {
+        const int blockFrames = std::min(frameCount - offset, mOptions.blockFrames);
+
+        // Collect this block's events (late ones at frame 0); if the timeline fills up,
+        // render the frames before the event that did not fit and start a new range
+        int rangeStart = 0;
+        auto renderRange = [&](int rangeEnd) {
+            for (int channel = 0; channel < mChannelCount; ++channel) {
+                mInputPointers[channel] = mInput[channel].data() + offset + rangeStart;
+                mOutputPointers[channel] = mOutput[channel].data() + offset + rangeStart;
+            }
+            for (int channel = 0; channel < mSidechainChannelCount; ++channel) {
+                mSidechainPointers[channel] = mSidechain[channel].data() + offset + rangeStart;
+            }
+            mKernel.process(mInputPointers, mSidechainPointers, mOutputPointers, mNow + rangeStart,
+                            (AUAudioFrameCount)(rangeEnd - rangeStart), mTimeline);
+            mTimeline.clear();
+            rangeStart = rangeEnd;
+        };
+        mTimeline.clear();
+        while (mNextEvent < events.size() && events[mNextEvent].sampleTime < mNow + blockFrames) {
+            const VX1ParameterEvent& event = events[mNextEvent++];
+            const int eventOffset = std::max(rangeStart, (int)std::max<AUEventSampleTime>(event.sampleTime - mNow, 0));
+            if (mTimeline.full()) renderRange(eventOffset);
+            if (!mTimeline.push((AUAudioFrameCount)(eventOffset - rangeStart), event.address, event.value, event.rampFrames)) {
+                throw std::runtime_error("parameter timeline has no room for an event");
+            }
+        }
+        renderRange(blockFrames);
+
+        if (mTelemetrySink) {
+            VX1TelemetryFrame frame;
+            while (mKernel.popTelemetry(frame)) mTelemetrySink(frame);
+        }
+
+        offset += blockFrames;
+        mNow += blockFrames;
+    }
+}
+
+int VX1StreamRenderer::emit(float* interleavedOutput, int frameCount) {
+    const int skip = (int)std::min<int64_t>(mFramesToTrim, frameCount);
+    mFramesToTrim -= skip;
+    const int outFrames = frameCount - skip;
+    for (int channel = 0; channel < mChannelCount; ++channel) {
+        const float* planar = mOutput[channel].data() + skip;
+        for (int i = 0; i < outFrames; ++i) {
+            interleavedOutput[(size_t)i * mChannelCount + channel] = planar[i];
+        }
+    }
+    return outFrames;
+}
+
+VX1RenderStats vx1RenderFile(VX1AudioFileReader& reader, VX1AudioFileWriter& writer,
+                             const VX1RenderSettings& settings, const VX1RenderOptions& options,
+                             const VX1StreamRenderer::TelemetrySink& telemetry, VX1AudioFileReader* sidechain) {
+    const auto start = std::chrono::steady_clock::now();
+    const VX1AudioFormat& format = reader.format();
+    const int sidechainChannels = sidechain ? sidechain->format().channelCount : 0;
+    if (sidechain && sidechain->format().sampleRate != format.sampleRate) {
+        throw std::runtime_error(sidechain->path() + ": sidechain sample rate differs from the input's");
+    }
+
+    VX1StreamRenderer renderer(settings, options);
+    if (telemetry) renderer.setTelemetrySink(telemetry);
+    renderer.prepare(format.channelCount, format.sampleRate, sidechainChannels);
+
+    const size_t chunkSamples = (size_t)options.chunkFrames * (size_t)format.channelCount;
+    std::vector<float> input(chunkSamples), output(chunkSamples);
+    std::vector<float> key((size_t)options.chunkFrames * (size_t)sidechainChannels);
+
+    VX1RenderStats stats;
+    for (;;) {
+        const int frames = reader.read(input.data(), options.chunkFrames);
+        if (frames == 0) break;
+        if (sidechain) {
+            // Read the key up to the same length; anything it is short of stays silent
+            int keyFrames = 0;
+            while (keyFrames < frames) {
+                const int read = sidechain->read(key.data() + (size_t)keyFrames * sidechainChannels, frames - keyFrames);
+                if (read == 0) break;
+                keyFrames += read;
+            }
+            std::fill(key.begin() + (ptrdiff_t)keyFrames * sidechainChannels, key.end(), 0.0f);
+        }
+        writer.write(output.data(), renderer.process(input.data(), output.data(), frames,
+                                                     sidechain ? key.data() : nullptr));
+        stats.frames += frames;
+    }
+    while (const int frames = renderer.flush(output.data(), options.chunkFrames)) {
+        writer.write(output.data(), frames);
+    }
+    writer.close();
+
+    stats.perf = renderer.kernel().perfSnapshot();
+    stats.audioSeconds = (double)stats.frames / format.sampleRate;
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
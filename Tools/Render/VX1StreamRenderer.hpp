@@ -0,0 +1,120 @@
+//
+//  VX1StreamRenderer.hpp
+//  VX1 Tools
+//
+//  Chunked, constant-memory offline rendering through VX1ExtensionDSPKernel.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+#include "VX1RenderSettings.hpp"
+
+class VX1AudioFileReader;
+class VX1AudioFileWriter;
+
+struct VX1RenderOptions {
+    int blockFrames = 512;          // kernel block size (maximumFramesToRender)
+    int chunkFrames = 65536;        // frames per file read/write
+    int minSegmentFrames = (int)VX1ExtensionDSPKernel::kDefaultMinSegmentFrames;  // see setMinimumSegmentFrames()
+    bool compensateLatency = true;  // trim the kernel latency so output lines up with input
+    VX1ExtensionDSPKernel::Engine engine = VX1ExtensionDSPKernel::Engine::block;
+    VX1ExtensionDSPKernel::DetectorPrecision detectorPrecision = VX1ExtensionDSPKernel::DetectorPrecision::single;
+};
+
+struct VX1RenderStats {
+    int64_t frames = 0;
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+    VX1PerfSnapshot perf;           // kernel counters at the end (empty without VX1_PERF_COUNTERS)
+
+    /// Seconds of audio rendered per second of wall time.
+    double realtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+};
+
+/**
+ VX1StreamRenderer
+
+ Owns one kernel and renders interleaved chunks through it the same way
+ AUProcessHelper::processWithEvents does inside a host: the chunk is cut into
+ blocks of at most blockFrames, and each block goes to the kernel in one
+ process() call with its automation events in a VX1ParameterTimeline. The kernel
+ splits the block at events at least minSegmentFrames apart and folds closer ones
+ into ramps; minSegmentFrames = 1 applies every event at its exact sample.
+ Late events (before the current sample) apply at the start of the block.
+
+ With latency compensation on, the first latencySamples() output frames are
+ dropped and flush() renders the same number of frames of silence at the end,
+ so the output has exactly the input's length and alignment. The latency is
+ taken at prepare(); automating the oversampling factor mid-file is rendered
+ faithfully but not re-aligned.
+
+ All buffers are sized in prepare(); process() and flush() do not allocate.
+ */
+class VX1StreamRenderer {
+public:
+    /// Receives the kernel's telemetry, one frame per kernel buffer, in order.
+    using TelemetrySink = std::function<void(const VX1TelemetryFrame&)>;
+
+    VX1StreamRenderer(const VX1RenderSettings& settings, const VX1RenderOptions& options);
+
+    /// Turns on kernel telemetry and drains it into sink after every kernel block, so
+    /// the ring never overflows. An empty sink turns telemetry off.
+    void setTelemetrySink(TelemetrySink sink);
+
+    /// Applies the initial parameters, initializes the kernel and sizes every buffer.
+    /// sidechainChannelCount > 0 reserves an external key of that many channels.
+    void prepare(int channelCount, double sampleRate, int sidechainChannelCount = 0);
+
+    /// Renders frameCount (≤ chunkFrames) interleaved frames. Returns the number of
+    /// output frames written, which is smaller than frameCount only while latency is trimmed.
+    /// interleavedSidechain holds the same frames of the external key (null = silence);
+    /// the kernel hears it when the sidechainSource parameter is external or mix.
+    int process(const float* interleavedInput, float* interleavedOutput, int frameCount,
+                const float* interleavedSidechain = nullptr);
+
+    /// After the last process() call, renders up to maxFrames of the latency tail.
+    /// Returns the frames written; 0 once the tail is complete.
+    int flush(float* interleavedOutput, int maxFrames);
+
+    int latencySamples() const { return mLatencySamples; }
+    AUEventSampleTime sampleTime() const { return mNow; }
+    VX1ExtensionDSPKernel& kernel() { return mKernel; }
+
+private:
+    void renderPlanar(int frameCount);
+    int emit(float* interleavedOutput, int frameCount);
+
+    VX1RenderSettings mSettings;
+    VX1RenderOptions mOptions;
+    VX1ExtensionDSPKernel mKernel;
+    TelemetrySink mTelemetrySink;
+
+    int mChannelCount = 0;
+    int mSidechainChannelCount = 0;
+    std::vector<std::vector<float>> mInput;     // planar, chunkFrames per channel
+    std::vector<std::vector<float>> mSidechain;
+    std::vector<std::vector<float>> mOutput;
+    std::vector<const float*> mInputPointers;
+    std::vector<const float*> mSidechainPointers;
+    std::vector<float*> mOutputPointers;
+    VX1ParameterTimeline mTimeline;             // one block's events, reserved once
+
+    AUEventSampleTime mNow = 0;
+    size_t mNextEvent = 0;
+    int mLatencySamples = 0;
+    int64_t mFramesToTrim = 0;
+    int64_t mTailRemaining = 0;
+};
+
+/// Streams a whole file through a VX1StreamRenderer in chunkFrames pieces, passing
+/// the kernel telemetry to `telemetry` if one is given. A `sidechain` reader (same
+/// sample rate) feeds the external key; past its end the key is silent.
+VX1RenderStats vx1RenderFile(VX1AudioFileReader& reader, VX1AudioFileWriter& writer,
+                             const VX1RenderSettings& settings, const VX1RenderOptions& options,
+                             const VX1StreamRenderer::TelemetrySink& telemetry = {},
+                             VX1AudioFileReader* sidechain = nullptr);
@@ -0,0 +1,100 @@
+//
+//  VX1WorkStealingPool.cpp
+//  VX1 Tools
+//
+//  Fixed-size thread pool with per-worker deques and work stealing.
+//
+
+#include "VX1WorkStealingPool.hpp"
+
+#include <algorithm>
+
+VX1WorkStealingPool::VX1WorkStealingPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        mThreads.emplace_back([this, i] { run(i); });
+    }
+}
+
+VX1WorkStealingPool::~VX1WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        mStopping = true;
+    }
+    mWorkAvailable.notify_all();
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+}
+
+void VX1WorkStealingPool::submit(std::function<void()> task) {
+    const size_t target = mNextWorker.fetch_add(1, std::memory_order_relaxed) % mWorkers.size();
+    {
+        std::lock_guard<std::mutex> lock(mWorkers[target]->mutex);
+        mWorkers[target]->tasks.push_back(std::move(task));
+    }
+    // Count the task only once it is in a deque, so a reservation always finds one
+    {
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        ++mQueued;
+        ++mUnfinished;
+    }
+    mWorkAvailable.notify_one();
+}
+
+void VX1WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mStateMutex);
+    mAllDone.wait(lock, [&] { return mUnfinished == 0; });
+}
+
+bool VX1WorkStealingPool::takeTask(int index, std::function<void()>& task) {
+    // Own deque in submission order
+    {
+        Worker& own = *mWorkers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // Steal the most recently submitted task from the next non-empty deque
+    const int workerCount = (int)mWorkers.size();
+    for (int k = 1; k < workerCount; ++k) {
+        Worker& victim = *mWorkers[(index + k) % workerCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void VX1WorkStealingPool::run(int index) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mStateMutex);
+            mWorkAvailable.wait(lock, [&] { return mStopping || mQueued > 0; });
+            if (mQueued == 0) return;   // stopping and nothing left
+            --mQueued;                  // reserve one task; it is guaranteed to be in some deque
+        }
+
+        std::function<void()> task;
+        while (!takeTask(index, task)) {
+            std::this_thread::yield();
+        }
+        task();
+
+        std::lock_guard<std::mutex> lock(mStateMutex);
+        if (--mUnfinished == 0) {
+            mAllDone.notify_all();
+        }
+    }
+}
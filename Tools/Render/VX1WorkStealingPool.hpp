@@ -0,0 +1,66 @@
+//
+//  VX1WorkStealingPool.hpp
+//  VX1 Tools
+//
+//  Fixed-size thread pool with per-worker deques and work stealing.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ VX1WorkStealingPool
+
+ Every worker owns a deque and submit() deals tasks round-robin across them.
+ A worker runs its own tasks in submission order and, when its deque is empty,
+ steals from the back of the others, so a batch submitted longest-first keeps
+ the long jobs at the front and the short ones left over at the end are what
+ gets redistributed. With one render job per file this evens out uneven file
+ lengths without a single contended queue.
+
+ Tasks must not throw; wrap them if they can.
+ */
+class VX1WorkStealingPool {
+public:
+    /// threadCount ≤ 0 uses std::thread::hardware_concurrency().
+    explicit VX1WorkStealingPool(int threadCount = 0);
+    ~VX1WorkStealingPool();
+
+    VX1WorkStealingPool(const VX1WorkStealingPool&) = delete;
+    VX1WorkStealingPool& operator=(const VX1WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    /// Blocks until every submitted task has finished.
+    void wait();
+
+    int threadCount() const { return (int)mThreads.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void run(int index);
+    bool takeTask(int index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::thread> mThreads;
+    std::atomic<unsigned> mNextWorker { 0 };
+
+    std::mutex mStateMutex;
+    std::condition_variable mWorkAvailable;
+    std::condition_variable mAllDone;
+    size_t mQueued = 0;       // submitted, not yet taken
+    size_t mUnfinished = 0;   // submitted, not yet completed
+    bool mStopping = false;
+};
@@ -0,0 +1,370 @@
+//
+//  main.cpp
+//  vx1-render
+//
+//  Headless renderer: streams a WAV or raw float32 file through the VX1 kernel.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VX1AudioFile.hpp"
+#include "VX1BatchRenderer.hpp"
+#include "VX1RenderSettings.hpp"
+#include "VX1StreamRenderer.hpp"
+
+namespace {
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: vx1-render [options] <input> <output>\n"
+        "       vx1-render --batch --output-dir DIR [options] <input>...\n"
+        "\n"
+        "Input is WAV/RF64 (PCM 16/24/32 or float 32/64) or raw interleaved float32;\n"
+        "\"-\" reads stdin / writes stdout. Paths ending in .raw or .f32 are raw.\n"
+        "Batch mode renders every input to DIR/<file name> in parallel, one kernel per file.\n"
+        "\n"
+        "options:\n"
+        "  --preset FILE            JSON preset: {\"parameters\": {...}, \"automation\": {...}}\n"
+        "  --set NAME=VALUE         set a parameter (repeatable, applied after --preset)\n"
+        "  --automate NAME@SAMPLE=VALUE[/FRAMES]\n"
+        "                           move the parameter to VALUE at SAMPLE, ramping over FRAMES\n"
+        "                           samples if given (repeatable)\n"
+        "  --block-size N           kernel block size in frames (default 512)\n"
+        "  --min-segment N          shortest split between automation events; closer events\n"
+        "                           are folded into ramps (default 32, 1 = sample-exact steps)\n"
+        "  --chunk-frames N         frames per file read/write (default 65536)\n"
+        "  --raw-in CHANNELS:RATE   treat the input as raw float32 with this layout\n"
+        "  --sidechain FILE         external key for sidechainSource external/mix (WAV, or\n"
+        "                           raw float32 in the --raw-in layout); silent past its end\n"
+        "  --raw-out                write raw float32 regardless of the extension\n"
+        "  --format f32|f64|s16|s24|s32\n"
+        "                           WAV output sample format (default f32)\n"
+        "  --engine block|scalar    processing engine (default block)\n"
+        "  --detector-precision single|double\n"
+        "                           linked detector arithmetic: float or double\n"
+        "                           (default single)\n"
+        "  --no-latency-compensation\n"
+        "                           keep the kernel latency at the start of the output\n"
+        "  --telemetry FILE         write the kernel's per-buffer telemetry (levels, GR per\n"
+        "                           pass, overshoot, gate) to FILE as CSV\n"
+        "  --perf                   print the kernel's performance counters and block-time\n"
+        "                           histogram after rendering (needs -DVX1_PERF_COUNTERS=ON)\n"
+        "  --list-parameters        print parameter names, ranges and defaults\n"
+        "  --quiet                  no summary on stderr\n"
+        "\n"
+        "batch options:\n"
+        "  --batch                  render many files; every positional argument is an input\n"
+        "  --output-dir DIR         where batch outputs are written (created if missing)\n"
+        "  --file-list FILE         read more inputs from FILE, one path per line\n"
+        "  --threads N              render threads (default: one per core)\n"
+        "  --read-ahead N           input chunks buffered ahead per file (default 4)\n"
+        "  --write-behind N         output chunks queued for writing per file (default 4)\n");
+}
+
+void listParameters() {
+    std::printf("%-14s %8s %8s %8s %8s\n", "name", "address", "min", "max", "default");
+    for (const VX1ParameterInfo& info : vx1Parameters()) {
+        std::printf("%-14s %8llu %8.1f %8.1f %8.1f\n", info.identifier, (unsigned long long)info.address,
+                    info.minValue, info.maxValue, info.defaultValue);
+    }
+}
+
+int parsePositive(const char* text, const char* option) {
+    char* end = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value < 1 || value > (1 << 24)) {
+        throw std::runtime_error(std::string(option) + " expects a positive integer");
+    }
+    return (int)value;
+}
+
+/// CSV logger for --telemetry: one row per kernel buffer.
+class TelemetryCsv {
+public:
+    explicit TelemetryCsv(const std::string& path) : mFile(path) {
+        if (!mFile) throw std::runtime_error(path + ": cannot open for writing");
+        mFile << "sample,frames,input_peak_db,input_rms_db,output_peak_db,output_rms_db,"
+                 "gr_db,pass1_gr_db,pass2_gr_db,overshoot_db,gate_gain,gate_open,bypassed\n";
+    }
+
+    void write(const VX1TelemetryFrame& frame) {
+        char row[256];
+        std::snprintf(row, sizeof(row), "%lld,%u,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f,%.4f,%d,%d\n",
+                      (long long)frame.sampleTime, (unsigned)frame.frameCount, frame.inputPeakDb, frame.inputRmsDb,
+                      frame.outputPeakDb, frame.outputRmsDb, frame.gainReductionDb, frame.pass1GainReductionDb,
+                      frame.pass2GainReductionDb, frame.overshootDb, frame.gateGain, frame.gateOpen ? 1 : 0,
+                      frame.bypassed ? 1 : 0);
+        mFile << row;
+    }
+
+private:
+    std::ofstream mFile;
+};
+
+/// --perf: block cost, per-stage split, worst block, denormal and silence rates and histogram on stderr.
+void printPerfReport(const VX1PerfSnapshot& perf, double sampleRate) {
+    if (perf.blocks == 0) {
+        std::fprintf(stderr, "perf: no blocks recorded\n");
+        return;
+    }
+    const double ticksPerSecond = vx1::perf::ticksPerSecond();
+    const double ticksPerFrame = (double)perf.ticks / (double)perf.frames;
+    // Realtime load: seconds of CPU per second of audio
+    auto load = [&](double ticks, double frames) { return ticks * sampleRate / (frames * ticksPerSecond) * 100.0; };
+
+    std::fprintf(stderr, "perf: %llu blocks, %llu frames, stamp rate %.3f GHz\n",
+                 (unsigned long long)perf.blocks, (unsigned long long)perf.frames, ticksPerSecond * 1e-9);
+    std::fprintf(stderr, "  process       %9.1f ticks/frame  %8.1f ns/frame  %6.2f%% of realtime\n",
+                 ticksPerFrame, ticksPerFrame / ticksPerSecond * 1e9, load((double)perf.ticks, (double)perf.frames));
+    std::fprintf(stderr, "  worst block   %9llu ticks (%u frames)  %6.2f%% of realtime\n",
+                 (unsigned long long)perf.worstBlockTicks, perf.worstBlockFrames,
+                 load((double)perf.worstBlockTicks, (double)std::max(perf.worstBlockFrames, 1u)));
+    std::fprintf(stderr, "  denormal-heavy blocks %llu (%.2f%%)\n",
+                 (unsigned long long)perf.denormalBlocks, perf.denormalBlockRate() * 100.0);
+    std::fprintf(stderr, "  silent frames %llu (%.2f%%, fast path)\n",
+                 (unsigned long long)perf.silentFrames, 100.0 * (double)perf.silentFrames / (double)perf.frames);
+
+    std::fprintf(stderr, "  stages:\n");
+    for (int stage = 0; stage < VX1PerfSnapshot::kStageCount; ++stage) {
+        if (perf.stageTicks[stage] == 0) continue;
+        std::fprintf(stderr, "    %-12s %9.1f ticks/frame  %5.1f%%\n", vx1PerfStageName((VX1PerfStage)stage),
+                     (double)perf.stageTicks[stage] / (double)perf.frames,
+                     100.0 * (double)perf.stageTicks[stage] / (double)perf.ticks);
+    }
+
+    std::fprintf(stderr, "  histogram (ticks/frame, %% of realtime at %.0f Hz):\n", sampleRate);
+    const uint64_t peakCount = *std::max_element(perf.histogram.begin(), perf.histogram.end());
+    for (int bucket = 0; bucket < VX1PerfSnapshot::kHistogramBuckets; ++bucket) {
+        const uint64_t count = perf.histogram[bucket];
+        if (count == 0) continue;
+        const double low = VX1PerfSnapshot::bucketLowerBound(bucket);
+        const int bar = (int)(40 * count / peakCount);
+        std::fprintf(stderr, "    %9.1f  %6.2f%%  %-40s %llu\n", low, load(low, 1.0),
+                     std::string((size_t)std::max(bar, 1), '#').c_str(), (unsigned long long)count);
+    }
+}
+
+void appendFileList(const std::string& listPath, std::vector<std::string>& inputs) {
+    std::ifstream list(listPath);
+    if (!list) throw std::runtime_error(listPath + ": cannot open file list");
+    std::string line;
+    while (std::getline(list, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line[0] != '#') inputs.push_back(line);
+    }
+}
+
+int runBatch(const VX1RenderSettings& settings, const VX1RenderOptions& options, const VX1BatchOptions& batchOptions,
+             const std::vector<std::string>& inputs, const std::string& outputDirectory, bool quiet) {
+    if (outputDirectory.empty()) throw std::runtime_error("--batch needs --output-dir");
+    std::filesystem::create_directories(outputDirectory);
+
+    std::vector<VX1BatchJob> jobs;
+    for (const std::string& input : inputs) {
+        if (input == "-") throw std::runtime_error("--batch cannot read stdin");
+        std::filesystem::path output = std::filesystem::path(outputDirectory) / std::filesystem::path(input).filename();
+        if (batchOptions.rawOutput && !vx1IsRawPath(output.string())) output.replace_extension(".raw");
+        if (std::filesystem::exists(output) && std::filesystem::equivalent(output, input)) {
+            throw std::runtime_error(input + ": output would overwrite the input");
+        }
+        jobs.push_back({ input, output.string() });
+    }
+
+    VX1BatchRenderer renderer(settings, options, batchOptions);
+    if (!quiet) {
+        renderer.setFileFinishedCallback([](const VX1BatchFileResult& result) {
+            if (result.succeeded) {
+                std::fprintf(stderr, "%s: %.2f s in %.2f s (%.1fx realtime)\n", result.job.inputPath.c_str(),
+                             result.stats.audioSeconds, result.stats.wallSeconds, result.stats.realtimeFactor());
+            } else {
+                std::fprintf(stderr, "%s: FAILED: %s\n", result.job.inputPath.c_str(), result.error.c_str());
+            }
+        });
+    }
+
+    VX1BatchStats stats;
+    renderer.render(jobs, &stats);
+    if (!quiet) {
+        std::fprintf(stderr, "%d files (%d failed), %.1f s of audio in %.2f s (%.1fx realtime)\n",
+                     stats.fileCount, stats.failedCount, stats.audioSeconds, stats.wallSeconds, stats.realtimeFactor());
+    }
+    return stats.failedCount == 0 ? 0 : 1;
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        VX1RenderSettings settings;
+        VX1RenderOptions options;
+        VX1BatchOptions batchOptions;
+        std::vector<std::string> positional;
+        std::string outputDirectory;
+        std::string telemetryPath;
+        std::string sidechainPath;
+        bool perfReport = false;
+        bool batch = false;
+        VX1SampleEncoding outputEncoding = VX1SampleEncoding::float32;
+        bool rawIn = false, rawOut = false, quiet = false;
+        int rawChannels = 0;
+        double rawSampleRate = 0.0;
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> const char* {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " expects a value");
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--list-parameters") {
+                listParameters();
+                return 0;
+            } else if (arg == "--preset") {
+                settings.loadPreset(value());
+            } else if (arg == "--set") {
+                settings.parseParameterArgument(value());
+            } else if (arg == "--automate") {
+                settings.parseAutomationArgument(value());
+            } else if (arg == "--block-size") {
+                options.blockFrames = parsePositive(value(), "--block-size");
+            } else if (arg == "--min-segment") {
+                options.minSegmentFrames = parsePositive(value(), "--min-segment");
+            } else if (arg == "--chunk-frames") {
+                options.chunkFrames = parsePositive(value(), "--chunk-frames");
+            } else if (arg == "--raw-in") {
+                const char* layout = value();
+                if (std::sscanf(layout, "%d:%lf", &rawChannels, &rawSampleRate) != 2) {
+                    throw std::runtime_error("--raw-in expects CHANNELS:RATE, e.g. 2:48000");
+                }
+                rawIn = true;
+            } else if (arg == "--sidechain") {
+                sidechainPath = value();
+            } else if (arg == "--raw-out") {
+                rawOut = true;
+            } else if (arg == "--format") {
+                outputEncoding = vx1ParseSampleEncoding(value());
+            } else if (arg == "--engine") {
+                const std::string engine = value();
+                if (engine == "block") {
+                    options.engine = VX1ExtensionDSPKernel::Engine::block;
+                } else if (engine == "scalar") {
+                    options.engine = VX1ExtensionDSPKernel::Engine::scalar;
+                } else {
+                    throw std::runtime_error("--engine expects block or scalar");
+                }
+            } else if (arg == "--detector-precision") {
+                const std::string precision = value();
+                if (precision == "single") {
+                    options.detectorPrecision = VX1ExtensionDSPKernel::DetectorPrecision::single;
+                } else if (precision == "double") {
+                    options.detectorPrecision = VX1ExtensionDSPKernel::DetectorPrecision::double_;
+                } else {
+                    throw std::runtime_error("--detector-precision expects single or double");
+                }
+            } else if (arg == "--no-latency-compensation") {
+                options.compensateLatency = false;
+            } else if (arg == "--perf") {
+                if (!vx1::perf::kEnabled) {
+                    throw std::runtime_error("--perf needs a build with -DVX1_PERF_COUNTERS=ON");
+                }
+                perfReport = true;
+            } else if (arg == "--telemetry") {
+                telemetryPath = value();
+            } else if (arg == "--quiet") {
+                quiet = true;
+            } else if (arg == "--batch") {
+                batch = true;
+            } else if (arg == "--output-dir") {
+                outputDirectory = value();
+            } else if (arg == "--file-list") {
+                appendFileList(value(), positional);
+            } else if (arg == "--threads") {
+                batchOptions.threadCount = parsePositive(value(), "--threads");
+            } else if (arg == "--read-ahead") {
+                batchOptions.readAheadChunks = parsePositive(value(), "--read-ahead");
+            } else if (arg == "--write-behind") {
+                batchOptions.writeBehindChunks = parsePositive(value(), "--write-behind");
+            } else if (arg.size() > 1 && arg[0] == '-') {
+                throw std::runtime_error("unknown option " + arg);
+            } else {
+                positional.push_back(arg);
+            }
+        }
+
+        if (batch) {
+            if (positional.empty()) {
+                printUsage();
+                return 2;
+            }
+            if (rawIn) {
+                batchOptions.rawInputChannels = rawChannels;
+                batchOptions.rawInputSampleRate = rawSampleRate;
+            }
+            batchOptions.rawOutput = rawOut;
+            batchOptions.outputEncoding = outputEncoding;
+            if (!telemetryPath.empty()) throw std::runtime_error("--telemetry is not available with --batch");
+            if (perfReport) throw std::runtime_error("--perf is not available with --batch");
+            if (!sidechainPath.empty()) throw std::runtime_error("--sidechain is not available with --batch");
+            return runBatch(settings, options, batchOptions, positional, outputDirectory, quiet);
+        }
+        if (positional.size() != 2) {
+            printUsage();
+            return 2;
+        }
+        const std::string& inputPath = positional[0];
+        const std::string& outputPath = positional[1];
+
+        rawIn = rawIn || (vx1IsRawPath(inputPath) && rawChannels > 0);
+        if (vx1IsRawPath(inputPath) && !rawIn) {
+            throw std::runtime_error(inputPath + ": raw input needs --raw-in CHANNELS:RATE");
+        }
+        std::unique_ptr<VX1AudioFileReader> reader = rawIn
+            ? std::make_unique<VX1AudioFileReader>(inputPath, rawChannels, rawSampleRate)
+            : std::make_unique<VX1AudioFileReader>(inputPath);
+
+        std::unique_ptr<VX1AudioFileReader> sidechain;
+        if (!sidechainPath.empty()) {
+            const bool rawSidechain = vx1IsRawPath(sidechainPath);
+            if (rawSidechain && rawChannels <= 0) {
+                throw std::runtime_error(sidechainPath + ": raw sidechain needs --raw-in CHANNELS:RATE");
+            }
+            sidechain = rawSidechain
+                ? std::make_unique<VX1AudioFileReader>(sidechainPath, rawChannels, rawSampleRate)
+                : std::make_unique<VX1AudioFileReader>(sidechainPath);
+        }
+
+        VX1AudioFormat outputFormat = reader->format();
+        outputFormat.encoding = outputEncoding;
+        VX1AudioFileWriter writer(outputPath, outputFormat, rawOut || vx1IsRawPath(outputPath));
+
+        std::unique_ptr<TelemetryCsv> telemetry;
+        VX1StreamRenderer::TelemetrySink telemetrySink;
+        if (!telemetryPath.empty()) {
+            telemetry = std::make_unique<TelemetryCsv>(telemetryPath);
+            telemetrySink = [&telemetry](const VX1TelemetryFrame& frame) { telemetry->write(frame); };
+        }
+
+        const VX1RenderStats stats = vx1RenderFile(*reader, writer, settings, options, telemetrySink, sidechain.get());
+        if (!quiet) {
+            std::fprintf(stderr, "%s: %lld frames, %d ch @ %.0f Hz, %.2f s in %.2f s (%.1fx realtime)\n",
+                         inputPath.c_str(), (long long)stats.frames, outputFormat.channelCount,
+                         outputFormat.sampleRate, stats.audioSeconds, stats.wallSeconds, stats.realtimeFactor());
+        }
+        if (perfReport) printPerfReport(stats.perf, outputFormat.sampleRate);
+        return 0;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "vx1-render: %s\n", e.what());
+        return 1;
+    }
+}
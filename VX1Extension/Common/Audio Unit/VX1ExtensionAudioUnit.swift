@@ -13,6 +13,7 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 	var kernel = VX1ExtensionDSPKernel()
     var processHelper: AUProcessHelper?
     var inputBus = BufferedInputBus()
+    var sidechainBus = BufferedInputBus()   // bus 1: external key for the Sidechain Source parameter
 
 	private var outputBus: AUAudioUnitBus?
     private var _inputBusses: AUAudioUnitBusArray!
@@ -22,18 +23,22 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 		let format = AVAudioFormat(standardFormatWithSampleRate: 44_100, channels: 2)!
 		try super.init(componentDescription: componentDescription, options: options)
 		outputBus = try AUAudioUnitBus(format: format)
-        outputBus?.maximumChannelCount = 8
+        outputBus?.maximumChannelCount = 16
         
         // Create the input and output busses.
-        inputBus.initialize(format, 8);
+        inputBus.initialize(format, 16);
+        sidechainBus.initialize(format, 16);
+        sidechainBus.bus?.name = "Sidechain"
+        // Off until the host connects a key; the kernel then hears silence or the input alone
+        sidechainBus.bus?.isEnabled = false
 
         // Create the input and output bus arrays.
-        _inputBusses = AUAudioUnitBusArray(audioUnit: self, busType: AUAudioUnitBusType.input, busses: [inputBus.bus!])
+        _inputBusses = AUAudioUnitBusArray(audioUnit: self, busType: AUAudioUnitBusType.input, busses: [inputBus.bus!, sidechainBus.bus!])
         
         // Create the input and output bus arrays.
 		_outputBusses = AUAudioUnitBusArray(audioUnit: self, busType: AUAudioUnitBusType.output, busses: [outputBus!])
         
-        processHelper = AUProcessHelper(&kernel, &inputBus)
+        processHelper = AUProcessHelper(&kernel, &inputBus, &sidechainBus)
 	}
 
     public override var inputBusses: AUAudioUnitBusArray {
@@ -45,12 +50,10 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
     }
     
     public override var channelCapabilities: [NSNumber]? {
-        // Explicitly declare mono and stereo support
+        // Matching in/out pairs from mono up to 16 channels (7.1.4, 9.1.6 and friends);
+        // the kernel keeps one SoA lane per channel, see VX1ChannelState
         // Format: [inputChannels, outputChannels, inputChannels, outputChannels, ...]
-        return [
-            1, 1,  // Mono in, Mono out
-            2, 2   // Stereo in, Stereo out
-        ] as [NSNumber]
+        return (1...16).flatMap { [$0, $0] } as [NSNumber]
     }
 
     public override var  maximumFramesToRender: AUAudioFrameCount {
@@ -63,6 +66,12 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         }
     }
 
+    // Oversampled Bite and the limiter lookahead delay the output; the kernel reports the delay in samples
+    public override var latency: TimeInterval {
+        guard let sampleRate = outputBus?.format.sampleRate, sampleRate > 0 else { return 0 }
+        return TimeInterval(kernel.latencySamples()) / sampleRate
+    }
+
     // MARK: - Rendering
     public override var internalRenderBlock: AUInternalRenderBlock {
         return processHelper!.internalRenderBlock()
@@ -80,11 +89,13 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         }
 
         inputBus.allocateRenderResources(self.maximumFramesToRender);
+        sidechainBus.allocateRenderResources(self.maximumFramesToRender);
+        let sidechainChannelCount = sidechainBus.bus!.isEnabled ? sidechainBus.bus!.format.channelCount : 0
 
-		kernel.setMusicalContextBlock(self.musicalContextBlock)
+		processHelper?.setMusicalContextBlock(self.musicalContextBlock)
         kernel.initialize(Int32(inputChannelCount), Int32(outputChannelCount), outputBus!.format.sampleRate)
 
-        processHelper?.setChannelCount(inputChannelCount, outputChannelCount)
+        processHelper?.setChannelCount(inputChannelCount, outputChannelCount, sidechainChannelCount)
 
 		try super.allocateRenderResources()
 	}
@@ -96,6 +107,12 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
         super.deallocateRenderResources()
     }
 
+    // Clear the signal state (transport start, seek) and keep every buffer: never allocates
+    public override func reset() {
+        kernel.reset()
+        super.reset()
+    }
+
 	public func setupParameterTree(_ parameterTree: AUParameterTree) {
 		self.parameterTree = parameterTree
 
@@ -110,7 +127,16 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 	private func setupParameterCallbacks() {
 		// implementorValueObserver is called when a parameter changes value.
 		parameterTree?.implementorValueObserver = { [weak self] param, value -> Void in
-            self?.kernel.setParameter(param.address, value)
+            guard let self else { return }
+            if param.address == VX1ExtensionParameterAddress.oversampling.rawValue
+                || param.address == VX1ExtensionParameterAddress.limiter.rawValue {
+                // Oversampling and the limiter lookahead change the reported latency; let the host know
+                self.willChangeValue(forKey: "latency")
+                self.kernel.setParameter(param.address, value)
+                self.didChangeValue(forKey: "latency")
+            } else {
+                self.kernel.setParameter(param.address, value)
+            }
 		}
 
 		// implementorValueProvider is called when the value needs to be refreshed.
@@ -123,6 +149,10 @@ public class VX1ExtensionAudioUnit: AUAudioUnit, @unchecked Sendable
 			guard let value = valuePtr?.pointee else {
 				return "-"
 			}
+			if let valueStrings = param.valueStrings, let index = Int(exactly: value.rounded()),
+			   valueStrings.indices.contains(index) {
+				return valueStrings[index]
+			}
 			return NSString.localizedStringWithFormat("%.f", value) as String
 		}
 	}
@@ -10,6 +10,8 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import <AVFoundation/AVFoundation.h>
 
+#include <cassert>
+#include <span>
 #include <vector>
 #include "VX1ExtensionDSPKernel.hpp"
 #include "VX1ExtensionBufferedAudioBus.hpp"
@@ -18,82 +20,84 @@
 class AUProcessHelper
 {
 public:
-    AUProcessHelper(VX1ExtensionDSPKernel& kernel, BufferedInputBus& bufferedInputBus)
+    AUProcessHelper(VX1ExtensionDSPKernel& kernel, BufferedInputBus& bufferedInputBus, BufferedInputBus& sidechainBus)
     : mKernel{kernel},
-    mBufferedInputBus(bufferedInputBus)
+    mBufferedInputBus(bufferedInputBus),
+    mSidechainBus(sidechainBus)
     {
     }
     
-    void setChannelCount(UInt32 inputChannelCount, UInt32 outputChannelCount)
+    /// sidechainChannelCount is 0 while the sidechain bus is disabled.
+    void setChannelCount(UInt32 inputChannelCount, UInt32 outputChannelCount, UInt32 sidechainChannelCount = 0)
     {
         mInputBuffers.resize(inputChannelCount);
         mOutputBuffers.resize(outputChannelCount);
+        mSidechainBuffers.resize(sidechainChannelCount);
+    }
+
+    // MARK: - Musical Context
+    void setMusicalContextBlock(AUHostMusicalContextBlock contextBlock) {
+        mMusicalContextBlock = contextBlock;
     }
 
     /**
      This function handles the event list processing and rendering loop for you.
      Call it inside your internalRenderBlock.
+
+     Parameter events are collected into mTimeline at their frame offsets and the
+     kernel renders the whole buffer in one process() call, splitting it only where
+     events are at least the kernel's minimum segment apart. Late events apply at
+     frame 0. If a buffer carries more events than the timeline holds, the frames up
+     to the event that did not fit are rendered first and collection starts again.
+
+     sidechainBufferList is the key pulled from the sidechain bus this cycle, or
+     null when there is none; its buffers reach the kernel by pointer, like the input.
      */
-    void processWithEvents(AudioBufferList* inBufferList, AudioBufferList* outBufferList, AudioTimeStamp const *timestamp, AUAudioFrameCount frameCount, AURenderEvent const *events) {
+    void processWithEvents(AudioBufferList* inBufferList, AudioBufferList const* sidechainBufferList, AudioBufferList* outBufferList, AudioTimeStamp const *timestamp, AUAudioFrameCount frameCount, AURenderEvent const *events) {
 
-        AUEventSampleTime now = AUEventSampleTime(timestamp->mSampleTime);
-        AUAudioFrameCount framesRemaining = frameCount;
-        AURenderEvent const *nextEvent = events; // events is a linked list, at the beginning, the nextEvent is the first event
+        AUEventSampleTime const bufferStart = AUEventSampleTime(timestamp->mSampleTime);
+        AUAudioFrameCount rangeStart = 0;   // first frame not yet rendered
+        mTimeline.clear();
+        size_t const sidechainChannelCount = sidechainBufferList == nullptr ? 0
+            : std::min<size_t>(sidechainBufferList->mNumberBuffers, mSidechainBuffers.size());
 
-        auto callProcess = [this] (AudioBufferList* inBufferListPtr, AudioBufferList* outBufferListPtr, AUEventSampleTime now, AUAudioFrameCount frameCount, AUAudioFrameCount const frameOffset) {
-            for (int channel = 0; channel < inBufferListPtr->mNumberBuffers; ++channel) {
-                mInputBuffers[channel] = (const float*)inBufferListPtr->mBuffers[channel].mData  + frameOffset;
+        auto renderRange = [&] (AUAudioFrameCount rangeEnd) {
+            for (int channel = 0; channel < inBufferList->mNumberBuffers; ++channel) {
+                mInputBuffers[channel] = (const float*)inBufferList->mBuffers[channel].mData + rangeStart;
             }
-            
-            for (int channel = 0; channel < outBufferListPtr->mNumberBuffers; ++channel) {
-                mOutputBuffers[channel] = (float*)outBufferListPtr->mBuffers[channel].mData + frameOffset;
+            for (int channel = 0; channel < outBufferList->mNumberBuffers; ++channel) {
+                mOutputBuffers[channel] = (float*)outBufferList->mBuffers[channel].mData + rangeStart;
             }
-
-            mKernel.process(mInputBuffers, mOutputBuffers, now, frameCount);
-        };
-        
-        while (framesRemaining > 0) {
-            // If there are no more events, we can process the entire remaining segment and exit.
-            if (nextEvent == nullptr) {
-                AUAudioFrameCount const frameOffset = frameCount - framesRemaining;
-                callProcess(inBufferList, outBufferList, now, framesRemaining, frameOffset);
-                return;
+            for (int channel = 0; channel < sidechainChannelCount; ++channel) {
+                mSidechainBuffers[channel] = (const float*)sidechainBufferList->mBuffers[channel].mData + rangeStart;
             }
+            mKernel.process(mInputBuffers, std::span<float const*>(mSidechainBuffers.data(), sidechainChannelCount),
+                            mOutputBuffers, bufferStart + AUEventSampleTime(rangeStart), rangeEnd - rangeStart, mTimeline);
+            mTimeline.clear();
+            rangeStart = rangeEnd;
+        };
 
-            // **** start late events late.
-            auto timeZero = AUEventSampleTime(0);
-            auto headEventTime = nextEvent->head.eventSampleTime;
-            AUAudioFrameCount framesThisSegment = AUAudioFrameCount(std::max(timeZero, headEventTime - now));
-
-            // Compute everything before the next event.
-            if (framesThisSegment > 0) {
-                AUAudioFrameCount const frameOffset = frameCount - framesRemaining;
-
-                callProcess(inBufferList, outBufferList, now, framesThisSegment, frameOffset);
-
-                // Advance frames.
-                framesRemaining -= framesThisSegment;
-
-                // Advance time.
-                now += AUEventSampleTime(framesThisSegment);
+        for (AURenderEvent const *event = events; event != nullptr; event = event->head.next) {
+            if (event->head.eventType != AURenderEventParameter && event->head.eventType != AURenderEventParameterRamp) {
+                continue;
             }
+            // Late events apply at frame 0
+            AUEventSampleTime const eventOffset = std::max(AUEventSampleTime(0), event->head.eventSampleTime - bufferStart);
+            AUAudioFrameCount const frameOffset = std::max(rangeStart, AUAudioFrameCount(std::min(eventOffset, AUEventSampleTime(frameCount))));
 
-            nextEvent = performAllSimultaneousEvents(now, nextEvent);
+            if (mTimeline.full()) {
+                renderRange(frameOffset);
+            }
+            AUParameterEvent const& parameterEvent = event->parameter;
+            // Just emptied if it was full, so the event always fits
+            bool const pushed = mTimeline.push(frameOffset - rangeStart, parameterEvent.parameterAddress,
+                                               parameterEvent.value, parameterEvent.rampDurationSampleFrames);
+            assert(pushed);
+            (void)pushed;
         }
+        renderRange(frameCount);
     }
 
-    AURenderEvent const * performAllSimultaneousEvents(AUEventSampleTime now, AURenderEvent const *event) {
-        do {
-            mKernel.handleOneEvent(now, event);
-            
-            // Go to next event.
-            event = event->head.next;
-
-            // While event is not null and is simultaneous (or late).
-        } while (event && event->head.eventSampleTime <= now);
-        return event;
-    }
-    
     // Block which subclassers must provide to implement rendering.
     AUInternalRenderBlock internalRenderBlock() {
 		return ^AUAudioUnitStatus(AudioUnitRenderActionFlags 				*actionFlags,
@@ -104,6 +108,7 @@ public:
 								  const AURenderEvent        				*realtimeEventListHead,
 								  AURenderPullInputBlock __unsafe_unretained pullInputBlock) {
 		
+			uint64_t const renderStart = vx1::perf::stamp();
 			AudioUnitRenderActionFlags pullFlags = 0;
 		
 			if (frameCount > mKernel.maximumFramesToRender()) {
@@ -115,6 +120,17 @@ public:
 			if (err != 0) { return err; }
 		
 			AudioBufferList *inAudioBufferList = mBufferedInputBus.mutableAudioBufferList;
+
+			// The key is pulled in the same cycle into the sidechain bus's own buffers (or
+			// the upstream unit's, if it swaps in its pointers). An unconnected or failing
+			// sidechain is not an error: the kernel just hears no key.
+			AudioBufferList const *sidechainBufferList = nullptr;
+			if (!mSidechainBuffers.empty()) {
+				AudioUnitRenderActionFlags sidechainFlags = 0;
+				if (mSidechainBus.pullInput(&sidechainFlags, timestamp, frameCount, 1, pullInputBlock) == noErr) {
+					sidechainBufferList = mSidechainBus.mutableAudioBufferList;
+				}
+			}
 		
 			/*
 			 Important:
@@ -139,7 +155,8 @@ public:
 				}
 			}
 		
-			processWithEvents(inAudioBufferList, outAudioBufferList, timestamp, frameCount, realtimeEventListHead);
+			processWithEvents(inAudioBufferList, sidechainBufferList, outAudioBufferList, timestamp, frameCount, realtimeEventListHead);
+			mKernel.recordRenderTicks(vx1::perf::stamp() - renderStart);
 			return noErr;
 		};
 	}
@@ -147,5 +164,9 @@ private:
     VX1ExtensionDSPKernel& mKernel;
     std::vector<const float*> mInputBuffers;
     std::vector<float*> mOutputBuffers;
+    std::vector<const float*> mSidechainBuffers;   // sized in setChannelCount(), never on the render thread
+    VX1ParameterTimeline mTimeline;    // reserved once; processWithEvents() never allocates
     BufferedInputBus& mBufferedInputBus;
+    BufferedInputBus& mSidechainBus;
+    AUHostMusicalContextBlock mMusicalContextBlock;
 };
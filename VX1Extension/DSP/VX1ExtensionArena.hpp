@@ -0,0 +1,103 @@
+//
+//  VX1ExtensionArena.hpp
+//  VX1Extension
+//
+//  Cache-line aligned storage and the block engine's scratch arena.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// std::allocator with a fixed alignment (bytes), so a std::vector's data starts on a
+/// cache line and copies of it do too.
+template <typename T, size_t Alignment = 64>
+struct VX1AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = VX1AlignedAllocator<U, Alignment>;
+    };
+
+    VX1AlignedAllocator() = default;
+
+    template <typename U>
+    VX1AlignedAllocator(const VX1AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, size_t) {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const VX1AlignedAllocator<U, Alignment>&) const {
+        return true;
+    }
+};
+
+/**
+ VX1ScratchArena
+
+ One contiguous, 64-byte aligned block of floats carved into regions. The owner
+ lays the regions out (reserve() in order, then allocate()), and afterwards a
+ region is an offset, so a copied arena is a working copy with no pointers to fix
+ up. Every region starts on its own cache line: two regions never share one, and
+ SIMD loads at a region's start are aligned. The block only grows, so laying the
+ same regions out again (a new sample rate, say) costs a fill, not an allocation.
+ */
+class VX1ScratchArena {
+public:
+    static constexpr size_t kAlignment = 64;
+    static constexpr size_t kFloatsPerLine = kAlignment / sizeof(float);
+
+    struct Region {
+        size_t offset = 0;
+        size_t count = 0;
+    };
+
+    /// Starts a new layout; regions reserved before it are no longer valid.
+    void beginLayout() {
+        mLayoutSize = 0;
+    }
+
+    /// Appends a region of `count` floats to the layout.
+    Region reserve(size_t count) {
+        const Region region { mLayoutSize, count };
+        mLayoutSize += (count + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine;
+        return region;
+    }
+
+    /// Allocates the laid out regions in one block, zeroed. A layout that fits in the
+    /// block already held reuses it: only a larger layout allocates.
+    void allocate() {
+        mStorage.assign(mLayoutSize, 0.0f);
+    }
+
+    void release() {
+        mStorage = {};
+        mLayoutSize = 0;
+    }
+
+    float* data(Region region) {
+        return mStorage.data() + region.offset;
+    }
+
+    const float* data(Region region) const {
+        return mStorage.data() + region.offset;
+    }
+
+    /// Floats in the layout.
+    size_t size() const {
+        return mLayoutSize;
+    }
+
+private:
+    std::vector<float, VX1AlignedAllocator<float, kAlignment>> mStorage;
+    size_t mLayoutSize = 0;
+};
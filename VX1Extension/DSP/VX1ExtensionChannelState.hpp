@@ -0,0 +1,193 @@
+//
+//  VX1ExtensionChannelState.hpp
+//  VX1Extension
+//
+//  Per-channel recursive state in structure-of-arrays form.
+//
+
+#pragma once
+
+#include <algorithm>
+
+/**
+ VX1ChannelState
+
+ One fixed, 64-byte-aligned array per state variable with one lane per channel
+ (up to kMaxChannels). A frame's update across all channels is then a run of
+ contiguous loads and stores: the block engine loads kWidth channels' shelf
+ state into one SIMD register and runs the recursion for all of them at once,
+ and the unlinked / max-link detector loops over lanes with no per-channel
+ objects in between. Nothing here allocates, so initialize() and reset() are
+ just fills.
+
+ Bite shelves are used in every link mode; the detector lanes only by the
+ unlinked and max sidechain link modes.
+ */
+struct VX1ChannelState {
+    static constexpr int kMaxChannels = 16;
+
+    // Bite presence shelves (pre-emphasis and de-emphasis), input and output history
+    alignas(64) float preX1[kMaxChannels];
+    alignas(64) float preY1[kMaxChannels];
+    alignas(64) float deX1[kMaxChannels];
+    alignas(64) float deY1[kMaxChannels];
+
+    // Detector lanes: gate (unlinked only), sidechain HPF and RMS detection
+    alignas(64) float gateEnvelope[kMaxChannels];
+    alignas(64) float gateGain[kMaxChannels];
+    alignas(64) int   gateHoldCounter[kMaxChannels];
+    alignas(64) float hpfX1[kMaxChannels];
+    alignas(64) float hpfX2[kMaxChannels];
+    alignas(64) float hpfY1[kMaxChannels];
+    alignas(64) float hpfY2[kMaxChannels];
+    alignas(64) float rmsState[kMaxChannels];
+
+    // Detector lanes: envelope, overshoot and Stack second pass (unlinked only)
+    alignas(64) float envelopeLevel[kMaxChannels];
+    alignas(64) float prevGainReductionDb[kMaxChannels];
+    alignas(64) float overshootDb[kMaxChannels];
+    alignas(64) int   overshootHoldCounter[kMaxChannels];
+    alignas(64) float rmsState2[kMaxChannels];
+    alignas(64) float envelopeLevel2[kMaxChannels];
+    alignas(64) float prevGainReductionDb2[kMaxChannels];
+    alignas(64) float overshootDb2[kMaxChannels];
+    alignas(64) int   overshootHoldCounter2[kMaxChannels];
+
+    VX1ChannelState() {
+        resetShelves();
+        resetDetectors();
+    }
+
+    void resetShelves() {
+        std::fill_n(preX1, kMaxChannels, 0.0f);
+        std::fill_n(preY1, kMaxChannels, 0.0f);
+        std::fill_n(deX1, kMaxChannels, 0.0f);
+        std::fill_n(deY1, kMaxChannels, 0.0f);
+    }
+
+    void resetDetectors() {
+        std::fill_n(gateEnvelope, kMaxChannels, 0.0f);
+        std::fill_n(gateGain, kMaxChannels, 1.0f);
+        std::fill_n(gateHoldCounter, kMaxChannels, 0);
+        std::fill_n(hpfX1, kMaxChannels, 0.0f);
+        std::fill_n(hpfX2, kMaxChannels, 0.0f);
+        std::fill_n(hpfY1, kMaxChannels, 0.0f);
+        std::fill_n(hpfY2, kMaxChannels, 0.0f);
+        std::fill_n(rmsState, kMaxChannels, 0.0f);
+        std::fill_n(envelopeLevel, kMaxChannels, 0.0f);
+        std::fill_n(prevGainReductionDb, kMaxChannels, 0.0f);
+        std::fill_n(overshootDb, kMaxChannels, 0.0f);
+        std::fill_n(overshootHoldCounter, kMaxChannels, 0);
+        std::fill_n(rmsState2, kMaxChannels, 0.0f);
+        std::fill_n(envelopeLevel2, kMaxChannels, 0.0f);
+        std::fill_n(prevGainReductionDb2, kMaxChannels, 0.0f);
+        std::fill_n(overshootDb2, kMaxChannels, 0.0f);
+        std::fill_n(overshootHoldCounter2, kMaxChannels, 0);
+    }
+};
+
+/**
+ VX1DetectorStateT
+
+ The linked detector's per-sample working set: every coefficient and every
+ recursive value the gate → sidechain HPF → RMS/peak detector → envelope →
+ overshoot → Stack chain reads or writes once per frame, packed into two cache
+ lines (four with double State). Knob values, smoothers and everything read once
+ per block stay in the kernel's colder members, so a frame of the linked detector
+ touches these lines and the block's scratch rows and nothing else.
+
+ State is the type the coefficients and the recursion are kept in: float for the
+ default detector (VX1DetectorState), double for the kernel's double detector
+ precision and the reduced-rate detector, where the 175 ms RMS coefficient and the 80 Hz HPF poles sit
+ close enough to 1 at high rates for float rounding to show.
+ */
+template <typename State>
+struct alignas(64) VX1DetectorStateT {
+    // Coefficients, set in initialize() and on parameter changes
+    State hpfA0 = 1.0f, hpfA1 = -2.0f, hpfA2 = 1.0f;   // sidechain HPF numerator
+    State hpfB1 = 0.0f, hpfB2 = 0.0f;                  // denominator (B0 normalised to 1)
+    State rmsCoeff = 0.0f;               // exp(-1/(0.175 * sampleRate)) — ~175ms RMS window (vocal syllable averaging)
+    State attackCoeff = 0.0f;            // exp(-1/(attackMs * 0.001 * sampleRate))
+    State releaseCoeff = 0.0f;           // exp(-1/(releaseMs * 0.001 * sampleRate))
+    State instantCoeff = 0.0f;           // exp(-1/(0.002 * sampleRate)) — ~2ms peak grab (fast but distortion-safe)
+    State gateAttackCoeff = 0.0f;        // exp(-1 / (0.5ms * sr))
+    State gateReleaseCoeff = 0.0f;       // exp(-1 / (100ms * sr))
+    int   gateHoldSamples = 0;           // 50ms * sr
+    State overshootReleaseCoeff = 0.0f;  // exp(-1 / (2ms * sr))
+    int   overshootHoldSamples = 0;      // 0.5ms * sr
+
+    // Noise gate — pre-input-gain, before entire compressor chain
+    // Attack: 0.5ms (fast open), Hold: 50ms (prevents chatter), Release: 100ms (smooth close).
+    State gateEnvelope = 0.0f;           // Peak envelope follower on raw input (pre-gain)
+    State gateGain = 1.0f;               // Current gate gain scalar (0=closed, 1=open), smoothed
+    int   gateHoldCounter = 0;           // Counts down when signal drops below threshold
+
+    // Sidechain HPF history
+    State hpfX1 = 0.0f, hpfX2 = 0.0f;
+    State hpfY1 = 0.0f, hpfY2 = 0.0f;
+
+    // Detector, envelope and GR overshoot — VCA-style transient punch
+    // When a transient causes GR to jump >3 dB in one sample, over-apply 3 dB extra GR
+    // for a brief hold (0.5ms), then exponentially release back over 2ms.
+    // Replicates the physical VCA overshoot of the dbx 160 / SSL G-bus gain cell.
+    State rmsState = 0.0f;               // IIR squared-sample accumulator for RMS detection
+    State envelopeLevel = 0.0f;          // Envelope follower state
+    State prevGainReductionDb = 0.0f;    // GR from previous sample (for jump detection)
+    State overshootDb = 0.0f;            // Currently active overshoot amount (decays to 0)
+    int   overshootHoldCounter = 0;      // Counts down from overshootHoldSamples
+
+    // Stack — second-pass state (independent from pass 1)
+    State rmsState2 = 0.0f;
+    State envelopeLevel2 = 0.0f;
+    State prevGainReductionDb2 = 0.0f;
+    State overshootDb2 = 0.0f;
+    int   overshootHoldCounter2 = 0;
+
+    bool  gateOpen = true;               // Current gate state (open/closed)
+
+    /// Clears the recursive state and keeps the coefficients.
+    void resetState() {
+        gateEnvelope = 0.0f;
+        gateGain = 1.0f;
+        gateHoldCounter = 0;
+        gateOpen = true;
+        hpfX1 = hpfX2 = hpfY1 = hpfY2 = 0.0f;
+        rmsState = envelopeLevel = prevGainReductionDb = overshootDb = 0.0f;
+        overshootHoldCounter = 0;
+        rmsState2 = envelopeLevel2 = prevGainReductionDb2 = overshootDb2 = 0.0f;
+        overshootHoldCounter2 = 0;
+    }
+
+    /**
+     Takes over the recursive state of a detector kept in another type, value by value,
+     and only where it differs from this one's after conversion: a double detector
+     synced from the float copy it was last narrowed into keeps its extra bits, and
+     picks up any value something else has written to the float copy since.
+     */
+    template <typename Other>
+    void syncStateFrom(const VX1DetectorStateT<Other>& other) {
+        const auto sync = [](State& value, Other source) {
+            if ((Other)value != source) value = (State)source;
+        };
+        sync(gateEnvelope, other.gateEnvelope);
+        sync(gateGain, other.gateGain);
+        sync(hpfX1, other.hpfX1); sync(hpfX2, other.hpfX2);
+        sync(hpfY1, other.hpfY1); sync(hpfY2, other.hpfY2);
+        sync(rmsState, other.rmsState);
+        sync(envelopeLevel, other.envelopeLevel);
+        sync(prevGainReductionDb, other.prevGainReductionDb);
+        sync(overshootDb, other.overshootDb);
+        sync(rmsState2, other.rmsState2);
+        sync(envelopeLevel2, other.envelopeLevel2);
+        sync(prevGainReductionDb2, other.prevGainReductionDb2);
+        sync(overshootDb2, other.overshootDb2);
+        gateHoldCounter = other.gateHoldCounter;
+        overshootHoldCounter = other.overshootHoldCounter;
+        overshootHoldCounter2 = other.overshootHoldCounter2;
+        gateOpen = other.gateOpen;
+    }
+};
+
+using VX1DetectorState = VX1DetectorStateT<float>;
+
+static_assert(sizeof(VX1DetectorState) == 128, "VX1DetectorState should fill exactly two cache lines");
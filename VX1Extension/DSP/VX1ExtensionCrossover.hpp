@@ -0,0 +1,254 @@
+//
+//  VX1ExtensionCrossover.hpp
+//  VX1Extension
+//
+//  Linkwitz-Riley band splitting and per-band detector lanes for the multiband mode.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "VX1ExtensionDenormals.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+/**
+ VX1CrossoverState
+
+ Biquad history of one split (one audio channel, or the sidechain), one lane per
+ band: z1[s][b] / z2[s][b] are the transposed direct form II delays of section s
+ of band b. Unused sections and lanes stay at zero.
+ */
+struct VX1CrossoverState {
+    static constexpr int kMaxBands = 4;
+    static constexpr int kSections = 2 * (kMaxBands - 1);   // two biquads per crossover
+
+    alignas(16) float z1[kSections][kMaxBands];
+    alignas(16) float z2[kSections][kMaxBands];
+
+    VX1CrossoverState() {
+        reset();
+    }
+
+    void reset() {
+        std::fill_n(&z1[0][0], kSections * kMaxBands, 0.0f);
+        std::fill_n(&z2[0][0], kSections * kMaxBands, 0.0f);
+    }
+
+    /// True if every delay is within ±floor.
+    bool isSettled(float floor) const {
+        for (int s = 0; s < kSections; ++s) {
+            for (int b = 0; b < kMaxBands; ++b) {
+                if (std::abs(z1[s][b]) > floor || std::abs(z2[s][b]) > floor) return false;
+            }
+        }
+        return true;
+    }
+
+    /// Zeroes delays that have decayed below vx1::denormals::kFlushFloor.
+    void flushDecayingState() {
+        vx1::denormals::flush(&z1[0][0], kSections * kMaxBands);
+        vx1::denormals::flush(&z2[0][0], kSections * kMaxBands);
+    }
+
+    bool hasDenormals() const {
+        for (int s = 0; s < kSections; ++s) {
+            for (int b = 0; b < kMaxBands; ++b) {
+                if (std::fpclassify(z1[s][b]) == FP_SUBNORMAL || std::fpclassify(z2[s][b]) == FP_SUBNORMAL) return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ VX1Crossover
+
+ Splits a signal into 2–4 bands with 4th-order Linkwitz-Riley crossovers (two
+ cascaded 2nd-order Butterworth sections, bilinear with pre-warping, so the
+ crossover frequencies are exact at any rate). An LR4 low-pass and high-pass pair
+ sums to a 2nd-order allpass, so the bands add back up with flat magnitude.
+
+ The split is a tree, computed as one lane per band straight from the input. At
+ crossover k, lane b runs
+   the high-pass   if b > k
+   the low-pass    if b == k
+   the allpass     if b < k  (the LR4 pair's sum)
+ so with three crossovers
+
+   band 0 = LP(f0) · AP(f1) · AP(f2)
+   band 1 = HP(f0) · LP(f1) · AP(f2)
+   band 2 = HP(f0) · HP(f1) · LP(f2)
+   band 3 = HP(f0) · HP(f1) · HP(f2)
+
+ The allpasses give the lower bands the phase shift the upper bands get from
+ the crossovers above them, so every band has the same phase and the sum is an
+ allpass of the input: phase-coherent, whatever each band's gain.
+
+ Every (crossover, lane) pair is two biquads with their own coefficients (the
+ allpass is one biquad and an identity), so one step of a section advances all
+ four lanes together as one Float4. process() runs a whole block with the
+ section count fixed at compile time, so the delays stay in registers and each
+ frame is a short chain of four-wide multiply-adds. Lanes past the band count
+ have zero coefficients and output silence.
+ */
+class VX1Crossover {
+public:
+    static constexpr int kMaxBands = VX1CrossoverState::kMaxBands;
+    static constexpr int kMaxCrossovers = kMaxBands - 1;
+    static constexpr int kSections = VX1CrossoverState::kSections;
+
+    VX1Crossover() {
+        configure(44100.0, 1, nullptr);
+    }
+
+    /**
+     Sets the band count (1–4) and its bandCount − 1 crossover frequencies (Hz,
+     ascending; clamped to 20 Hz … 0.45 · sampleRate). One band is the identity in
+     lane 0. Coefficients only: the caller decides whether to clear the state.
+     */
+    void configure(double sampleRate, int bandCount, const float* crossoverHz) {
+        mBandCount = std::clamp(bandCount, 1, kMaxBands);
+        // One band still runs a section, the identity, so the unused lanes come out silent
+        mSectionCount = std::max(2 * (mBandCount - 1), 1);
+
+        for (int s = 0; s < kSections; ++s) {
+            for (int b = 0; b < kMaxBands; ++b) {
+                setSection(s, b, b < mBandCount ? Biquad::identity() : Biquad {});
+            }
+        }
+        if (mBandCount == 1) return;
+
+        float previousHz = 20.0f;
+        for (int k = 0; k < mBandCount - 1; ++k) {
+            const float hz = std::clamp(crossoverHz[k], previousHz, (float)(0.45 * sampleRate));
+            previousHz = hz;
+            const Biquad lowPass = butterworth(sampleRate, hz, false);
+            const Biquad highPass = butterworth(sampleRate, hz, true);
+            const Biquad allPass = { lowPass.a2, lowPass.a1, 1.0f, lowPass.a1, lowPass.a2 };
+            for (int b = 0; b < mBandCount; ++b) {
+                const bool passesHigh = b > k, passesLow = b == k;
+                setSection(2 * k, b, passesHigh ? highPass : passesLow ? lowPass : allPass);
+                setSection(2 * k + 1, b, passesHigh ? highPass : passesLow ? lowPass : Biquad::identity());
+            }
+        }
+    }
+
+    int bandCount() const {
+        return mBandCount;
+    }
+
+    /**
+     Splits frameCount samples of `input` into frame-major lanes: bands[4·i + b] is
+     band b of frame i (zero past bandCount()).
+     */
+    void process(const float* input, float* bands, int frameCount, VX1CrossoverState& state) const {
+        switch (mSectionCount) {
+            case 1: processSections<1>(input, bands, frameCount, state); break;
+            case 2: processSections<2>(input, bands, frameCount, state); break;
+            case 4: processSections<4>(input, bands, frameCount, state); break;
+            default: processSections<6>(input, bands, frameCount, state); break;
+        }
+    }
+
+private:
+    /// y = b0·x + b1·x₁ + b2·x₂ − a1·y₁ − a2·y₂ (a0 normalised to 1).
+    struct Biquad {
+        float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+        static Biquad identity() {
+            return { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        }
+    };
+
+    /// 2nd-order Butterworth (Q = 1/√2) low- or high-pass, K = tan(π · fc / fs).
+    static Biquad butterworth(double sampleRate, float hz, bool highPass) {
+        const double k = std::tan(M_PI * hz / sampleRate);
+        const double kk = k * k;
+        const double norm = 1.0 / (1.0 + M_SQRT2 * k + kk);
+        const double a1 = 2.0 * (kk - 1.0) * norm;
+        const double a2 = (1.0 - M_SQRT2 * k + kk) * norm;
+        if (highPass) {
+            return { (float)norm, (float)(-2.0 * norm), (float)norm, (float)a1, (float)a2 };
+        }
+        return { (float)(kk * norm), (float)(2.0 * kk * norm), (float)(kk * norm), (float)a1, (float)a2 };
+    }
+
+    template <int Sections>
+    void processSections(const float* input, float* bands, int frameCount, VX1CrossoverState& state) const {
+        using namespace vx1::simd;
+        Float4 z1[Sections], z2[Sections];
+        for (int s = 0; s < Sections; ++s) {
+            z1[s] = load4(state.z1[s]);
+            z2[s] = load4(state.z2[s]);
+        }
+        for (int i = 0; i < frameCount; ++i) {
+            Float4 x = broadcast4(input[i]);
+            for (int s = 0; s < Sections; ++s) {
+                const Coefficients& c = mSections[s];
+                const Float4 y = load4(c.b0) * x + z1[s];
+                z1[s] = load4(c.b1) * x - load4(c.a1) * y + z2[s];
+                z2[s] = load4(c.b2) * x - load4(c.a2) * y;
+                x = y;
+            }
+            store(bands + kMaxBands * i, x);
+        }
+        for (int s = 0; s < Sections; ++s) {
+            store(state.z1[s], z1[s]);
+            store(state.z2[s], z2[s]);
+        }
+    }
+
+    void setSection(int section, int band, const Biquad& biquad) {
+        Coefficients& c = mSections[section];
+        c.b0[band] = biquad.b0;
+        c.b1[band] = biquad.b1;
+        c.b2[band] = biquad.b2;
+        c.a1[band] = biquad.a1;
+        c.a2[band] = biquad.a2;
+    }
+
+    // One row of lanes per coefficient, so a section loads each as one vector
+    struct Coefficients {
+        alignas(16) float b0[kMaxBands];
+        alignas(16) float b1[kMaxBands];
+        alignas(16) float b2[kMaxBands];
+        alignas(16) float a1[kMaxBands];
+        alignas(16) float a2[kMaxBands];
+    };
+
+    Coefficients mSections[kSections] {};
+    int mBandCount = 1;
+    int mSectionCount = 0;
+};
+
+/**
+ VX1BandState
+
+ Per-band detector lanes for the multiband mode: the same RMS/peak detector,
+ envelope and VCA overshoot as the single-band path, one lane per band, so a
+ frame updates every band with Float4 arithmetic. The overshoot hold counts
+ frames as a float so it shares that arithmetic (exact far past any hold time).
+ */
+struct VX1BandState {
+    static constexpr int kMaxBands = VX1CrossoverState::kMaxBands;
+
+    alignas(16) float rmsState[kMaxBands];
+    alignas(16) float envelopeLevel[kMaxBands];
+    alignas(16) float prevGainReductionDb[kMaxBands];
+    alignas(16) float overshootDb[kMaxBands];
+    alignas(16) float overshootHoldCounter[kMaxBands];
+
+    VX1BandState() {
+        reset();
+    }
+
+    void reset() {
+        std::fill_n(rmsState, kMaxBands, 0.0f);
+        std::fill_n(envelopeLevel, kMaxBands, 0.0f);
+        std::fill_n(prevGainReductionDb, kMaxBands, 0.0f);
+        std::fill_n(overshootDb, kMaxBands, 0.0f);
+        std::fill_n(overshootHoldCounter, kMaxBands, 0.0f);
+    }
+};
@@ -0,0 +1,2522 @@
+//
+//  VX1ExtensionDSPKernel.cpp
+//  VX1Extension
+//
+//  Compressor plugin for TyAu-VX1
+//
+
+#include "VX1ExtensionDSPKernel.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+#include <array>
+#include <bit>
+#include <utility>
+
+// MARK: - Lifecycle
+
+void VX1ExtensionDSPKernel::initialize(int inputChannelCount, int outputChannelCount, double inSampleRate) {
+    assert(inputChannelCount >= 1 && inputChannelCount <= kMaxChannels);
+    assert(inSampleRate > 0.0 && inSampleRate <= kMaxSampleRate);
+    mSampleRate = inSampleRate;
+    mChannelCount = inputChannelCount;
+
+    // Initialize computed coefficients
+    mThresholdLinear = std::pow(10.0f, mParameters.thresholdDb / 20.0f);
+    mMakeupGainLinear = std::pow(10.0f, mParameters.makeupGainDb / 20.0f);
+    mDetector.attackCoeff = std::exp(-1.0f / (mParameters.attackMs * 0.001f * mSampleRate));
+    mDetector.releaseCoeff = std::exp(-1.0f / (mParameters.releaseMs * 0.001f * mSampleRate));
+    mGainComputer.setCompression(mParameters.thresholdDb, mParameters.ratio);
+    mGainComputer.setStack(mParameters.stackPercent);
+    mGainComputer.setGateThreshold(mParameters.gateThresholdDb);
+    // Whatever was set before initialize() takes effect at once; later changes ramp
+    mDezipperFrames = (int)std::lround(kDezipperSeconds * mSampleRate);
+    snapSmoothedParameters();
+    // RMS detection: ~175ms squared-sample IIR window (averages across syllables, not individual transients)
+    mDetector.rmsCoeff = std::exp(-1.0f / (0.175f * (float)mSampleRate));
+    // Peak detection: ~2ms fast attack (aggressive on vocals without distortion artifacts)
+    mDetector.instantCoeff = std::exp(-1.0f / (0.002f * (float)mSampleRate));
+
+    // GR overshoot timing (VCA punch): 0.5ms hold, 2ms exponential release
+    mDetector.overshootReleaseCoeff = std::exp(-1.0f / (0.002f * (float)mSampleRate));
+    mDetector.overshootHoldSamples  = (int)std::lround(0.0005 * mSampleRate);
+
+    // Noise gate timing: 0.5ms attack, 100ms release, 50ms hold
+    mDetector.gateAttackCoeff  = std::exp(-1.0f / (0.0005f * (float)mSampleRate));
+    mDetector.gateReleaseCoeff = std::exp(-1.0f / (0.100f  * (float)mSampleRate));
+    mDetector.gateHoldSamples  = (int)std::lround(0.050 * mSampleRate);
+
+    // Compute sidechain HPF coefficients for current sample rate
+    computeHpfCoefficients();
+
+    // Reduced-rate detector: the largest power-of-two factor that stays at or above
+    // kMinDecimatedDetectorRate, so 1 up to 176.4 kHz
+    mSidechainDecimation = 1;
+    while (mSidechainDecimation < kMaxSidechainDecimation
+           && mSampleRate / (2 * mSidechainDecimation) >= kMinDecimatedDetectorRate) {
+        mSidechainDecimation *= 2;
+    }
+    computeDoubleDetectorCoefficients();
+
+    // Multiband crossovers for this rate
+    updateCrossovers();
+
+    // Shelf and Bite coefficients (the per-channel lanes are fixed-size; reset() clears them)
+    computePresenceCoefficients();
+    updateBiteCoefficients();
+
+    // Block engine scratch — one arena laid out for kMaxChannels whatever the channel count,
+    // so re-initializing at another rate or channel count reuses it. process() never allocates.
+    const size_t scratchFrames = std::max<AUAudioFrameCount>(mMaxFramesToRender, 1);
+    const size_t channelRows = (size_t)kMaxChannels;
+    const size_t laneStride = (size_t)((kMaxChannels + vx1::simd::kWidth - 1) / vx1::simd::kWidth * vx1::simd::kWidth);
+    mScratchFrames = scratchFrames;
+    mScratch.beginLayout();
+    mScratchAbsMono = mScratch.reserve(scratchFrames);
+    mScratchMono    = mScratch.reserve(scratchFrames);
+    mScratchGate    = mScratch.reserve(scratchFrames * channelRows);
+    mScratchGain    = mScratch.reserve(scratchFrames * channelRows);
+    mScratchWet     = mScratch.reserve(scratchFrames * channelRows);
+    mScratchShaped  = mScratch.reserve(scratchFrames);
+    mScratchLanes   = mScratch.reserve(scratchFrames * laneStride);
+    mScratchDry     = mScratch.reserve(scratchFrames);
+    mScratchOversampled = mScratch.reserve(scratchFrames * VX1Oversampler::kMaxFactor);
+    mScratchRamps       = mScratch.reserve(scratchFrames * kRampRowCount);
+    mScratchBands       = mScratch.reserve(scratchFrames * VX1Crossover::kMaxBands);
+    mScratchBandGain    = mScratch.reserve(scratchFrames * VX1Crossover::kMaxBands);
+    mScratch.allocate();
+
+    // Bite oversampling — every channel sized for 8x so the factor can change while rendering.
+    // The per-channel arrays hold kMaxChannels from the first initialize() on. The dry delays
+    // are all prepared (a few dozen samples each); an oversampler's 8x buffers (~110 KB at
+    // 1024 frames) are prepared for the channels in use, and keep their storage afterwards.
+    const int maxLatency = VX1Oversampler::latencySamples(VX1Oversampler::kMaxFactor);
+    mOversamplers.resize(kMaxChannels);
+    mBiteDryDelay.resize(kMaxChannels);
+    mMixDryDelay.resize(kMaxChannels);
+    for (int channel = 0; channel < kMaxChannels; ++channel) {
+        if (channel < inputChannelCount) mOversamplers[channel].prepare((int)scratchFrames);
+        mBiteDryDelay[channel].prepare(maxLatency);
+        mMixDryDelay[channel].prepare(maxLatency);
+    }
+
+    // Output limiter — lookahead delays and gain scratch for this rate and block size
+    mLimiter.prepare(kMaxChannels, mSampleRate, (int)scratchFrames);
+    mLimiter.setCeilingDb(mParameters.limiterCeilingDb);
+    applyOversamplingFactor();
+
+    // Tube stages — DC blocker for this rate
+    forEachTubeStage([this](auto& stage) { stage.setSampleRate(mSampleRate); });
+
+    // Start from rest at the new rate
+    reset();
+}
+
+void VX1ExtensionDSPKernel::deInitialize() {
+    // Buffers stay allocated, so process() after deInitialize() is still safe (and silent
+    // state); the next initialize() reuses them
+    reset();
+}
+
+void VX1ExtensionDSPKernel::reset() {
+    const VX1RealtimeScope realtimeScope;
+
+    // Meter
+    mCurrentGainReductionDb = 0.0f;
+    mPublishedGainReductionDb.store(0.0f);
+
+    // Linked detector: gate, HPF, envelopes, overshoot and Stack second pass
+    mDetector.resetState();
+    mDetectorWide.resetState();
+    mDetectorDecimated.resetState();
+    mDecimator = {};
+    mDetectorPrecomputed = false;
+    mSilent = false;
+
+    // Per-channel lanes (sheen presence shelves, unlinked/max detectors)
+    mChannels.resetShelves();
+    mChannels.resetDetectors();
+
+    // Multiband crossovers and band detectors
+    mSidechainSplit.reset();
+    for (VX1CrossoverState& split : mBandSplits) split.reset();
+    mBands.reset();
+
+    // Oversampler filters, dry-path delays, the limiter's lookahead and gain envelope,
+    // and the tube stages' DC blockers
+    for (VX1Oversampler& oversampler : mOversamplers) oversampler.reset();
+    for (VX1DelayLine& delay : mBiteDryDelay) delay.reset();
+    for (VX1DelayLine& delay : mMixDryDelay) delay.reset();
+    mLimiter.reset();
+    forEachTubeStage([](auto& stage) { stage.reset(); });
+
+    // Finish any parameter ramp in flight
+    snapSmoothedParameters();
+}
+
+// MARK: - Parameter Getter / Setter
+
+void VX1ExtensionDSPKernel::setParameter(AUParameterAddress address, AUValue value) {
+    setParameterRamped(address, value, mDezipperFrames);
+}
+
+void VX1ExtensionDSPKernel::setParameterRamped(AUParameterAddress address, AUValue value, int rampFrames) {
+    switch (address) {
+        case VX1ExtensionParameterAddress::compress: {
+            mParameters.compressPercent = value;
+            float t = mParameters.compressPercent / 100.0f;          // 0.0 → 1.0 (linear knob position)
+            float tThresh = std::pow(t, 0.2f);             // ^(1/5) curve: threshold drops extremely fast early
+            mParameters.thresholdDb = tThresh * -50.0f;               // 0% → 0dB, 100% → -50dB
+            mParameters.ratio = 1.0f + t * 29.0f;                    // 0% → 1:1, 100% → 30:1 (linear)
+            mThresholdLinear = std::pow(10.0f, mParameters.thresholdDb / 20.0f);
+            mGainComputer.setCompression(mParameters.thresholdDb, mParameters.ratio);
+            mSmoothedThresholdDb.setTarget(mParameters.thresholdDb, rampFrames);
+            mSmoothedSlope.setTarget(1.0f - 1.0f / mParameters.ratio, rampFrames);
+            break;
+        }
+        case VX1ExtensionParameterAddress::speed:
+            mParameters.speedMs = value;
+            mParameters.attackMs = mParameters.speedMs;
+            mParameters.releaseMs = mParameters.speedMs * 3.0f;
+            mDetector.attackCoeff = std::exp(-1.0f / (mParameters.attackMs * 0.001f * mSampleRate));
+            mDetector.releaseCoeff = std::exp(-1.0f / (mParameters.releaseMs * 0.001f * mSampleRate));
+            mSmoothedAttackCoeff.setTarget(mDetector.attackCoeff, rampFrames);
+            mSmoothedReleaseCoeff.setTarget(mDetector.releaseCoeff, rampFrames);
+            computeDoubleDetectorCoefficients();
+            break;
+        case VX1ExtensionParameterAddress::makeupGain:
+            mParameters.makeupGainDb = value;
+            mMakeupGainLinear = std::pow(10.0f, mParameters.makeupGainDb / 20.0f);
+            mSmoothedMakeupGain.setTarget(mMakeupGainLinear, rampFrames);
+            break;
+        case VX1ExtensionParameterAddress::bypass:
+            mBypassed = (value >= 0.5f);
+            break;
+        case VX1ExtensionParameterAddress::mix:
+            mParameters.mixPercent = value;
+            mSmoothedMixWet.setTarget(mParameters.mixPercent / 100.0f, rampFrames);
+            break;
+        case VX1ExtensionParameterAddress::grip:
+            mParameters.gripPercent = value;
+            break;
+        case VX1ExtensionParameterAddress::bite:
+            mParameters.bitePercent = value;
+            updateBiteCoefficients();
+            break;
+        case VX1ExtensionParameterAddress::stack:
+            mParameters.stackPercent = value;
+            mGainComputer.setStack(mParameters.stackPercent);
+            break;
+        case VX1ExtensionParameterAddress::gateThreshold:
+            mParameters.gateThresholdDb = value;
+            mGainComputer.setGateThreshold(mParameters.gateThresholdDb);
+            break;
+        case VX1ExtensionParameterAddress::oversampling:
+            mOversamplingFactor = 1 << std::clamp((int)std::lround(value), 0, 3);
+            applyOversamplingFactor();
+            break;
+        case VX1ExtensionParameterAddress::sidechainLink: {
+            const auto link = (SidechainLink)std::clamp((int)std::lround(value), 0, 3);
+            // The detector lanes hold stale state from the last time they ran
+            if (link != mSidechainLink) mChannels.resetDetectors();
+            mSidechainLink = link;
+            break;
+        }
+        case VX1ExtensionParameterAddress::limiter: {
+            const bool enabled = (value >= 0.5f);
+            // Start from silence in the lookahead delays rather than audio from the last time it ran
+            if (enabled != mLimiterEnabled) mLimiter.reset();
+            mLimiterEnabled = enabled;
+            updateLatency();
+            break;
+        }
+        case VX1ExtensionParameterAddress::limiterCeiling:
+            mParameters.limiterCeilingDb = value;
+            mLimiter.setCeilingDb(mParameters.limiterCeilingDb);
+            break;
+        case VX1ExtensionParameterAddress::tube: {
+            const auto model = (VX1TubeModel)std::clamp((int)std::lround(value), 0, 3);
+            // The newly selected stage's DC blocker holds history from the last time it ran
+            if (model != mTubeModel) forEachTubeStage([](auto& stage) { stage.reset(); });
+            mTubeModel = model;
+            break;
+        }
+        case VX1ExtensionParameterAddress::multiband: {
+            const int bandCount = std::clamp((int)std::lround(value), 0, 3) + 1;
+            // The band lanes hold stale state from the last time they ran
+            if (bandCount != mBandCount) {
+                mSidechainSplit.reset();
+                for (VX1CrossoverState& split : mBandSplits) split.reset();
+                mBands.reset();
+            }
+            mBandCount = bandCount;
+            updateCrossovers();
+            break;
+        }
+        case VX1ExtensionParameterAddress::crossoverLow:
+            mParameters.crossoverLowHz = value;
+            updateCrossovers();
+            break;
+        case VX1ExtensionParameterAddress::crossoverMid:
+            mParameters.crossoverMidHz = value;
+            updateCrossovers();
+            break;
+        case VX1ExtensionParameterAddress::crossoverHigh:
+            mParameters.crossoverHighHz = value;
+            updateCrossovers();
+            break;
+        case VX1ExtensionParameterAddress::sidechainSource: {
+            const auto source = (SidechainSource)std::clamp((int)std::lround(value), 0, 2);
+            // A key takes detection off the per-channel lanes; they restart clean when it goes
+            if (source != mSidechainSource) mChannels.resetDetectors();
+            mSidechainSource = source;
+            break;
+        }
+        case VX1ExtensionParameterAddress::sidechainRate:
+            mSidechainRate = value >= 0.5f ? SidechainRate::reduced : SidechainRate::full;
+            // The next reduced-rate block restarts its interpolation from the detector state
+            mDecimator.primed = false;
+            break;
+    }
+}
+
+AUValue VX1ExtensionDSPKernel::getParameter(AUParameterAddress address) {
+    switch (address) {
+        case VX1ExtensionParameterAddress::compress:
+            return (AUValue)mParameters.compressPercent;
+        case VX1ExtensionParameterAddress::speed:
+            return (AUValue)mParameters.speedMs;
+        case VX1ExtensionParameterAddress::makeupGain:
+            return (AUValue)mParameters.makeupGainDb;
+        case VX1ExtensionParameterAddress::bypass:
+            return (AUValue)(mBypassed ? 1.0f : 0.0f);
+        case VX1ExtensionParameterAddress::mix:
+            return (AUValue)mParameters.mixPercent;
+        case VX1ExtensionParameterAddress::grip:
+            return (AUValue)mParameters.gripPercent;
+        case VX1ExtensionParameterAddress::bite:
+            return (AUValue)mParameters.bitePercent;
+        case VX1ExtensionParameterAddress::stack:
+            return (AUValue)mParameters.stackPercent;
+        case VX1ExtensionParameterAddress::gainReductionMeter:
+            return (AUValue)mPublishedGainReductionDb.load();
+        case VX1ExtensionParameterAddress::gateThreshold:
+            return (AUValue)mParameters.gateThresholdDb;
+        case VX1ExtensionParameterAddress::oversampling:
+            return (AUValue)std::countr_zero((unsigned)mOversamplingFactor);
+        case VX1ExtensionParameterAddress::sidechainLink:
+            return (AUValue)(int)mSidechainLink;
+        case VX1ExtensionParameterAddress::limiter:
+            return (AUValue)(mLimiterEnabled ? 1.0f : 0.0f);
+        case VX1ExtensionParameterAddress::limiterCeiling:
+            return (AUValue)mParameters.limiterCeilingDb;
+        case VX1ExtensionParameterAddress::tube:
+            return (AUValue)mTubeModel;
+        case VX1ExtensionParameterAddress::multiband:
+            return (AUValue)(mBandCount - 1);
+        case VX1ExtensionParameterAddress::crossoverLow:
+            return (AUValue)mParameters.crossoverLowHz;
+        case VX1ExtensionParameterAddress::crossoverMid:
+            return (AUValue)mParameters.crossoverMidHz;
+        case VX1ExtensionParameterAddress::crossoverHigh:
+            return (AUValue)mParameters.crossoverHighHz;
+        case VX1ExtensionParameterAddress::sidechainSource:
+            return (AUValue)(int)mSidechainSource;
+        case VX1ExtensionParameterAddress::sidechainRate:
+            return (AUValue)(int)mSidechainRate;
+        default:
+            return 0.f;
+    }
+}
+
+// MARK: - Parameter Smoothing
+
+void VX1ExtensionDSPKernel::snapSmoothedParameters() {
+    mSmoothedThresholdDb.snap(mParameters.thresholdDb);
+    mSmoothedSlope.snap(1.0f - 1.0f / mParameters.ratio);
+    mSmoothedAttackCoeff.snap(mDetector.attackCoeff);
+    mSmoothedReleaseCoeff.snap(mDetector.releaseCoeff);
+    mSmoothedMakeupGain.snap(mMakeupGainLinear);
+    mSmoothedMixWet.snap(mParameters.mixPercent / 100.0f);
+}
+
+bool VX1ExtensionDSPKernel::fillDetectorRamps(int frameCount) {
+    if (!mSmoothedThresholdDb.isRamping() && !mSmoothedSlope.isRamping()
+        && !mSmoothedAttackCoeff.isRamping() && !mSmoothedReleaseCoeff.isRamping()) {
+        return false;
+    }
+    mSmoothedThresholdDb.fill(rampRow(kRampThresholdDb), frameCount);
+    mSmoothedSlope.fill(rampRow(kRampSlope), frameCount);
+    mSmoothedAttackCoeff.fill(rampRow(kRampAttackCoeff), frameCount);
+    mSmoothedReleaseCoeff.fill(rampRow(kRampReleaseCoeff), frameCount);
+    return true;
+}
+
+bool VX1ExtensionDSPKernel::fillMixRamps(int frameCount) {
+    using namespace vx1::simd;
+
+    if (!mSmoothedMakeupGain.isRamping() && !mSmoothedMixWet.isRamping()) {
+        return false;
+    }
+    float* mixDry = rampRow(kRampMixDry);
+    float* wetGain = rampRow(kRampWetGain);
+    mSmoothedMixWet.fill(mixDry, frameCount);
+    mSmoothedMakeupGain.fill(wetGain, frameCount);
+
+    // mix → (1 − mix, makeup · mix), same products as the static path
+    const FloatVec one = broadcast(1.0f);
+    const int vecFrames = vectorFrames(frameCount);
+    int i = 0;
+    for (; i < vecFrames; i += kWidth) {
+        const FloatVec mixWet = load(mixDry + i);
+        store(wetGain + i, load(wetGain + i) * mixWet);
+        store(mixDry + i, one - mixWet);
+    }
+    for (; i < frameCount; ++i) {
+        const float mixWet = mixDry[i];
+        wetGain[i] = wetGain[i] * mixWet;
+        mixDry[i] = 1.0f - mixWet;
+    }
+    return true;
+}
+
+// MARK: - Sheen Saturation
+
+void VX1ExtensionDSPKernel::updateBiteCoefficients() {
+    using vx1::fastmath::kSaturationPrecision;
+
+    const float blend = mParameters.bitePercent / 100.0f;
+    mBite.blend    = blend;
+    mBite.drive    = 1.0f + blend * 4.0f;    // 1.0 at 0% → 5.0 at 100%
+    mBite.dcOffset = 0.18f * blend;          // offset grows with Bite amount
+    // Same tanh as the per-sample shaper, so silence maps to exactly zero after DC removal
+    mBite.shapedDc = vx1::fastmath::tanh<kSaturationPrecision>(mBite.dcOffset * mBite.drive * 1.3f);
+    // Cubic grit fades back at high drive (1 - blend*0.5) to avoid intermodulation
+    mBite.gritAmt  = 0.06f * blend * (1.0f - blend * 0.5f);
+    // Normalize the wet path back to unity by inverting the tanh's actual ceiling at the
+    // current drive setting, keeping perceived level consistent across the knob range.
+    mBite.compensationGain = 1.0f / vx1::fastmath::tanh<kSaturationPrecision>(mBite.drive * 1.3f);
+}
+
+// MARK: - Sheen Saturation: Oversampling
+
+void VX1ExtensionDSPKernel::applyOversamplingFactor() {
+    // Only clears state, so this is safe from a render-thread parameter event
+    const int oversamplerLatency = VX1Oversampler::latencySamples(mOversamplingFactor);
+    for (VX1Oversampler& oversampler : mOversamplers) {
+        oversampler.setFactor(mOversamplingFactor);
+    }
+    for (VX1DelayLine& delay : mBiteDryDelay) {
+        delay.setDelay(oversamplerLatency);
+        delay.reset();
+    }
+    for (VX1DelayLine& delay : mMixDryDelay) {
+        delay.setDelay(oversamplerLatency);
+        delay.reset();
+    }
+    updateLatency();
+}
+
+void VX1ExtensionDSPKernel::updateLatency() {
+    mLatencySamples = VX1Oversampler::latencySamples(mOversamplingFactor)
+                    + (mLimiterEnabled ? mLimiter.latencySamples() : 0);
+}
+
+// MARK: - Tube
+
+void VX1ExtensionDSPKernel::applyTube(std::span<float *> outputBuffers, AUAudioFrameCount frameCount) {
+    const auto channels = outputBuffers.first(std::min<size_t>(outputBuffers.size(), (size_t)mChannelCount));
+    switch (mTubeModel) {
+        case VX1TubeModel::off:
+            break;
+        case VX1TubeModel::standard:
+            mTubeStandard.process(channels, (int)frameCount);
+            break;
+        case VX1TubeModel::warm:
+            mTubeWarm.process(channels, (int)frameCount);
+            break;
+        case VX1TubeModel::aggressive:
+            mTubeAggressive.process(channels, (int)frameCount);
+            break;
+    }
+}
+
+// MARK: - Output Limiter
+
+float VX1ExtensionDSPKernel::applyLimiter(std::span<float *> outputBuffers, AUAudioFrameCount frameCount) {
+    std::array<float*, kMaxChannels> channels;
+    const size_t channelCount = std::min<size_t>(outputBuffers.size(), (size_t)mChannelCount);
+    float minGain = 1.0f;
+    // Same sub-division as the block engine: the limiter's gain scratch holds mScratchFrames
+    for (AUAudioFrameCount offset = 0; offset < frameCount; offset += (AUAudioFrameCount)mScratchFrames) {
+        const AUAudioFrameCount frames = std::min((AUAudioFrameCount)mScratchFrames, frameCount - offset);
+        for (size_t channel = 0; channel < channelCount; ++channel) {
+            channels[channel] = outputBuffers[channel] + offset;
+        }
+        minGain = std::min(minGain, mLimiter.process(std::span(channels.data(), channelCount), (int)frames));
+    }
+    return -20.0f * std::log10(minGain);
+}
+
+// MARK: - Sheen Saturation: Presence Pre/De-Emphasis
+
+void VX1ExtensionDSPKernel::computePresenceCoefficients() {
+    // Designed in double and rounded once: at high rates K is small and the float
+    // coefficients would inherit the rounding of every step
+    const double fc = 3500.0;
+    const double gainDb = 5.0;
+    const double G = std::pow(10.0, gainDb / 20.0);  // ≈ 1.778
+    // Bilinear transform pre-warped at fc, so the corner stays at 3.5 kHz at any rate
+    const double K = std::tan(M_PI * fc / mSampleRate);
+
+    // Pre-emphasis: +5 dB shelf boost above 3.5 kHz
+    mShelfB0Pre = (float)((G * K + 1.0) / (K + 1.0));
+    mShelfB1Pre = (float)((G * K - 1.0) / (K + 1.0));
+    mShelfA1Pre = (float)((K - 1.0)     / (K + 1.0));
+
+    // De-emphasis: matching -5 dB shelf cut (exact inverse)
+    mShelfB0De  = (float)((K + 1.0)     / (G * K + 1.0));
+    mShelfB1De  = (float)((K - 1.0)     / (G * K + 1.0));
+    mShelfA1De  = (float)((G * K - 1.0) / (G * K + 1.0));
+}
+
+// MARK: - Sidechain HPF
+
+void VX1ExtensionDSPKernel::computeHpfCoefficients() {
+    // The double design, rounded once: at 768 kHz cos(ω) is within a few float ulp of 1,
+    // and only the final rounding is left (80 Hz stays within 0.03 dB of -3 dB)
+    VX1DetectorStateT<double> design;
+    designDetector(design, mSampleRate);
+    mDetector.hpfA0 = (float)design.hpfA0;
+    mDetector.hpfA1 = (float)design.hpfA1;
+    mDetector.hpfA2 = (float)design.hpfA2;
+    mDetector.hpfB1 = (float)design.hpfB1;
+    mDetector.hpfB2 = (float)design.hpfB2;
+}
+
+void VX1ExtensionDSPKernel::designDetector(VX1DetectorStateT<double>& detector, double sampleRate) const {
+    detector.attackCoeff = std::exp(-1.0 / ((double)mParameters.attackMs * 0.001 * sampleRate));
+    detector.releaseCoeff = std::exp(-1.0 / ((double)mParameters.releaseMs * 0.001 * sampleRate));
+    detector.rmsCoeff = std::exp(-1.0 / (0.175 * sampleRate));
+    detector.instantCoeff = std::exp(-1.0 / (0.002 * sampleRate));
+    detector.overshootReleaseCoeff = std::exp(-1.0 / (0.002 * sampleRate));
+    detector.overshootHoldSamples = (int)std::lround(0.0005 * sampleRate);
+    detector.gateAttackCoeff = std::exp(-1.0 / (0.0005 * sampleRate));
+    detector.gateReleaseCoeff = std::exp(-1.0 / (0.100 * sampleRate));
+    detector.gateHoldSamples = (int)std::lround(0.050 * sampleRate);
+
+    // 80 Hz Butterworth high-pass (RBJ: bilinear, pre-warped at fc), Q = 1/sqrt(2) ≈ 0.7071
+    const double omega = 2.0 * M_PI * 80.0 / sampleRate;
+    const double cosOmega = std::cos(omega);
+    const double alpha = std::sin(omega) / (2.0 * 0.7071);
+    const double a0 = 1.0 + alpha;
+    detector.hpfA0 = (1.0 + cosOmega) / 2.0 / a0;
+    detector.hpfA1 = -(1.0 + cosOmega) / a0;
+    detector.hpfA2 = detector.hpfA0;
+    detector.hpfB1 = -2.0 * cosOmega / a0;
+    detector.hpfB2 = (1.0 - alpha) / a0;
+}
+
+void VX1ExtensionDSPKernel::computeDoubleDetectorCoefficients() {
+    designDetector(mDetectorWide, mSampleRate);
+    designDetector(mDetectorDecimated, mSampleRate / mSidechainDecimation);
+}
+
+// MARK: - Multiband
+
+void VX1ExtensionDSPKernel::updateCrossovers() {
+    float crossoverHz[VX1Crossover::kMaxCrossovers] = { mParameters.crossoverHighHz };
+    if (mBandCount == 3) {
+        crossoverHz[0] = mParameters.crossoverLowHz;
+        crossoverHz[1] = mParameters.crossoverHighHz;
+    } else if (mBandCount == 4) {
+        crossoverHz[0] = mParameters.crossoverLowHz;
+        crossoverHz[1] = mParameters.crossoverMidHz;
+        crossoverHz[2] = mParameters.crossoverHighHz;
+    }
+    // The knobs' ranges overlap; the bands are split in ascending order whatever their order
+    for (int i = 1; i < mBandCount - 1; ++i) {
+        for (int j = i; j > 0 && crossoverHz[j] < crossoverHz[j - 1]; --j) std::swap(crossoverHz[j], crossoverHz[j - 1]);
+    }
+    mCrossover.configure(mSampleRate, mBandCount, crossoverHz);
+}
+// MARK: - Internal Process
+
+namespace {
+
+/// Peak and RMS level (dBFS) across every channel of a buffer, for telemetry.
+void measureLevels(const float* const* buffers, size_t channelCount, int frameCount, float& peakDb, float& rmsDb) {
+    using namespace vx1::simd;
+
+    FloatVec peak = broadcast(0.0f);
+    double sumSquares = 0.0;
+    float tailPeak = 0.0f;
+    const int vecFrames = vectorFrames(frameCount);
+    for (size_t channel = 0; channel < channelCount; ++channel) {
+        const float* buffer = buffers[channel];
+        FloatVec squares = broadcast(0.0f);
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            const FloatVec x = load(buffer + i);
+            peak = max(peak, abs(x));
+            squares = squares + x * x;
+        }
+        alignas(64) float lanes[kWidth];
+        store(lanes, squares);
+        for (int k = 0; k < kWidth; ++k) sumSquares += lanes[k];
+        for (; i < frameCount; ++i) {
+            tailPeak = std::max(tailPeak, std::abs(buffer[i]));
+            sumSquares += (double)buffer[i] * buffer[i];
+        }
+    }
+    alignas(64) float lanes[kWidth];
+    store(lanes, peak);
+    for (int k = 0; k < kWidth; ++k) tailPeak = std::max(tailPeak, lanes[k]);
+
+    const double meanSquare = sumSquares / ((double)frameCount * (double)std::max<size_t>(channelCount, 1));
+    peakDb = tailPeak > 0.0f ? std::max(20.0f * std::log10(tailPeak), VX1TelemetryFrame::kFloorDb) : VX1TelemetryFrame::kFloorDb;
+    rmsDb = meanSquare > 0.0 ? std::max((float)(10.0 * std::log10(meanSquare)), VX1TelemetryFrame::kFloorDb) : VX1TelemetryFrame::kFloorDb;
+}
+
+}
+
+void VX1ExtensionDSPKernel::process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime, AUAudioFrameCount frameCount) {
+    static const VX1ParameterTimeline noEvents(0);
+    process(inputBuffers, outputBuffers, bufferStartTime, frameCount, noEvents);
+}
+
+void VX1ExtensionDSPKernel::process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime,
+                                    AUAudioFrameCount frameCount, const VX1ParameterTimeline& timeline) {
+    process(inputBuffers, {}, outputBuffers, bufferStartTime, frameCount, timeline);
+}
+
+void VX1ExtensionDSPKernel::process(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                    std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime,
+                                    AUAudioFrameCount frameCount, const VX1ParameterTimeline& timeline) {
+    assert(inputBuffers.size() == outputBuffers.size() && inputBuffers.size() <= (size_t)kMaxChannels);
+    assert(sidechainBuffers.size() <= (size_t)kMaxChannels);
+    // Subnormals flush to zero while the kernel runs; the host's mode is restored on return
+    const VX1DenormalScope denormalScope(mFlushToZero);
+    const VX1RealtimeScope realtimeScope;
+    const uint64_t blockStart = vx1::perf::stamp();
+    mPerf.applyPendingReset();
+
+    // Input levels are taken before rendering, which may be in place
+    const bool telemetry = mTelemetryEnabled.load() && frameCount > 0;
+    VX1TelemetryFrame telemetryFrame;
+    if (telemetry) {
+        telemetryFrame.sampleTime = bufferStartTime;
+        telemetryFrame.frameCount = frameCount;
+        measureLevels(inputBuffers.data(), inputBuffers.size(), (int)frameCount,
+                      telemetryFrame.inputPeakDb, telemetryFrame.inputRmsDb);
+    }
+
+    const std::span<const VX1TimelineEvent> events = timeline.events();
+    std::array<const float*, kMaxChannels> segmentInputs;
+    std::array<float*, kMaxChannels> segmentOutputs;
+    std::array<const float*, kMaxChannels> segmentSidechain;
+    const size_t channelCount = inputBuffers.size();
+    // The key only reaches the engine while the detector listens to it
+    const size_t sidechainCount = mSidechainSource == SidechainSource::internal ? 0 : sidechainBuffers.size();
+
+    float peakGainReductionDb = 0.0f;
+    size_t next = 0;
+    AUAudioFrameCount start = 0;
+    while (start < frameCount) {
+        // Everything due before the minimum segment is over applies now, folded into its ramp
+        const AUAudioFrameCount foldEnd = start + std::min(mMinSegmentFrames, frameCount - start);
+        while (next < events.size() && events[next].frameOffset < foldEnd) {
+            applyTimelineEvent(events[next++], start);
+        }
+        const AUAudioFrameCount end = next < events.size() ? std::min(events[next].frameOffset, frameCount) : frameCount;
+
+        for (size_t channel = 0; channel < channelCount; ++channel) {
+            segmentInputs[channel] = inputBuffers[channel] + start;
+            segmentOutputs[channel] = outputBuffers[channel] + start;
+        }
+        for (size_t channel = 0; channel < sidechainCount; ++channel) {
+            segmentSidechain[channel] = sidechainBuffers[channel] + start;
+        }
+        peakGainReductionDb = std::max(peakGainReductionDb,
+                                       renderSegment(std::span(segmentInputs.data(), channelCount),
+                                                     std::span(segmentSidechain.data(), sidechainCount),
+                                                     std::span(segmentOutputs.data(), channelCount), end - start));
+        start = end;
+    }
+    while (next < events.size()) {
+        applyTimelineEvent(events[next++], frameCount);
+    }
+    // Checked before the flush, which would clear the very state it looks for
+    const bool denormalHeavy = vx1::perf::kEnabled && stateHasDenormals();
+    flushDecayingState();
+
+    mPerf.recordBlock(vx1::perf::stamp() - blockStart, frameCount, denormalHeavy);
+
+    if (frameCount == 0) return;
+    if (mBypassed) {
+        mCurrentGainReductionDb = 0.0f;
+    } else {
+        updateGainReductionMeter(peakGainReductionDb);
+    }
+    mPublishedGainReductionDb.store(mCurrentGainReductionDb);
+
+    if (telemetry) {
+        measureLevels(outputBuffers.data(), outputBuffers.size(), (int)frameCount,
+                      telemetryFrame.outputPeakDb, telemetryFrame.outputRmsDb);
+        telemetryFrame.gainReductionDb = peakGainReductionDb;
+        telemetryFrame.bypassed = mBypassed;
+        captureDetectorTelemetry(telemetryFrame);
+        mTelemetry.push(telemetryFrame);
+    }
+}
+
+float VX1ExtensionDSPKernel::renderSegment(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                           std::span<float *> outputBuffers, AUAudioFrameCount frameCount) {
+    assert(inputBuffers.size() == outputBuffers.size());
+
+    if (mBypassed) {
+        // Pass the samples through unmodified
+        for (uint32_t channel = 0; channel < inputBuffers.size(); ++channel) {
+            std::copy_n(inputBuffers[channel], frameCount, outputBuffers[channel]);
+        }
+        return 0.0f;
+    }
+
+    // Nothing coming in and nothing left ringing: skip the engine. A live key keeps it
+    // running so the detector is where it should be when the main input comes back.
+    // A bank-computed detector already moved the state on, so its block always renders
+    if (!mDetectorPrecomputed && mSilenceSkipping && stateIsSettled() && inputIsSilent(inputBuffers, frameCount)
+        && inputIsSilent(sidechainBuffers, frameCount)) {
+        renderSilence(outputBuffers, frameCount);
+        return 0.0f;
+    }
+    mSilent = false;
+
+    float peakGainReductionDb = 0.0f;
+    // Oversampled Bite, the per-channel detector lanes, multiband, the double detector
+    // precision and the reduced-rate detector only exist in the block engine, so they
+    // override the engine choice
+    const SidechainLink link = activeSidechainLink();
+    const bool useBlockEngine = mEngine == Engine::block || mOversamplingFactor > 1 || mBandCount > 1
+                             || link == SidechainLink::unlinked || link == SidechainLink::max
+                             || !detectorIsStandard();
+    if (useBlockEngine && mScratchFrames > 0) {
+        // Sub-divide anything longer than the scratch capacity sized in initialize()
+        const AUAudioFrameCount capacity = (AUAudioFrameCount)mScratchFrames;
+        for (AUAudioFrameCount offset = 0; offset < frameCount; offset += capacity) {
+            const AUAudioFrameCount frames = std::min(capacity, frameCount - offset);
+            peakGainReductionDb = std::max(peakGainReductionDb,
+                                           processBlock(inputBuffers, sidechainBuffers, outputBuffers, offset, frames));
+        }
+    } else {
+        const uint64_t scalarStart = vx1::perf::stamp();
+        peakGainReductionDb = processScalar(inputBuffers, sidechainBuffers, outputBuffers, frameCount);
+        mPerf.recordStage(VX1PerfStage::scalar, vx1::perf::stamp() - scalarStart);
+    }
+    if (mTubeModel != VX1TubeModel::off) {
+        const uint64_t tubeStart = vx1::perf::stamp();
+        applyTube(outputBuffers, frameCount);
+        mPerf.recordStage(VX1PerfStage::tube, vx1::perf::stamp() - tubeStart);
+    }
+    if (mLimiterEnabled && mScratchFrames > 0) {
+        // The meter shows the compressor or the limiter, whichever is pulling harder
+        const uint64_t limiterStart = vx1::perf::stamp();
+        peakGainReductionDb = std::max(peakGainReductionDb, applyLimiter(outputBuffers, frameCount));
+        mPerf.recordStage(VX1PerfStage::limiter, vx1::perf::stamp() - limiterStart);
+    }
+    return peakGainReductionDb;
+}
+
+void VX1ExtensionDSPKernel::applyTimelineEvent(const VX1TimelineEvent& event, AUAudioFrameCount now) {
+    const int early = event.frameOffset > now ? (int)(event.frameOffset - now) : 0;
+    const int rampFrames = event.rampFrames > 0 ? (int)event.rampFrames : mDezipperFrames;
+    setParameterRamped(event.address, event.value, rampFrames + early);
+}
+
+void VX1ExtensionDSPKernel::updateGainReductionMeter(float peakGainReductionDb) {
+    // Update meter with peak gain reduction from this buffer
+    // Apply smoothing for visual stability (instant attack, adaptive release)
+    if (peakGainReductionDb > mCurrentGainReductionDb) {
+        // Attack - snap immediately to peak so the needle reacts without lag
+        mCurrentGainReductionDb = peakGainReductionDb;
+    } else {
+        // Release - use adaptive strategy based on how close to zero we are
+        if (peakGainReductionDb < 0.05f) {
+            // When minimal or no compression, snap to zero immediately
+            // This ensures meter resets quickly when audio stops
+            mCurrentGainReductionDb = 0.0f;
+        } else if (peakGainReductionDb < 1.0f) {
+            // Fast release when light compression (0.5 coefficient = much faster)
+            mCurrentGainReductionDb = 0.5f * mCurrentGainReductionDb + 0.5f * peakGainReductionDb;
+        } else {
+            // Normal slow release for readability during active compression
+            float meterReleaseCoeff = 0.95f;
+            mCurrentGainReductionDb = meterReleaseCoeff * mCurrentGainReductionDb + (1.0f - meterReleaseCoeff) * peakGainReductionDb;
+        }
+    }
+}
+
+bool VX1ExtensionDSPKernel::stateHasDenormals() const {
+    auto subnormal = [](float x) { return std::fpclassify(x) == FP_SUBNORMAL; };
+    for (float x : { mDetector.envelopeLevel, mDetector.rmsState, mDetector.envelopeLevel2, mDetector.rmsState2, mDetector.overshootDb, mDetector.overshootDb2,
+                     mDetector.hpfX1, mDetector.hpfX2, mDetector.hpfY1, mDetector.hpfY2, mDetector.gateEnvelope, mDetector.gateGain }) {
+        if (subnormal(x)) return true;
+    }
+    for (int channel = 0; channel < mChannelCount; ++channel) {
+        if (subnormal(mChannels.preY1[channel]) || subnormal(mChannels.deY1[channel])
+            || subnormal(mChannels.envelopeLevel[channel]) || subnormal(mChannels.rmsState[channel])
+            || subnormal(mChannels.hpfY1[channel]) || subnormal(mChannels.gateEnvelope[channel])) {
+            return true;
+        }
+    }
+    if (mBandCount > 1) {
+        for (int band = 0; band < VX1Crossover::kMaxBands; ++band) {
+            if (subnormal(mBands.envelopeLevel[band]) || subnormal(mBands.rmsState[band])) return true;
+        }
+        if (mSidechainSplit.hasDenormals()) return true;
+        for (int channel = 0; channel < mChannelCount; ++channel) {
+            if (mBandSplits[channel].hasDenormals()) return true;
+        }
+    }
+    bool tubeDenormals = false;
+    forEachTubeStage([&](const auto& stage) { tubeDenormals = tubeDenormals || stage.hasDenormals(mChannelCount); });
+    return tubeDenormals;
+}
+
+void VX1ExtensionDSPKernel::captureDetectorTelemetry(VX1TelemetryFrame& frame) const {
+    const bool stack = mGainComputer.stackEnabled();
+    if (mBandCount > 1) {
+        // Report the band pulling hardest; Stack does not run per band
+        int loudest = 0;
+        for (int band = 1; band < mBandCount; ++band) {
+            if (mBands.prevGainReductionDb[band] > mBands.prevGainReductionDb[loudest]) loudest = band;
+        }
+        frame.pass1GainReductionDb = mBands.prevGainReductionDb[loudest];
+        frame.pass2GainReductionDb = 0.0f;
+        frame.overshootDb = mBands.overshootDb[loudest];
+        frame.gateGain = mDetector.gateGain;
+        frame.gateOpen = mDetector.gateOpen;
+        return;
+    }
+    if (activeSidechainLink() == SidechainLink::unlinked) {
+        // Report the lane pulling hardest, and the most open gate
+        int loudest = 0;
+        float gateGain = 0.0f;
+        for (int channel = 0; channel < mChannelCount; ++channel) {
+            if (mChannels.prevGainReductionDb[channel] > mChannels.prevGainReductionDb[loudest]) loudest = channel;
+            gateGain = std::max(gateGain, mChannels.gateGain[channel]);
+        }
+        frame.pass1GainReductionDb = mChannels.prevGainReductionDb[loudest];
+        frame.pass2GainReductionDb = stack ? mChannels.prevGainReductionDb2[loudest] : 0.0f;
+        frame.overshootDb = mChannels.overshootDb[loudest] + (stack ? mChannels.overshootDb2[loudest] : 0.0f);
+        frame.gateGain = gateGain;
+        frame.gateOpen = gateGain >= 0.5f;
+        return;
+    }
+    frame.pass1GainReductionDb = mDetector.prevGainReductionDb;
+    frame.pass2GainReductionDb = stack ? mDetector.prevGainReductionDb2 : 0.0f;
+    frame.overshootDb = mDetector.overshootDb + (stack ? mDetector.overshootDb2 : 0.0f);
+    frame.gateGain = mDetector.gateGain;
+    frame.gateOpen = mDetector.gateOpen;
+}
+
+// MARK: - Silence
+
+bool VX1ExtensionDSPKernel::inputIsSilent(std::span<float const*> inputBuffers, AUAudioFrameCount frameCount) const {
+    using namespace vx1::simd;
+
+    constexpr int kChunkFrames = 64;
+    const int frames = (int)frameCount;
+    alignas(64) float lanes[kWidth];
+    for (const float* in : inputBuffers) {
+        for (int start = 0; start < frames; start += kChunkFrames) {
+            const int end = std::min(start + kChunkFrames, frames);
+            const int vecEnd = start + vectorFrames(end - start);
+            FloatVec peak = broadcast(0.0f);
+            float chunkPeak = 0.0f;
+            for (int i = start; i < vecEnd; i += kWidth) {
+                peak = max(peak, abs(load(in + i)));
+            }
+            for (int i = vecEnd; i < end; ++i) {
+                chunkPeak = std::max(chunkPeak, std::abs(in[i]));
+            }
+            store(lanes, peak);
+            for (int k = 0; k < kWidth; ++k) chunkPeak = std::max(chunkPeak, lanes[k]);
+            if (chunkPeak >= kSilenceFloor) return false;
+        }
+    }
+    return true;
+}
+
+bool VX1ExtensionDSPKernel::detectorIsBankable(std::span<float const*> inputBuffers, AUAudioFrameCount frameCount) const {
+    if (mBypassed || mBandCount > 1 || mSidechainSource != SidechainSource::internal) return false;
+    if (mSidechainLink != SidechainLink::all && mSidechainLink != SidechainLink::lcr) return false;
+    if (mEngine != Engine::block && mOversamplingFactor == 1) return false;
+    if (!detectorIsStandard()) return false;
+    if (frameCount == 0 || frameCount > mScratchFrames) return false;
+    if (mSmoothedThresholdDb.isRamping() || mSmoothedSlope.isRamping()
+        || mSmoothedAttackCoeff.isRamping() || mSmoothedReleaseCoeff.isRamping()) {
+        return false;
+    }
+    return !(mSilenceSkipping && stateIsSettled() && inputIsSilent(inputBuffers, frameCount));
+}
+
+bool VX1ExtensionDSPKernel::stateIsSettled() const {
+    auto quiet = [](float x) { return std::abs(x) <= kSilenceFloor; };
+    auto quietPower = [](float x) { return x <= kSilenceFloor * kSilenceFloor; };
+
+    const bool multiband = mBandCount > 1;
+    const SidechainLink link = activeSidechainLink();
+    const bool unlinked = link == SidechainLink::unlinked;
+    const bool detectorLanes = unlinked || link == SidechainLink::max;
+
+    // Gate, envelope, overshoot and Stack: one shared track unless unlinked; in multiband
+    // the gate is shared and the rest runs per band
+    if (!unlinked) {
+        if (mDetector.gateOpen || mDetector.gateHoldCounter > 0 || !quiet(mDetector.gateGain) || !quiet(mDetector.gateEnvelope)) return false;
+    }
+    if (!unlinked && !multiband) {
+        if (mDetector.overshootHoldCounter > 0 || mDetector.overshootHoldCounter2 > 0) return false;
+        for (float x : { mDetector.envelopeLevel, mDetector.envelopeLevel2, mDetector.overshootDb, mDetector.overshootDb2 }) {
+            if (!quiet(x)) return false;
+        }
+        if (!quietPower(mDetector.rmsState2)) return false;
+    }
+    if (multiband) {
+        for (int band = 0; band < VX1Crossover::kMaxBands; ++band) {
+            if (mBands.overshootHoldCounter[band] > 0 || !quiet(mBands.envelopeLevel[band])
+                || !quiet(mBands.overshootDb[band]) || !quietPower(mBands.rmsState[band])) {
+                return false;
+            }
+        }
+        if (!mSidechainSplit.isSettled(kSilenceFloor)) return false;
+        for (int c = 0; c < mChannelCount; ++c) {
+            if (!mBandSplits[c].isSettled(kSilenceFloor)) return false;
+        }
+    }
+    // Sidechain HPF and RMS: shared in the linked modes, per lane otherwise
+    if (!detectorLanes) {
+        for (float x : { mDetector.hpfX1, mDetector.hpfX2, mDetector.hpfY1, mDetector.hpfY2 }) {
+            if (!quiet(x)) return false;
+        }
+        if (!quietPower(mDetector.rmsState)) return false;
+    }
+
+    bool tubeSettled = true;
+    forEachTubeStage([&](const auto& stage) { tubeSettled = tubeSettled && stage.isSettled(mChannelCount, kSilenceFloor); });
+    if (!tubeSettled) return false;
+
+    const VX1ChannelState& lanes = mChannels;
+    for (int c = 0; c < mChannelCount; ++c) {
+        if (!quiet(lanes.preX1[c]) || !quiet(lanes.preY1[c]) || !quiet(lanes.deX1[c]) || !quiet(lanes.deY1[c])) {
+            return false;
+        }
+        if (detectorLanes) {
+            if (!quiet(lanes.hpfX1[c]) || !quiet(lanes.hpfX2[c]) || !quiet(lanes.hpfY1[c]) || !quiet(lanes.hpfY2[c])
+                || !quietPower(lanes.rmsState[c])) {
+                return false;
+            }
+        }
+        if (unlinked) {
+            if (lanes.gateHoldCounter[c] > 0 || !quiet(lanes.gateGain[c]) || !quiet(lanes.gateEnvelope[c])
+                || lanes.overshootHoldCounter[c] > 0 || lanes.overshootHoldCounter2[c] > 0
+                || !quiet(lanes.envelopeLevel[c]) || !quiet(lanes.envelopeLevel2[c])
+                || !quiet(lanes.overshootDb[c]) || !quiet(lanes.overshootDb2[c]) || !quietPower(lanes.rmsState2[c])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void VX1ExtensionDSPKernel::renderSilence(std::span<float *> outputBuffers, AUAudioFrameCount frameCount) {
+    for (float* out : outputBuffers) {
+        std::fill_n(out, frameCount, 0.0f);
+    }
+
+    // Ramps keep running so automation lands where it would have
+    for (VX1SmoothedParameter* parameter : { &mSmoothedThresholdDb, &mSmoothedSlope, &mSmoothedAttackCoeff,
+                                             &mSmoothedReleaseCoeff, &mSmoothedMakeupGain, &mSmoothedMixWet }) {
+        parameter->skip((int)frameCount);
+    }
+    mPerf.recordSilence(frameCount);
+    if (mSilent) return;
+
+    // First silent segment: the remaining tails are below -140 dB, put everything at rest
+    mDetector.gateEnvelope = mDetector.gateGain = 0.0f;
+    mDetector.hpfX1 = mDetector.hpfX2 = mDetector.hpfY1 = mDetector.hpfY2 = 0.0f;
+    mDetector.rmsState = mDetector.envelopeLevel = mDetector.prevGainReductionDb = mDetector.overshootDb = 0.0f;
+    mDetector.rmsState2 = mDetector.envelopeLevel2 = mDetector.prevGainReductionDb2 = mDetector.overshootDb2 = 0.0f;
+    mDecimator = {};
+    mChannels.resetShelves();
+    mChannels.resetDetectors();
+    mSidechainSplit.reset();
+    for (VX1CrossoverState& split : mBandSplits) split.reset();
+    mBands.reset();
+    if (activeSidechainLink() == SidechainLink::unlinked) {
+        std::fill_n(mChannels.gateGain, kMaxChannels, 0.0f);
+    }
+    for (VX1Oversampler& oversampler : mOversamplers) oversampler.reset();
+    for (VX1DelayLine& delay : mBiteDryDelay) delay.reset();
+    for (VX1DelayLine& delay : mMixDryDelay) delay.reset();
+    mLimiter.reset();
+    forEachTubeStage([](auto& stage) { stage.reset(); });
+    mSilent = true;
+}
+
+void VX1ExtensionDSPKernel::flushDecayingState() {
+    using vx1::denormals::flush;
+
+    for (float* state : { &mDetector.gateEnvelope, &mDetector.gateGain, &mDetector.hpfX1, &mDetector.hpfX2, &mDetector.hpfY1, &mDetector.hpfY2,
+                          &mDetector.rmsState, &mDetector.envelopeLevel, &mDetector.overshootDb,
+                          &mDetector.rmsState2, &mDetector.envelopeLevel2, &mDetector.overshootDb2 }) {
+        flush(*state);
+    }
+    VX1ChannelState& lanes = mChannels;
+    for (float* lane : { lanes.preX1, lanes.preY1, lanes.deX1, lanes.deY1,
+                         lanes.gateEnvelope, lanes.gateGain, lanes.hpfX1, lanes.hpfX2, lanes.hpfY1, lanes.hpfY2,
+                         lanes.rmsState, lanes.envelopeLevel, lanes.overshootDb,
+                         lanes.rmsState2, lanes.envelopeLevel2, lanes.overshootDb2 }) {
+        flush(lane, mChannelCount);
+    }
+    if (mBandCount > 1) {
+        for (float* lane : { mBands.rmsState, mBands.envelopeLevel, mBands.overshootDb }) {
+            flush(lane, VX1Crossover::kMaxBands);
+        }
+        mSidechainSplit.flushDecayingState();
+        for (int channel = 0; channel < mChannelCount; ++channel) mBandSplits[channel].flushDecayingState();
+    }
+    forEachTubeStage([this](auto& stage) { stage.flushDecayingState(mChannelCount); });
+}
+
+// MARK: - Scalar Engine
+
+float VX1ExtensionDSPKernel::processScalar(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                           std::span<float *> outputBuffers, AUAudioFrameCount frameCount) {
+    // Track peak gain reduction in this buffer
+    float peakGainReductionDb = 0.0f;
+
+    // Channels feeding the linked detector: all of them, or L/R/C only
+    const uint32_t detectorChannels = detectorChannelCount((int)inputBuffers.size());
+    // The main input feeds the detector unless an external key replaces it
+    const bool internalSidechain = mSidechainSource != SidechainSource::external;
+    const float keyScale = sidechainBuffers.empty() ? 0.0f : 1.0f / (float)sidechainBuffers.size();
+
+    // Smoothed parameters: the cached targets, stepped per frame while a ramp runs
+    VX1ExtensionGainComputer gainComputer = mGainComputer;
+    const bool detectorRamping = mSmoothedThresholdDb.isRamping() || mSmoothedSlope.isRamping()
+                              || mSmoothedAttackCoeff.isRamping() || mSmoothedReleaseCoeff.isRamping();
+    const bool mixRamping = mSmoothedMakeupGain.isRamping() || mSmoothedMixWet.isRamping();
+    float attackCoeff = mDetector.attackCoeff, releaseCoeff = mDetector.releaseCoeff;
+    float makeupGain = mMakeupGainLinear, mixWet = mParameters.mixPercent / 100.0f;
+
+    // Process each frame
+    for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        if (detectorRamping) {
+            gainComputer.rampCompression(mSmoothedThresholdDb.next(), mSmoothedSlope.next());
+            attackCoeff = mSmoothedAttackCoeff.next();
+            releaseCoeff = mSmoothedReleaseCoeff.next();
+        }
+        if (mixRamping) {
+            mixWet = mSmoothedMixWet.next();
+            makeupGain = mSmoothedMakeupGain.next();
+        }
+
+        // --- Noise Gate: pre-input-gain, runs on raw input level ---
+        // Envelope follower on the peak of the raw (pre-gain) mono sum.
+        // When signal drops below threshold: hold for 50ms, then close over 100ms.
+        // Gate gain (0=closed, 1=open) is applied to both sidechain and audio paths.
+        {
+            float rawMono = 0.0f;
+            for (uint32_t ch = 0; ch < detectorChannels; ++ch) {
+                rawMono += std::abs(inputBuffers[ch][frameIndex]);
+            }
+            rawMono /= (float)detectorChannels;
+
+            // Peak envelope follower: fast attack, slow release
+            if (rawMono > mDetector.gateEnvelope) {
+                mDetector.gateEnvelope = mDetector.gateAttackCoeff * mDetector.gateEnvelope + (1.0f - mDetector.gateAttackCoeff) * rawMono;
+            } else {
+                mDetector.gateEnvelope = mDetector.gateReleaseCoeff * mDetector.gateEnvelope + (1.0f - mDetector.gateReleaseCoeff) * rawMono;
+            }
+
+            bool signalAboveThreshold = (mDetector.gateEnvelope >= gainComputer.gateThresholdLinear());
+
+            if (signalAboveThreshold) {
+                // Signal present: open gate, reset hold counter
+                mDetector.gateOpen = true;
+                mDetector.gateHoldCounter = mDetector.gateHoldSamples;
+                mDetector.gateGain = 1.0f;  // snap open instantly
+            } else if (mDetector.gateHoldCounter > 0) {
+                // Signal gone but still in hold period: stay open
+                mDetector.gateHoldCounter--;
+                mDetector.gateGain = 1.0f;
+            } else {
+                // Hold expired: close gate with smoothed release
+                mDetector.gateOpen = false;
+                mDetector.gateGain *= mDetector.gateReleaseCoeff;
+            }
+        }
+
+        // --- Detection: always runs on the current (undelayed) input ---
+        // Sidechain signal: mono sum (main input, key, or both) → fixed 80 Hz HPF
+        float monoSC = 0.0f;
+        if (internalSidechain) {
+            for (uint32_t channel = 0; channel < detectorChannels; ++channel) {
+                monoSC += inputBuffers[channel][frameIndex] * mDetector.gateGain;
+            }
+            monoSC /= (float)detectorChannels;
+        }
+        for (const float* key : sidechainBuffers) {
+            monoSC += key[frameIndex] * keyScale * mDetector.gateGain;
+        }
+        float filteredSC = applyHpf(monoSC);
+        float absFiltered = std::abs(filteredSC);
+
+        // Peak detection: instantaneous absolute value — grabs transients hard
+        float peak = absFiltered;
+
+        // RMS detection: IIR squared-sample accumulator (~50ms window)
+        // Responds to energy, not individual peaks — smooth and musical
+        mDetector.rmsState = mDetector.rmsCoeff * mDetector.rmsState + (1.0f - mDetector.rmsCoeff) * (absFiltered * absFiltered);
+        float rms = std::sqrt(mDetector.rmsState);
+
+        // Blend detected level: 0% = pure RMS (smooth), 100% = pure Peak (tight/aggressive)
+        float gripBlend = mParameters.gripPercent / 100.0f;
+        float detectionLevel = (rms * (1.0f - gripBlend)) + (peak * gripBlend);
+
+        // Dramatic mode difference: envelope attack changes with grip knob
+        // RMS (0%): uses the user's attack knob — compressor breathes with the music
+        // Peak (100%): ~2ms near-instant attack — compressor slams on every transient
+        float blendedAttackCoeff = attackCoeff * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend;
+
+        // Envelope follower (blended attack, fixed release)
+        float coeff = (detectionLevel > mDetector.envelopeLevel) ? blendedAttackCoeff : releaseCoeff;
+        mDetector.envelopeLevel = coeff * mDetector.envelopeLevel + (1.0f - coeff) * detectionLevel;
+
+        // Calculate gain reduction (hard knee); 0 dB below threshold
+        float gainReductionDb = gainComputer.gainReductionDb(mDetector.envelopeLevel);
+
+        // --- GR Overshoot: VCA-style transient punch ---
+        // Replicates the physical overshoot of a VCA gain cell (dbx 160 / SSL G-bus):
+        // when a transient causes GR to jump by more than 3 dB in one sample,
+        // briefly over-apply 3 dB of extra GR for 0.5ms (hold), then release
+        // exponentially over 2ms. Creates the "slammed" transient grab feel.
+        float grJump = gainReductionDb - mDetector.prevGainReductionDb;
+        if (grJump > 3.0f) {
+            mDetector.overshootDb = 3.0f;
+            mDetector.overshootHoldCounter = mDetector.overshootHoldSamples;
+        }
+        mDetector.prevGainReductionDb = gainReductionDb;
+        if (mDetector.overshootHoldCounter > 0) {
+            mDetector.overshootHoldCounter--;              // hold phase: overshoot stays fixed
+        } else {
+            mDetector.overshootDb *= mDetector.overshootReleaseCoeff; // release phase: exponential decay
+        }
+        float totalGainReductionDb = gainReductionDb + mDetector.overshootDb;
+        float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+
+        // Track peak gain reduction for metering (includes overshoot — meter shows what you hear)
+        peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+        // --- Stack: true serial second compression pass ---
+        // Detects on the post-pass-1 signal so the second stage sees an already-compressed
+        // input, just like chaining two hardware units. Stack lowers the second stage's
+        // threshold (making it hit progressively harder as the knob increases).
+        // GR multiplies — no blend/lerp — so at any Stack > 0 you feel the stacking.
+        float gainReductionTotal2 = 1.0f;
+
+        if (gainComputer.stackEnabled()) {
+            // Sidechain: mono sum of post-pass-1 audio
+            float monoPost1 = 0.0f;
+            for (uint32_t ch = 0; ch < detectorChannels; ++ch) {
+                monoPost1 += inputBuffers[ch][frameIndex] * mDetector.gateGain * gainReductionTotal;
+            }
+            monoPost1 /= (float)detectorChannels;
+            float absPost1 = std::abs(monoPost1);
+
+            float peak2 = absPost1;
+            mDetector.rmsState2 = mDetector.rmsCoeff * mDetector.rmsState2 + (1.0f - mDetector.rmsCoeff) * (absPost1 * absPost1);
+            float rms2 = std::sqrt(mDetector.rmsState2);
+
+            float detectionLevel2 = (rms2 * (1.0f - gripBlend)) + (peak2 * gripBlend);
+            float coeff2 = (detectionLevel2 > mDetector.envelopeLevel2) ? blendedAttackCoeff : releaseCoeff;
+            mDetector.envelopeLevel2 = coeff2 * mDetector.envelopeLevel2 + (1.0f - coeff2) * detectionLevel2;
+
+            // Stack knob lowers the second stage threshold proportionally so it bites
+            // harder as you turn it up. At 100% Stack the threshold is halved in dB.
+            float gainReductionDb2 = gainComputer.gainReductionDb2(mDetector.envelopeLevel2);
+
+            // VCA overshoot on pass 2
+            float grJump2 = gainReductionDb2 - mDetector.prevGainReductionDb2;
+            if (grJump2 > 3.0f) {
+                mDetector.overshootDb2 = 3.0f;
+                mDetector.overshootHoldCounter2 = mDetector.overshootHoldSamples;
+            }
+            mDetector.prevGainReductionDb2 = gainReductionDb2;
+            if (mDetector.overshootHoldCounter2 > 0) {
+                mDetector.overshootHoldCounter2--;
+            } else {
+                mDetector.overshootDb2 *= mDetector.overshootReleaseCoeff;
+            }
+            float totalGainReductionDb2 = gainReductionDb2 + mDetector.overshootDb2;
+            gainReductionTotal2 = VX1ExtensionGainComputer::gain(totalGainReductionDb2);
+
+            peakGainReductionDb = std::max(peakGainReductionDb,
+                                           totalGainReductionDb + totalGainReductionDb2);
+        }
+
+        // Stack auto-makeup: compensate for the expected additional GR from pass 2.
+        // Static per Stack value (cached by the gain computer at event time), so it is
+        // stable and does not add pumping. At Stack=0 it is exactly 1.0 (no change).
+        float stackMakeupGain = gainComputer.stackMakeupGain();
+
+        // Apply compression, saturation, makeup gain, then mix with dry signal
+        float mixDry = 1.0f - mixWet;
+
+        for (uint32_t channel = 0; channel < inputBuffers.size(); ++channel) {
+            float audioInput = inputBuffers[channel][frameIndex] * mDetector.gateGain;
+
+            // Apply pass 1 compression, then pass 2 GR multiplies on top (true serial stacking).
+            // stackMakeupGain compensates for the expected volume drop from the second pass.
+            float compressed = audioInput * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+
+            // Apply sheen saturation (presence-biased harmonic coloration)
+            float saturated = applySaturation(compressed, (int)channel);
+
+            // Apply makeup gain
+            saturated *= makeupGain;
+
+            // Parallel mix: blend dry and processed signals
+            float output = (audioInput * mixDry) + (saturated * mixWet);
+            outputBuffers[channel][frameIndex] = output;
+        }
+
+    }
+
+    return peakGainReductionDb;
+}
+
+// MARK: - Block Engine
+
+namespace {
+
+/// Planar channel rows → frame-major lanes, laneStride floats per frame (padding lanes zeroed).
+void interleaveLanes(std::span<float* const> rows, float* lanes, int laneStride, int frameCount) {
+    const int channelCount = (int)rows.size();
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* row = rows[channel];
+        float* lane = lanes + channel;
+        for (int i = 0; i < frameCount; ++i) lane[(size_t)i * laneStride] = row[i];
+    }
+    for (int channel = channelCount; channel < laneStride; ++channel) {
+        float* lane = lanes + channel;
+        for (int i = 0; i < frameCount; ++i) lane[(size_t)i * laneStride] = 0.0f;
+    }
+}
+
+/// Bite's 1-pole shelf scaled in by the Bite amount, src → dst (may alias):
+///   y = b0·x + b1·x1 − a1·y1,   out = x + (y − x)·blend
+void shelfChannel(const float* src, float* dst, int frameCount, float b0, float b1, float a1, float blend,
+                  float& x1, float& y1) {
+    float stateX1 = x1, stateY1 = y1;
+    for (int i = 0; i < frameCount; ++i) {
+        const float x = src[i];
+        const float y = b0 * x + b1 * stateX1 - a1 * stateY1;
+        stateX1 = x;
+        stateY1 = y;
+        dst[i] = x + (y - x) * blend;
+    }
+    x1 = stateX1;
+    y1 = stateY1;
+}
+
+}
+
+/*
+ Staged pipeline over the whole block instead of one frame at a time:
+   1. Mono sums (|x| for the gate, x for the sidechain) — SIMD across frames
+   2. Gate, sidechain HPF, detector, gain computer, overshoot and Stack — one tight
+      recursion over scratch arrays with all state in locals and no channel loops
+      (unlinked / max link: per-channel detector lanes, see processDetectorLanes();
+      multiband: one detector lane per band, see processDetectorMultiband())
+   3. Per channel: gain (multiband: band split, band gains and sum), Bite saturation,
+      makeup and mix — SIMD across frames, except
+      Bite with three or more channels, which runs SIMD across channels (one lane each)
+      so its shelf recursions advance every channel per step
+
+ The recursions are the same arithmetic as processScalar(); only the order of the
+ mono-sum/gate multiply and of the gain product differs, so output matches the
+ scalar engine to within 1e-5 absolute (see kBlockEngineTolerance).
+ */
+float VX1ExtensionDSPKernel::processBlock(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                          std::span<float *> outputBuffers, AUAudioFrameCount frameOffset, AUAudioFrameCount frameCount) {
+    using namespace vx1::simd;
+
+    // A VX1KernelBank already ran stages 1–2 of this block in its instance lanes
+    const bool detectorPrecomputed = mDetectorPrecomputed;
+    mDetectorPrecomputed = false;
+
+    // Common configurations have a variant with the unused features compiled out
+    if (mBlockVariants && !detectorPrecomputed) {
+        if (const BlockVariantFunction variant = selectBlockVariant((int)inputBuffers.size(), (int)frameCount)) {
+            return (this->*variant)(inputBuffers, outputBuffers, frameOffset, (int)frameCount);
+        }
+    }
+
+    const int frames = (int)frameCount;
+    const int vecFrames = vectorFrames(frames);
+    const int channelCount = (int)inputBuffers.size();
+    const bool multiband = mBandCount > 1;
+    const SidechainLink link = activeSidechainLink();
+    const bool unlinked = link == SidechainLink::unlinked;
+    const bool detectorLanes = unlinked || link == SidechainLink::max;
+    // The reduced-rate detector's interpolation only carries across consecutive linked blocks
+    if (multiband || detectorLanes) mDecimator.primed = false;
+
+    float* gate = mScratch.data(mScratchGate);
+    float* gain = mScratch.data(mScratchGain);
+
+    uint64_t stageStart = vx1::perf::stamp();
+    const float peakGainReductionDb = detectorPrecomputed ? mPrecomputedPeakGainReductionDb
+                                    : multiband ? processDetectorMultiband(inputBuffers, sidechainBuffers, frameOffset, frames)
+                                    : detectorLanes ? processDetectorLanes(inputBuffers, frameOffset, frames)
+                                    : processDetectorLinked(inputBuffers, sidechainBuffers, frameOffset, frames);
+    uint64_t stageEnd = vx1::perf::stamp();
+    mPerf.recordStage(VX1PerfStage::detector, stageEnd - stageStart);
+    stageStart = stageEnd;
+
+    // --- Stage 3: per-channel gain, saturation, makeup and mix ---
+    // Unlinked detection wrote a gate and gain row per channel, the linked modes one shared row
+    const size_t channelRowStride = unlinked ? mScratchFrames : 0;
+    std::array<float*, kMaxChannels> wetRows;
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* in = inputBuffers[channel] + frameOffset;
+        const float* channelGain = gain + channel * channelRowStride;
+        float* wet = mScratch.data(mScratchWet) + channel * mScratchFrames;
+        wetRows[channel] = wet;
+
+        if (multiband) {
+            applyBandGains(in, wet, channel, frames);
+            continue;
+        }
+
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            store(wet + i, load(in + i) * load(channelGain + i));
+        }
+        for (; i < frames; ++i) {
+            wet[i] = in[i] * channelGain[i];
+        }
+    }
+
+    applySaturationBlock(std::span<float* const>(wetRows.data(), (size_t)channelCount), frames);
+
+    stageEnd = vx1::perf::stamp();
+    mPerf.recordStage(VX1PerfStage::saturation, stageEnd - stageStart);
+    stageStart = stageEnd;
+
+    const float mixWet = mParameters.mixPercent / 100.0f;
+    const FloatVec vMixDry = broadcast(1.0f - mixWet);
+    const FloatVec vWetGain = broadcast(mMakeupGainLinear * mixWet);
+    // While makeup or mix ramps, the per-frame gains come from these rows instead
+    const bool mixRamping = fillMixRamps(frames);
+    const float* mixDry = rampRow(kRampMixDry);
+    const float* wetGain = rampRow(kRampWetGain);
+
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* in = inputBuffers[channel] + frameOffset;
+        const float* channelGate = gate + channel * channelRowStride;
+        const float* wet = wetRows[channel];
+        float* out = outputBuffers[channel] + frameOffset;
+
+        // Parallel mix: the dry path keeps the gate, the wet path gets makeup
+        int i = 0;
+        if (mixRamping) {
+            // Gated dry path (delayed when Bite is oversampled), then per-frame gains
+            float* dry = mScratch.data(mScratchDry);
+            for (; i < vecFrames; i += kWidth) {
+                store(dry + i, load(in + i) * load(channelGate + i));
+            }
+            for (; i < frames; ++i) {
+                dry[i] = in[i] * channelGate[i];
+            }
+            if (mOversamplingFactor > 1) mMixDryDelay[channel].process(dry, frames);
+
+            i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                store(out + i, load(dry + i) * load(mixDry + i) + load(wet + i) * load(wetGain + i));
+            }
+            for (; i < frames; ++i) {
+                out[i] = dry[i] * mixDry[i] + wet[i] * wetGain[i];
+            }
+        } else if (mOversamplingFactor > 1) {
+            // The wet path lags by mLatencySamples, so the dry path is delayed to match
+            float* dry = mScratch.data(mScratchDry);
+            for (; i < vecFrames; i += kWidth) {
+                store(dry + i, load(in + i) * load(channelGate + i));
+            }
+            for (; i < frames; ++i) {
+                dry[i] = in[i] * channelGate[i];
+            }
+            mMixDryDelay[channel].process(dry, frames);
+
+            i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                store(out + i, load(dry + i) * vMixDry + load(wet + i) * vWetGain);
+            }
+            for (; i < frames; ++i) {
+                out[i] = dry[i] * (1.0f - mixWet) + wet[i] * (mMakeupGainLinear * mixWet);
+            }
+        } else {
+            for (; i < vecFrames; i += kWidth) {
+                FloatVec dry = load(in + i) * load(channelGate + i);
+                store(out + i, dry * vMixDry + load(wet + i) * vWetGain);
+            }
+            for (; i < frames; ++i) {
+                out[i] = (in[i] * channelGate[i]) * (1.0f - mixWet) + wet[i] * (mMakeupGainLinear * mixWet);
+            }
+        }
+    }
+
+    mPerf.recordStage(VX1PerfStage::mix, vx1::perf::stamp() - stageStart);
+    return peakGainReductionDb;
+}
+
+void VX1ExtensionDSPKernel::sumDetectorChannels(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                                AUAudioFrameCount frameOffset, int frames) {
+    using namespace vx1::simd;
+
+    const int vecFrames = vectorFrames(frames);
+    const int detectorChannels = detectorChannelCount((int)inputBuffers.size());
+
+    float* absMono = mScratch.data(mScratchAbsMono);
+    float* mono    = mScratch.data(mScratchMono);
+
+    // The gate always follows the main input; the detector hears it unless the key replaces it
+    const bool internal = mSidechainSource != SidechainSource::external;
+    std::fill_n(absMono, frames, 0.0f);
+    std::fill_n(mono, frames, 0.0f);
+    for (int channel = 0; channel < detectorChannels; ++channel) {
+        const float* in = inputBuffers[channel] + frameOffset;
+        int i = 0;
+        if (internal) {
+            for (; i < vecFrames; i += kWidth) {
+                FloatVec x = load(in + i);
+                store(absMono + i, load(absMono + i) + abs(x));
+                store(mono + i, load(mono + i) + x);
+            }
+            for (; i < frames; ++i) {
+                absMono[i] += std::abs(in[i]);
+                mono[i] += in[i];
+            }
+        } else {
+            for (; i < vecFrames; i += kWidth) {
+                store(absMono + i, load(absMono + i) + abs(load(in + i)));
+            }
+            for (; i < frames; ++i) {
+                absMono[i] += std::abs(in[i]);
+            }
+        }
+    }
+    if (detectorChannels > 1) {
+        const float channelScale = (float)detectorChannels;
+        for (int i = 0; i < frames; ++i) {
+            absMono[i] /= channelScale;
+            mono[i] /= channelScale;
+        }
+    }
+
+    // External or mixed key: its mean, read straight from the caller's buffers
+    if (sidechainBuffers.empty()) return;
+    const float keyScale = 1.0f / (float)sidechainBuffers.size();
+    const FloatVec keyScaleVec = broadcast(keyScale);
+    for (const float* keyChannel : sidechainBuffers) {
+        const float* key = keyChannel + frameOffset;
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            store(mono + i, load(mono + i) + load(key + i) * keyScaleVec);
+        }
+        for (; i < frames; ++i) {
+            mono[i] += key[i] * keyScale;
+        }
+    }
+}
+
+template <typename Real>
+float VX1ExtensionDSPKernel::runLinkedDetector(VX1DetectorStateT<Real>& detector, int frames) {
+    const float* absMono = mScratch.data(mScratchAbsMono);
+    const float* mono    = mScratch.data(mScratchMono);
+    float* gate = mScratch.data(mScratchGate);
+    float* gain = mScratch.data(mScratchGain);
+
+    // --- Stage 2: detector / gain computer recursion ---
+    // Everything that only depends on parameters is cached in mGainComputer or hoisted here.
+    VX1ExtensionGainComputer gainComputer = mGainComputer;
+    const float gateThresholdLinear = gainComputer.gateThresholdLinear();
+    const Real gripBlend = (Real)mParameters.gripPercent / 100.0f;
+    Real blendedAttackCoeff = detector.attackCoeff * (1.0f - gripBlend) + detector.instantCoeff * gripBlend;
+    Real releaseCoeff = detector.releaseCoeff;
+    const bool stackEnabled = gainComputer.stackEnabled();
+    float stackMakeupGain = gainComputer.stackMakeupGain();
+
+    // Compress / speed ramps replace the hoisted values frame by frame
+    const bool ramping = fillDetectorRamps(frames);
+    const float* thresholdRamp = rampRow(kRampThresholdDb);
+    const float* slopeRamp = rampRow(kRampSlope);
+    const float* attackRamp = rampRow(kRampAttackCoeff);
+    const float* releaseRamp = rampRow(kRampReleaseCoeff);
+
+    // Recursive state lives in registers for the whole block
+    Real gateEnvelope = detector.gateEnvelope, gateGain = detector.gateGain;
+    int   gateHoldCounter = detector.gateHoldCounter;
+    bool  gateOpen = detector.gateOpen;
+    Real hpfX1 = detector.hpfX1, hpfX2 = detector.hpfX2, hpfY1 = detector.hpfY1, hpfY2 = detector.hpfY2;
+    Real rmsState = detector.rmsState, envelopeLevel = detector.envelopeLevel;
+    Real prevGainReductionDb = detector.prevGainReductionDb, overshootDb = detector.overshootDb;
+    int   overshootHoldCounter = detector.overshootHoldCounter;
+    Real rmsState2 = detector.rmsState2, envelopeLevel2 = detector.envelopeLevel2;
+    Real prevGainReductionDb2 = detector.prevGainReductionDb2, overshootDb2 = detector.overshootDb2;
+    int   overshootHoldCounter2 = detector.overshootHoldCounter2;
+
+    float peakGainReductionDb = 0.0f;
+
+    for (int i = 0; i < frames; ++i) {
+        if (ramping) {
+            gainComputer.rampCompression(thresholdRamp[i], slopeRamp[i]);
+            stackMakeupGain = gainComputer.stackMakeupGain();
+            blendedAttackCoeff = attackRamp[i] * (1.0f - gripBlend) + detector.instantCoeff * gripBlend;
+            releaseCoeff = releaseRamp[i];
+        }
+
+        // Noise gate
+        const Real rawMono = absMono[i];
+        if (rawMono > gateEnvelope) {
+            gateEnvelope = detector.gateAttackCoeff * gateEnvelope + (1.0f - detector.gateAttackCoeff) * rawMono;
+        } else {
+            gateEnvelope = detector.gateReleaseCoeff * gateEnvelope + (1.0f - detector.gateReleaseCoeff) * rawMono;
+        }
+        if (gateEnvelope >= gateThresholdLinear) {
+            gateOpen = true;
+            gateHoldCounter = detector.gateHoldSamples;
+            gateGain = 1.0f;
+        } else if (gateHoldCounter > 0) {
+            gateHoldCounter--;
+            gateGain = 1.0f;
+        } else {
+            gateOpen = false;
+            gateGain *= detector.gateReleaseCoeff;
+        }
+        gate[i] = (float)gateGain;
+
+        // Sidechain HPF
+        const Real monoSC = mono[i] * gateGain;
+        const Real filteredSC = detector.hpfA0 * monoSC + detector.hpfA1 * hpfX1 + detector.hpfA2 * hpfX2
+                               - detector.hpfB1 * hpfY1 - detector.hpfB2 * hpfY2;
+        hpfX2 = hpfX1; hpfX1 = monoSC;
+        hpfY2 = hpfY1; hpfY1 = filteredSC;
+        const Real absFiltered = std::abs(filteredSC);
+
+        // Detector + envelope
+        rmsState = detector.rmsCoeff * rmsState + (1.0f - detector.rmsCoeff) * (absFiltered * absFiltered);
+        const Real detectionLevel = (std::sqrt(rmsState) * (1.0f - gripBlend)) + (absFiltered * gripBlend);
+        const Real coeff = (detectionLevel > envelopeLevel) ? blendedAttackCoeff : releaseCoeff;
+        envelopeLevel = coeff * envelopeLevel + (1.0f - coeff) * detectionLevel;
+
+        // Gain computer (hard knee)
+        const float gainReductionDb = gainComputer.gainReductionDb((float)envelopeLevel);
+
+        // VCA overshoot
+        if (gainReductionDb - prevGainReductionDb > 3.0f) {
+            overshootDb = 3.0f;
+            overshootHoldCounter = detector.overshootHoldSamples;
+        }
+        prevGainReductionDb = gainReductionDb;
+        if (overshootHoldCounter > 0) {
+            overshootHoldCounter--;
+        } else {
+            overshootDb *= detector.overshootReleaseCoeff;
+        }
+        const float totalGainReductionDb = gainReductionDb + (float)overshootDb;
+        const float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+        peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+        // Stack second pass on the post-pass-1 mono signal
+        float gainReductionTotal2 = 1.0f;
+        if (stackEnabled) {
+            const Real absPost1 = std::abs(monoSC * gainReductionTotal);
+            rmsState2 = detector.rmsCoeff * rmsState2 + (1.0f - detector.rmsCoeff) * (absPost1 * absPost1);
+            const Real detectionLevel2 = (std::sqrt(rmsState2) * (1.0f - gripBlend)) + (absPost1 * gripBlend);
+            const Real coeff2 = (detectionLevel2 > envelopeLevel2) ? blendedAttackCoeff : releaseCoeff;
+            envelopeLevel2 = coeff2 * envelopeLevel2 + (1.0f - coeff2) * detectionLevel2;
+
+            const float gainReductionDb2 = gainComputer.gainReductionDb2((float)envelopeLevel2);
+
+            if (gainReductionDb2 - prevGainReductionDb2 > 3.0f) {
+                overshootDb2 = 3.0f;
+                overshootHoldCounter2 = detector.overshootHoldSamples;
+            }
+            prevGainReductionDb2 = gainReductionDb2;
+            if (overshootHoldCounter2 > 0) {
+                overshootHoldCounter2--;
+            } else {
+                overshootDb2 *= detector.overshootReleaseCoeff;
+            }
+            const float totalGainReductionDb2 = gainReductionDb2 + (float)overshootDb2;
+            gainReductionTotal2 = VX1ExtensionGainComputer::gain(totalGainReductionDb2);
+
+            peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2);
+        }
+
+        // Gate, pass 1, pass 2 and Stack makeup folded into one per-frame gain
+        gain[i] = (float)gateGain * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+    }
+
+    detector.gateEnvelope = gateEnvelope; detector.gateGain = gateGain;
+    detector.gateHoldCounter = gateHoldCounter; detector.gateOpen = gateOpen;
+    detector.hpfX1 = hpfX1; detector.hpfX2 = hpfX2; detector.hpfY1 = hpfY1; detector.hpfY2 = hpfY2;
+    detector.rmsState = rmsState; detector.envelopeLevel = envelopeLevel;
+    detector.prevGainReductionDb = prevGainReductionDb; detector.overshootDb = overshootDb;
+    detector.overshootHoldCounter = overshootHoldCounter;
+    detector.rmsState2 = rmsState2; detector.envelopeLevel2 = envelopeLevel2;
+    detector.prevGainReductionDb2 = prevGainReductionDb2; detector.overshootDb2 = overshootDb2;
+    detector.overshootHoldCounter2 = overshootHoldCounter2;
+
+    return peakGainReductionDb;
+}
+
+float VX1ExtensionDSPKernel::processDetectorLinked(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                                   AUAudioFrameCount frameOffset, int frames) {
+    // --- Stage 1: mono sums for gate (|x|) and sidechain (x) ---
+    sumDetectorChannels(inputBuffers, sidechainBuffers, frameOffset, frames);
+
+    if (sidechainDecimationActive()) {
+        mDetectorDecimated.syncStateFrom(mDetector);
+        const float peakGainReductionDb = runDecimatedLinkedDetector(frames);
+        mDetector.syncStateFrom(mDetectorDecimated);
+        return peakGainReductionDb;
+    }
+    if (mDetectorPrecision == DetectorPrecision::single) {
+        return runLinkedDetector<float>(mDetector, frames);
+    }
+    // The double detector picks up whatever moved mDetector since its last block
+    mDetectorWide.syncStateFrom(mDetector);
+    const float peakGainReductionDb = runLinkedDetector<double>(mDetectorWide, frames);
+    mDetector.syncStateFrom(mDetectorWide);
+    return peakGainReductionDb;
+}
+
+float VX1ExtensionDSPKernel::runDecimatedLinkedDetector(int frames) {
+    const float* absMono = mScratch.data(mScratchAbsMono);
+    const float* mono    = mScratch.data(mScratchMono);
+    float* gate = mScratch.data(mScratchGate);
+    float* gain = mScratch.data(mScratchGain);
+
+    VX1DetectorStateT<double>& detector = mDetectorDecimated;
+    const int factor = mSidechainDecimation;
+    const float groupScale = 1.0f / (float)factor;
+
+    VX1ExtensionGainComputer gainComputer = mGainComputer;
+    const float gateThresholdLinear = gainComputer.gateThresholdLinear();
+    const double gripBlend = mParameters.gripPercent / 100.0;
+    double blendedAttackCoeff = detector.attackCoeff * (1.0 - gripBlend) + detector.instantCoeff * gripBlend;
+    double releaseCoeff = detector.releaseCoeff;
+    const bool stackEnabled = gainComputer.stackEnabled();
+    float stackMakeupGain = gainComputer.stackMakeupGain();
+
+    // Ramps are filled at the full rate; a step takes the value at its group's last sample,
+    // with the per-sample coefficients raised to the factor: exp(-1/(τ·fs))^D = exp(-D/(τ·fs))
+    const bool ramping = fillDetectorRamps(frames);
+    const float* thresholdRamp = rampRow(kRampThresholdDb);
+    const float* slopeRamp = rampRow(kRampSlope);
+    const float* attackRamp = rampRow(kRampAttackCoeff);
+    const float* releaseRamp = rampRow(kRampReleaseCoeff);
+
+    // Gate, pass 1, pass 2 and Stack makeup for the detector's current state
+    const auto currentGain = [&] {
+        float total = VX1ExtensionGainComputer::gain(gainComputer.gainReductionDb((float)detector.envelopeLevel)
+                                                     + (float)detector.overshootDb);
+        if (stackEnabled) {
+            total *= VX1ExtensionGainComputer::gain(gainComputer.gainReductionDb2((float)detector.envelopeLevel2)
+                                                    + (float)detector.overshootDb2);
+        }
+        return (float)detector.gateGain * total * stackMakeupGain;
+    };
+
+    SidechainDecimator decimator = mDecimator;
+    if (!decimator.primed) {
+        decimator = {};
+        decimator.gatePrevious = decimator.gateCurrent = (float)detector.gateGain;
+        decimator.gainPrevious = decimator.gainCurrent = currentGain();
+        decimator.primed = true;
+    }
+
+    float peakGainReductionDb = 0.0f;
+
+    for (int i = 0; i < frames; ++i) {
+        // The gain runs one group behind the detector, interpolated across the group
+        const float position = (float)(decimator.count + 1) * groupScale;
+        gate[i] = decimator.gatePrevious + (decimator.gateCurrent - decimator.gatePrevious) * position;
+        gain[i] = decimator.gainPrevious + (decimator.gainCurrent - decimator.gainPrevious) * position;
+
+        decimator.absPeak = std::max(decimator.absPeak, absMono[i]);
+        decimator.sum += mono[i];
+        if (++decimator.count < factor) continue;
+
+        if (ramping) {
+            gainComputer.rampCompression(thresholdRamp[i], slopeRamp[i]);
+            stackMakeupGain = gainComputer.stackMakeupGain();
+            blendedAttackCoeff = std::pow((double)attackRamp[i], factor) * (1.0 - gripBlend) + detector.instantCoeff * gripBlend;
+            releaseCoeff = std::pow((double)releaseRamp[i], factor);
+        }
+
+        // Noise gate on the group's peak
+        const double rawMono = decimator.absPeak;
+        if (rawMono > detector.gateEnvelope) {
+            detector.gateEnvelope = detector.gateAttackCoeff * detector.gateEnvelope + (1.0 - detector.gateAttackCoeff) * rawMono;
+        } else {
+            detector.gateEnvelope = detector.gateReleaseCoeff * detector.gateEnvelope + (1.0 - detector.gateReleaseCoeff) * rawMono;
+        }
+        if (detector.gateEnvelope >= gateThresholdLinear) {
+            detector.gateOpen = true;
+            detector.gateHoldCounter = detector.gateHoldSamples;
+            detector.gateGain = 1.0;
+        } else if (detector.gateHoldCounter > 0) {
+            detector.gateHoldCounter--;
+            detector.gateGain = 1.0;
+        } else {
+            detector.gateOpen = false;
+            detector.gateGain *= detector.gateReleaseCoeff;
+        }
+
+        // Sidechain HPF on the group's mean (the boxcar is the decimation low-pass)
+        const double monoSC = (double)decimator.sum * groupScale * detector.gateGain;
+        const double filteredSC = detector.hpfA0 * monoSC + detector.hpfA1 * detector.hpfX1 + detector.hpfA2 * detector.hpfX2
+                                - detector.hpfB1 * detector.hpfY1 - detector.hpfB2 * detector.hpfY2;
+        detector.hpfX2 = detector.hpfX1; detector.hpfX1 = monoSC;
+        detector.hpfY2 = detector.hpfY1; detector.hpfY1 = filteredSC;
+        const double absFiltered = std::abs(filteredSC);
+
+        // Detector + envelope
+        detector.rmsState = detector.rmsCoeff * detector.rmsState + (1.0 - detector.rmsCoeff) * (absFiltered * absFiltered);
+        const double detectionLevel = (std::sqrt(detector.rmsState) * (1.0 - gripBlend)) + (absFiltered * gripBlend);
+        const double coeff = (detectionLevel > detector.envelopeLevel) ? blendedAttackCoeff : releaseCoeff;
+        detector.envelopeLevel = coeff * detector.envelopeLevel + (1.0 - coeff) * detectionLevel;
+
+        // Gain computer and VCA overshoot, per step
+        const float gainReductionDb = gainComputer.gainReductionDb((float)detector.envelopeLevel);
+        if (gainReductionDb - detector.prevGainReductionDb > 3.0) {
+            detector.overshootDb = 3.0;
+            detector.overshootHoldCounter = detector.overshootHoldSamples;
+        }
+        detector.prevGainReductionDb = gainReductionDb;
+        if (detector.overshootHoldCounter > 0) {
+            detector.overshootHoldCounter--;
+        } else {
+            detector.overshootDb *= detector.overshootReleaseCoeff;
+        }
+        const float totalGainReductionDb = gainReductionDb + (float)detector.overshootDb;
+        const float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+        peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+        // Stack second pass on the post-pass-1 mono signal
+        float gainReductionTotal2 = 1.0f;
+        if (stackEnabled) {
+            const double absPost1 = std::abs(monoSC * gainReductionTotal);
+            detector.rmsState2 = detector.rmsCoeff * detector.rmsState2 + (1.0 - detector.rmsCoeff) * (absPost1 * absPost1);
+            const double detectionLevel2 = (std::sqrt(detector.rmsState2) * (1.0 - gripBlend)) + (absPost1 * gripBlend);
+            const double coeff2 = (detectionLevel2 > detector.envelopeLevel2) ? blendedAttackCoeff : releaseCoeff;
+            detector.envelopeLevel2 = coeff2 * detector.envelopeLevel2 + (1.0 - coeff2) * detectionLevel2;
+
+            const float gainReductionDb2 = gainComputer.gainReductionDb2((float)detector.envelopeLevel2);
+            if (gainReductionDb2 - detector.prevGainReductionDb2 > 3.0) {
+                detector.overshootDb2 = 3.0;
+                detector.overshootHoldCounter2 = detector.overshootHoldSamples;
+            }
+            detector.prevGainReductionDb2 = gainReductionDb2;
+            if (detector.overshootHoldCounter2 > 0) {
+                detector.overshootHoldCounter2--;
+            } else {
+                detector.overshootDb2 *= detector.overshootReleaseCoeff;
+            }
+            const float totalGainReductionDb2 = gainReductionDb2 + (float)detector.overshootDb2;
+            gainReductionTotal2 = VX1ExtensionGainComputer::gain(totalGainReductionDb2);
+            peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2);
+        }
+
+        decimator.gatePrevious = decimator.gateCurrent;
+        decimator.gateCurrent = (float)detector.gateGain;
+        decimator.gainPrevious = decimator.gainCurrent;
+        decimator.gainCurrent = (float)detector.gateGain * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+        decimator.absPeak = 0.0f;
+        decimator.sum = 0.0f;
+        decimator.count = 0;
+    }
+
+    mDecimator = decimator;
+    return peakGainReductionDb;
+}
+
+float VX1ExtensionDSPKernel::processDetectorLanes(std::span<float const*> inputBuffers, AUAudioFrameCount frameOffset, int frames) {
+    const int channelCount = (int)inputBuffers.size();
+    const bool unlinked = mSidechainLink == SidechainLink::unlinked;
+    const size_t rowStride = mScratchFrames;
+
+    float* gate = mScratch.data(mScratchGate);
+    float* gain = mScratch.data(mScratchGain);
+
+    VX1ExtensionGainComputer gainComputer = mGainComputer;
+    const float gateThresholdLinear = gainComputer.gateThresholdLinear();
+    const float gripBlend = mParameters.gripPercent / 100.0f;
+    float blendedAttackCoeff = mDetector.attackCoeff * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend;
+    float releaseCoeff = mDetector.releaseCoeff;
+    const bool stackEnabled = gainComputer.stackEnabled();
+    float stackMakeupGain = gainComputer.stackMakeupGain();
+
+    // Compress / speed ramps replace the hoisted values frame by frame
+    const bool ramping = fillDetectorRamps(frames);
+    const float* thresholdRamp = rampRow(kRampThresholdDb);
+    const float* slopeRamp = rampRow(kRampSlope);
+    const float* attackRamp = rampRow(kRampAttackCoeff);
+    const float* releaseRamp = rampRow(kRampReleaseCoeff);
+
+    std::array<const float*, kMaxChannels> in;
+    for (int channel = 0; channel < channelCount; ++channel) {
+        in[channel] = inputBuffers[channel] + frameOffset;
+    }
+
+    // Per-channel lanes (SoA) — the HPF and RMS detector always, everything else when unlinked
+    VX1ChannelState& lanes = mChannels;
+    alignas(64) float sidechain[kMaxChannels];   // gated input x·gate
+    alignas(64) float detection[kMaxChannels];   // RMS/peak blend of the filtered sidechain
+
+    // Max link: one gate and one envelope/gain track, driven by the loudest lane
+    float gateEnvelope = mDetector.gateEnvelope, gateGain = mDetector.gateGain;
+    int   gateHoldCounter = mDetector.gateHoldCounter;
+    bool  gateOpen = mDetector.gateOpen;
+    float envelopeLevel = mDetector.envelopeLevel;
+    float prevGainReductionDb = mDetector.prevGainReductionDb, overshootDb = mDetector.overshootDb;
+    int   overshootHoldCounter = mDetector.overshootHoldCounter;
+    float rmsState2 = mDetector.rmsState2, envelopeLevel2 = mDetector.envelopeLevel2;
+    float prevGainReductionDb2 = mDetector.prevGainReductionDb2, overshootDb2 = mDetector.overshootDb2;
+    int   overshootHoldCounter2 = mDetector.overshootHoldCounter2;
+
+    float peakGainReductionDb = 0.0f;
+
+    for (int i = 0; i < frames; ++i) {
+        if (ramping) {
+            gainComputer.rampCompression(thresholdRamp[i], slopeRamp[i]);
+            stackMakeupGain = gainComputer.stackMakeupGain();
+            blendedAttackCoeff = attackRamp[i] * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend;
+            releaseCoeff = releaseRamp[i];
+        }
+
+        // Noise gate: per lane, or once on the loudest channel
+        if (unlinked) {
+            for (int c = 0; c < channelCount; ++c) {
+                const float rawLevel = std::abs(in[c][i]);
+                const float gateCoeff = rawLevel > lanes.gateEnvelope[c] ? mDetector.gateAttackCoeff : mDetector.gateReleaseCoeff;
+                lanes.gateEnvelope[c] = gateCoeff * lanes.gateEnvelope[c] + (1.0f - gateCoeff) * rawLevel;
+                const bool above = lanes.gateEnvelope[c] >= gateThresholdLinear;
+                const int hold = lanes.gateHoldCounter[c];
+                lanes.gateHoldCounter[c] = above ? mDetector.gateHoldSamples : std::max(hold - 1, 0);
+                lanes.gateGain[c] = (above || hold > 0) ? 1.0f : lanes.gateGain[c] * mDetector.gateReleaseCoeff;
+                gate[c * rowStride + i] = lanes.gateGain[c];
+                sidechain[c] = in[c][i] * lanes.gateGain[c];
+            }
+        } else {
+            float rawLevel = 0.0f;
+            for (int c = 0; c < channelCount; ++c) rawLevel = std::max(rawLevel, std::abs(in[c][i]));
+            if (rawLevel > gateEnvelope) {
+                gateEnvelope = mDetector.gateAttackCoeff * gateEnvelope + (1.0f - mDetector.gateAttackCoeff) * rawLevel;
+            } else {
+                gateEnvelope = mDetector.gateReleaseCoeff * gateEnvelope + (1.0f - mDetector.gateReleaseCoeff) * rawLevel;
+            }
+            if (gateEnvelope >= gateThresholdLinear) {
+                gateOpen = true;
+                gateHoldCounter = mDetector.gateHoldSamples;
+                gateGain = 1.0f;
+            } else if (gateHoldCounter > 0) {
+                gateHoldCounter--;
+                gateGain = 1.0f;
+            } else {
+                gateOpen = false;
+                gateGain *= mDetector.gateReleaseCoeff;
+            }
+            gate[i] = gateGain;
+            for (int c = 0; c < channelCount; ++c) sidechain[c] = in[c][i] * gateGain;
+        }
+
+        // Sidechain HPF and RMS/peak detection, every lane
+        for (int c = 0; c < channelCount; ++c) {
+            const float x = sidechain[c];
+            const float filtered = mDetector.hpfA0 * x + mDetector.hpfA1 * lanes.hpfX1[c] + mDetector.hpfA2 * lanes.hpfX2[c]
+                                 - mDetector.hpfB1 * lanes.hpfY1[c] - mDetector.hpfB2 * lanes.hpfY2[c];
+            lanes.hpfX2[c] = lanes.hpfX1[c]; lanes.hpfX1[c] = x;
+            lanes.hpfY2[c] = lanes.hpfY1[c]; lanes.hpfY1[c] = filtered;
+            const float absFiltered = std::abs(filtered);
+            lanes.rmsState[c] = mDetector.rmsCoeff * lanes.rmsState[c] + (1.0f - mDetector.rmsCoeff) * (absFiltered * absFiltered);
+            detection[c] = (std::sqrt(lanes.rmsState[c]) * (1.0f - gripBlend)) + (absFiltered * gripBlend);
+        }
+
+        if (unlinked) {
+            // Envelope, gain computer, overshoot and Stack per lane
+            for (int c = 0; c < channelCount; ++c) {
+                const float coeff = (detection[c] > lanes.envelopeLevel[c]) ? blendedAttackCoeff : releaseCoeff;
+                lanes.envelopeLevel[c] = coeff * lanes.envelopeLevel[c] + (1.0f - coeff) * detection[c];
+                const float gainReductionDb = gainComputer.gainReductionDb(lanes.envelopeLevel[c]);
+
+                const bool jump = gainReductionDb - lanes.prevGainReductionDb[c] > 3.0f;
+                lanes.prevGainReductionDb[c] = gainReductionDb;
+                const int hold = jump ? mDetector.overshootHoldSamples : lanes.overshootHoldCounter[c];
+                const float overshoot = jump ? 3.0f : lanes.overshootDb[c];
+                lanes.overshootHoldCounter[c] = hold > 0 ? hold - 1 : 0;
+                lanes.overshootDb[c] = hold > 0 ? overshoot : overshoot * mDetector.overshootReleaseCoeff;
+                const float totalGainReductionDb = gainReductionDb + lanes.overshootDb[c];
+                const float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+                peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+                float gainReductionTotal2 = 1.0f;
+                if (stackEnabled) {
+                    const float absPost1 = std::abs(sidechain[c] * gainReductionTotal);
+                    lanes.rmsState2[c] = mDetector.rmsCoeff * lanes.rmsState2[c] + (1.0f - mDetector.rmsCoeff) * (absPost1 * absPost1);
+                    const float detectionLevel2 = (std::sqrt(lanes.rmsState2[c]) * (1.0f - gripBlend)) + (absPost1 * gripBlend);
+                    const float coeff2 = (detectionLevel2 > lanes.envelopeLevel2[c]) ? blendedAttackCoeff : releaseCoeff;
+                    lanes.envelopeLevel2[c] = coeff2 * lanes.envelopeLevel2[c] + (1.0f - coeff2) * detectionLevel2;
+                    const float gainReductionDb2 = gainComputer.gainReductionDb2(lanes.envelopeLevel2[c]);
+
+                    const bool jump2 = gainReductionDb2 - lanes.prevGainReductionDb2[c] > 3.0f;
+                    lanes.prevGainReductionDb2[c] = gainReductionDb2;
+                    const int hold2 = jump2 ? mDetector.overshootHoldSamples : lanes.overshootHoldCounter2[c];
+                    const float overshoot2 = jump2 ? 3.0f : lanes.overshootDb2[c];
+                    lanes.overshootHoldCounter2[c] = hold2 > 0 ? hold2 - 1 : 0;
+                    lanes.overshootDb2[c] = hold2 > 0 ? overshoot2 : overshoot2 * mDetector.overshootReleaseCoeff;
+                    const float totalGainReductionDb2 = gainReductionDb2 + lanes.overshootDb2[c];
+                    gainReductionTotal2 = VX1ExtensionGainComputer::gain(totalGainReductionDb2);
+                    peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2);
+                }
+
+                gain[c * rowStride + i] = lanes.gateGain[c] * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+            }
+            continue;
+        }
+
+        // Max link: the loudest lane's detection drives the shared envelope
+        float detectionLevel = 0.0f, absSidechain = 0.0f;
+        for (int c = 0; c < channelCount; ++c) {
+            detectionLevel = std::max(detectionLevel, detection[c]);
+            absSidechain = std::max(absSidechain, std::abs(sidechain[c]));
+        }
+        const float coeff = (detectionLevel > envelopeLevel) ? blendedAttackCoeff : releaseCoeff;
+        envelopeLevel = coeff * envelopeLevel + (1.0f - coeff) * detectionLevel;
+        const float gainReductionDb = gainComputer.gainReductionDb(envelopeLevel);
+
+        if (gainReductionDb - prevGainReductionDb > 3.0f) {
+            overshootDb = 3.0f;
+            overshootHoldCounter = mDetector.overshootHoldSamples;
+        }
+        prevGainReductionDb = gainReductionDb;
+        if (overshootHoldCounter > 0) {
+            overshootHoldCounter--;
+        } else {
+            overshootDb *= mDetector.overshootReleaseCoeff;
+        }
+        const float totalGainReductionDb = gainReductionDb + overshootDb;
+        const float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+        peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+        // Stack second pass on the loudest post-pass-1 channel
+        float gainReductionTotal2 = 1.0f;
+        if (stackEnabled) {
+            const float absPost1 = absSidechain * gainReductionTotal;
+            rmsState2 = mDetector.rmsCoeff * rmsState2 + (1.0f - mDetector.rmsCoeff) * (absPost1 * absPost1);
+            const float detectionLevel2 = (std::sqrt(rmsState2) * (1.0f - gripBlend)) + (absPost1 * gripBlend);
+            const float coeff2 = (detectionLevel2 > envelopeLevel2) ? blendedAttackCoeff : releaseCoeff;
+            envelopeLevel2 = coeff2 * envelopeLevel2 + (1.0f - coeff2) * detectionLevel2;
+            const float gainReductionDb2 = gainComputer.gainReductionDb2(envelopeLevel2);
+
+            if (gainReductionDb2 - prevGainReductionDb2 > 3.0f) {
+                overshootDb2 = 3.0f;
+                overshootHoldCounter2 = mDetector.overshootHoldSamples;
+            }
+            prevGainReductionDb2 = gainReductionDb2;
+            if (overshootHoldCounter2 > 0) {
+                overshootHoldCounter2--;
+            } else {
+                overshootDb2 *= mDetector.overshootReleaseCoeff;
+            }
+            const float totalGainReductionDb2 = gainReductionDb2 + overshootDb2;
+            gainReductionTotal2 = VX1ExtensionGainComputer::gain(totalGainReductionDb2);
+            peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2);
+        }
+
+        gain[i] = gateGain * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
+    }
+
+    if (!unlinked) {
+        mDetector.gateEnvelope = gateEnvelope; mDetector.gateGain = gateGain;
+        mDetector.gateHoldCounter = gateHoldCounter; mDetector.gateOpen = gateOpen;
+        mDetector.envelopeLevel = envelopeLevel;
+        mDetector.prevGainReductionDb = prevGainReductionDb; mDetector.overshootDb = overshootDb;
+        mDetector.overshootHoldCounter = overshootHoldCounter;
+        mDetector.rmsState2 = rmsState2; mDetector.envelopeLevel2 = envelopeLevel2;
+        mDetector.prevGainReductionDb2 = prevGainReductionDb2; mDetector.overshootDb2 = overshootDb2;
+        mDetector.overshootHoldCounter2 = overshootHoldCounter2;
+    }
+
+    return peakGainReductionDb;
+}
+
+float VX1ExtensionDSPKernel::processDetectorMultiband(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                                      AUAudioFrameCount frameOffset, int frames) {
+    using namespace vx1::simd;
+    constexpr int kBands = VX1Crossover::kMaxBands;
+
+    const float* absMono = mScratch.data(mScratchAbsMono);
+    float* mono = mScratch.data(mScratchMono);
+    float* gate = mScratch.data(mScratchGate);
+    float* sidechain = mScratch.data(mScratchBands);
+    float* bandGain = mScratch.data(mScratchBandGain);
+
+    sumDetectorChannels(inputBuffers, sidechainBuffers, frameOffset, frames);
+
+    // Pass 1: gate and sidechain HPF, the filtered sidechain written over mono[]
+    const float gateThresholdLinear = mGainComputer.gateThresholdLinear();
+    float gateEnvelope = mDetector.gateEnvelope, gateGain = mDetector.gateGain;
+    int   gateHoldCounter = mDetector.gateHoldCounter;
+    bool  gateOpen = mDetector.gateOpen;
+    float hpfX1 = mDetector.hpfX1, hpfX2 = mDetector.hpfX2, hpfY1 = mDetector.hpfY1, hpfY2 = mDetector.hpfY2;
+    for (int i = 0; i < frames; ++i) {
+        const float rawMono = absMono[i];
+        if (rawMono > gateEnvelope) {
+            gateEnvelope = mDetector.gateAttackCoeff * gateEnvelope + (1.0f - mDetector.gateAttackCoeff) * rawMono;
+        } else {
+            gateEnvelope = mDetector.gateReleaseCoeff * gateEnvelope + (1.0f - mDetector.gateReleaseCoeff) * rawMono;
+        }
+        if (gateEnvelope >= gateThresholdLinear) {
+            gateOpen = true;
+            gateHoldCounter = mDetector.gateHoldSamples;
+            gateGain = 1.0f;
+        } else if (gateHoldCounter > 0) {
+            gateHoldCounter--;
+            gateGain = 1.0f;
+        } else {
+            gateOpen = false;
+            gateGain *= mDetector.gateReleaseCoeff;
+        }
+        gate[i] = gateGain;
+
+        const float monoSC = mono[i] * gateGain;
+        const float filteredSC = mDetector.hpfA0 * monoSC + mDetector.hpfA1 * hpfX1 + mDetector.hpfA2 * hpfX2
+                               - mDetector.hpfB1 * hpfY1 - mDetector.hpfB2 * hpfY2;
+        hpfX2 = hpfX1; hpfX1 = monoSC;
+        hpfY2 = hpfY1; hpfY1 = filteredSC;
+        mono[i] = filteredSC;
+    }
+    mDetector.gateEnvelope = gateEnvelope; mDetector.gateGain = gateGain;
+    mDetector.gateHoldCounter = gateHoldCounter; mDetector.gateOpen = gateOpen;
+    mDetector.hpfX1 = hpfX1; mDetector.hpfX2 = hpfX2; mDetector.hpfY1 = hpfY1; mDetector.hpfY2 = hpfY2;
+
+    // Pass 2: the band split, frame-major
+    mCrossover.process(mono, sidechain, frames, mSidechainSplit);
+
+    // Pass 3: detector, envelope, gain computer and overshoot, every band lane at once
+    VX1ExtensionGainComputer gainComputer = mGainComputer;
+    const float gripBlend = mParameters.gripPercent / 100.0f;
+    const Float4 zero = broadcast4(0.0f), one = broadcast4(1.0f), jumpDb = broadcast4(3.0f);
+    const Float4 rmsCoeff = broadcast4(mDetector.rmsCoeff), rmsInput = broadcast4(1.0f - mDetector.rmsCoeff);
+    const Float4 rmsWeight = broadcast4(1.0f - gripBlend), peakWeight = broadcast4(gripBlend);
+    const Float4 holdFrames = broadcast4((float)mDetector.overshootHoldSamples);
+    const Float4 overshootRelease = broadcast4(mDetector.overshootReleaseCoeff);
+    Float4 attackCoeff = broadcast4(mDetector.attackCoeff * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend);
+    Float4 releaseCoeff = broadcast4(mDetector.releaseCoeff);
+
+    // Compress / speed ramps replace the hoisted values frame by frame
+    const bool ramping = fillDetectorRamps(frames);
+    const float* thresholdRamp = rampRow(kRampThresholdDb);
+    const float* slopeRamp = rampRow(kRampSlope);
+    const float* attackRamp = rampRow(kRampAttackCoeff);
+    const float* releaseRamp = rampRow(kRampReleaseCoeff);
+
+    VX1BandState& bands = mBands;
+    Float4 rms = load4(bands.rmsState), envelope = load4(bands.envelopeLevel);
+    Float4 prevGainReductionDb = load4(bands.prevGainReductionDb);
+    Float4 overshootDb = load4(bands.overshootDb), overshootHold = load4(bands.overshootHoldCounter);
+    Float4 peakGainReductionDb = zero;
+
+    for (int i = 0; i < frames; ++i) {
+        if (ramping) {
+            gainComputer.rampCompression(thresholdRamp[i], slopeRamp[i]);
+            attackCoeff = broadcast4(attackRamp[i] * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend);
+            releaseCoeff = broadcast4(releaseRamp[i]);
+        }
+
+        const Float4 absBand = abs(load4(sidechain + (size_t)i * kBands));
+        rms = rmsCoeff * rms + rmsInput * (absBand * absBand);
+        const Float4 detection = sqrt(rms) * rmsWeight + absBand * peakWeight;
+        const Float4 coeff = select(greater(detection, envelope), attackCoeff, releaseCoeff);
+        envelope = coeff * envelope + (one - coeff) * detection;
+        const Float4 gainReductionDb = gainComputer.gainReductionDb(envelope);
+
+        // VCA overshoot, branch-free: a jump re-arms the hold and the 3 dB overshoot
+        const Float4 jump = greater(gainReductionDb - prevGainReductionDb, jumpDb);
+        prevGainReductionDb = gainReductionDb;
+        const Float4 hold = select(jump, holdFrames, overshootHold);
+        const Float4 overshoot = select(jump, jumpDb, overshootDb);
+        overshootHold = max(hold - one, zero);
+        overshootDb = select(greater(hold, zero), overshoot, overshoot * overshootRelease);
+
+        const Float4 totalGainReductionDb = gainReductionDb + overshootDb;
+        peakGainReductionDb = max(peakGainReductionDb, totalGainReductionDb);
+        store(bandGain + (size_t)i * kBands, broadcast4(gate[i]) * VX1ExtensionGainComputer::gain(totalGainReductionDb));
+    }
+
+    store(bands.rmsState, rms);
+    store(bands.envelopeLevel, envelope);
+    store(bands.prevGainReductionDb, prevGainReductionDb);
+    store(bands.overshootDb, overshootDb);
+    store(bands.overshootHoldCounter, overshootHold);
+
+    alignas(16) float peaks[kBands];
+    store(peaks, peakGainReductionDb);
+    return *std::max_element(peaks, peaks + kBands);
+}
+
+void VX1ExtensionDSPKernel::applyBandGains(const float* in, float* wet, int channel, int frames) {
+    using namespace vx1::simd;
+    constexpr int kBands = VX1Crossover::kMaxBands;
+
+    float* bands = mScratch.data(mScratchBands);
+    const float* bandGain = mScratch.data(mScratchBandGain);
+    mCrossover.process(in, bands, frames, mBandSplits[channel]);
+    for (int i = 0; i < frames; ++i) {
+        alignas(16) float weighted[kBands];
+        store(weighted, load4(bands + (size_t)i * kBands) * load4(bandGain + (size_t)i * kBands));
+        wet[i] = (weighted[0] + weighted[1]) + (weighted[2] + weighted[3]);
+    }
+}
+
+// MARK: - Block Engine: Specialized Variants
+
+namespace {
+
+using BlockVariantFunction = VX1ExtensionDSPKernel::BlockVariantFunction;
+
+/// Variant table index: channels (0 any, 1, 2) · 16 + stack · 8 + gate · 4 + bite · 2 + fullWet.
+constexpr int blockVariantIndex(const VX1ExtensionDSPKernel::BlockVariant& variant) {
+    return variant.channels * 16 + (variant.stack ? 8 : 0) + (variant.gate ? 4 : 0)
+         + (variant.bite ? 2 : 0) + (variant.fullWet ? 1 : 0);
+}
+
+template <int Index>
+constexpr BlockVariantFunction blockVariantAt() {
+    return &VX1ExtensionDSPKernel::processBlockVariant<Index / 16, (Index & 8) != 0, (Index & 4) != 0,
+                                                       (Index & 2) != 0, (Index & 1) != 0>;
+}
+
+template <int... Indices>
+constexpr std::array<BlockVariantFunction, sizeof...(Indices)> makeBlockVariantTable(std::integer_sequence<int, Indices...>) {
+    return { blockVariantAt<Indices>()... };
+}
+
+// Every combination, instantiated once
+constexpr auto kBlockVariants = makeBlockVariantTable(std::make_integer_sequence<int, 48>());
+
+}
+
+VX1ExtensionDSPKernel::BlockVariantFunction VX1ExtensionDSPKernel::selectBlockVariant(int channelCount, int frameCount) const {
+    if (mSidechainLink == SidechainLink::unlinked || mSidechainLink == SidechainLink::max) return nullptr;
+    if (mOversamplingFactor > 1 || mBandCount > 1 || mSidechainSource != SidechainSource::internal) return nullptr;
+    if (!detectorIsStandard()) return nullptr;
+    if (mSmoothedThresholdDb.isRamping() || mSmoothedSlope.isRamping() || mSmoothedAttackCoeff.isRamping()
+        || mSmoothedReleaseCoeff.isRamping() || mSmoothedMakeupGain.isRamping() || mSmoothedMixWet.isRamping()) {
+        return nullptr;
+    }
+
+    BlockVariant variant;
+    variant.channels = channelCount <= 2 ? channelCount : 0;
+    variant.stack = mGainComputer.stackEnabled();
+    // Open with hold to spare: every frame either re-opens it or counts the hold down,
+    // and the hold cannot run out before the block ends, so the gain stays exactly 1
+    variant.gate = !(mDetector.gateOpen && mDetector.gateGain == 1.0f && mDetector.gateHoldCounter >= frameCount);
+    variant.bite = mBite.blend > 0.0f;
+    variant.fullWet = mParameters.mixPercent >= 100.0f;
+    return kBlockVariants[blockVariantIndex(variant)];
+}
+
+template <int Channels, bool Stack, bool Gate, bool Bite, bool FullWet>
+float VX1ExtensionDSPKernel::processBlockVariant(std::span<float const*> inputBuffers, std::span<float *> outputBuffers,
+                                                 AUAudioFrameCount frameOffset, int frames) {
+    using namespace vx1::simd;
+
+    const int vecFrames = vectorFrames(frames);
+    const int channelCount = Channels > 0 ? Channels : (int)inputBuffers.size();
+
+    float* absMono = mScratch.data(mScratchAbsMono);
+    float* mono    = mScratch.data(mScratchMono);
+    float* gate    = mScratch.data(mScratchGate);
+    float* gain    = mScratch.data(mScratchGain);
+
+    uint64_t stageStart = vx1::perf::stamp();
+
+    // --- Stage 1: mono sums for gate (|x|) and sidechain (x) ---
+    const float* sidechain = mono;
+    if constexpr (Channels == 1) {
+        // The sidechain is the input itself
+        const float* in = inputBuffers[0] + frameOffset;
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            store(absMono + i, abs(load(in + i)));
+        }
+        for (; i < frames; ++i) {
+            absMono[i] = std::abs(in[i]);
+        }
+        sidechain = in;
+    } else if constexpr (Channels == 2) {
+        const float* left = inputBuffers[0] + frameOffset;
+        const float* right = inputBuffers[1] + frameOffset;
+        const FloatVec half = broadcast(0.5f);
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            const FloatVec l = load(left + i), r = load(right + i);
+            store(absMono + i, (abs(l) + abs(r)) * half);
+            store(mono + i, (l + r) * half);
+        }
+        for (; i < frames; ++i) {
+            absMono[i] = (std::abs(left[i]) + std::abs(right[i])) * 0.5f;
+            mono[i] = (left[i] + right[i]) * 0.5f;
+        }
+    } else {
+        const int detectorChannels = detectorChannelCount(channelCount);
+        std::fill_n(absMono, frames, 0.0f);
+        std::fill_n(mono, frames, 0.0f);
+        for (int channel = 0; channel < detectorChannels; ++channel) {
+            const float* in = inputBuffers[channel] + frameOffset;
+            int i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                FloatVec x = load(in + i);
+                store(absMono + i, load(absMono + i) + abs(x));
+                store(mono + i, load(mono + i) + x);
+            }
+            for (; i < frames; ++i) {
+                absMono[i] += std::abs(in[i]);
+                mono[i] += in[i];
+            }
+        }
+        if (detectorChannels > 1) {
+            const float channelScale = (float)detectorChannels;
+            for (int i = 0; i < frames; ++i) {
+                absMono[i] /= channelScale;
+                mono[i] /= channelScale;
+            }
+        }
+    }
+
+    // --- Stage 2: detector / gain computer recursion (no ramps in flight) ---
+    const VX1ExtensionGainComputer& gainComputer = mGainComputer;
+    const float gateThresholdLinear = gainComputer.gateThresholdLinear();
+    const float gripBlend = mParameters.gripPercent / 100.0f;
+    const float blendedAttackCoeff = mDetector.attackCoeff * (1.0f - gripBlend) + mDetector.instantCoeff * gripBlend;
+    const float releaseCoeff = mDetector.releaseCoeff;
+    const float stackMakeupGain = gainComputer.stackMakeupGain();
+
+    float gateEnvelope = mDetector.gateEnvelope, gateGain = mDetector.gateGain;
+    int   gateHoldCounter = mDetector.gateHoldCounter;
+    bool  gateOpen = mDetector.gateOpen;
+    float hpfX1 = mDetector.hpfX1, hpfX2 = mDetector.hpfX2, hpfY1 = mDetector.hpfY1, hpfY2 = mDetector.hpfY2;
+    float rmsState = mDetector.rmsState, envelopeLevel = mDetector.envelopeLevel;
+    float prevGainReductionDb = mDetector.prevGainReductionDb, overshootDb = mDetector.overshootDb;
+    int   overshootHoldCounter = mDetector.overshootHoldCounter;
+    float rmsState2 = mDetector.rmsState2, envelopeLevel2 = mDetector.envelopeLevel2;
+    float prevGainReductionDb2 = mDetector.prevGainReductionDb2, overshootDb2 = mDetector.overshootDb2;
+    int   overshootHoldCounter2 = mDetector.overshootHoldCounter2;
+
+    float peakGainReductionDb = 0.0f;
+
+    for (int i = 0; i < frames; ++i) {
+        // Noise gate. Held open, only its envelope and hold count move
+        const float rawMono = absMono[i];
+        const float gateCoeff = rawMono > gateEnvelope ? mDetector.gateAttackCoeff : mDetector.gateReleaseCoeff;
+        gateEnvelope = gateCoeff * gateEnvelope + (1.0f - gateCoeff) * rawMono;
+        if constexpr (Gate) {
+            if (gateEnvelope >= gateThresholdLinear) {
+                gateOpen = true;
+                gateHoldCounter = mDetector.gateHoldSamples;
+                gateGain = 1.0f;
+            } else if (gateHoldCounter > 0) {
+                gateHoldCounter--;
+                gateGain = 1.0f;
+            } else {
+                gateOpen = false;
+                gateGain *= mDetector.gateReleaseCoeff;
+            }
+            gate[i] = gateGain;
+        } else {
+            gateHoldCounter = gateEnvelope >= gateThresholdLinear ? mDetector.gateHoldSamples : gateHoldCounter - 1;
+        }
+
+        // Sidechain HPF
+        const float monoSC = Gate ? sidechain[i] * gateGain : sidechain[i];
+        const float filteredSC = mDetector.hpfA0 * monoSC + mDetector.hpfA1 * hpfX1 + mDetector.hpfA2 * hpfX2
+                               - mDetector.hpfB1 * hpfY1 - mDetector.hpfB2 * hpfY2;
+        hpfX2 = hpfX1; hpfX1 = monoSC;
+        hpfY2 = hpfY1; hpfY1 = filteredSC;
+        const float absFiltered = std::abs(filteredSC);
+
+        // Detector + envelope
+        rmsState = mDetector.rmsCoeff * rmsState + (1.0f - mDetector.rmsCoeff) * (absFiltered * absFiltered);
+        const float detectionLevel = (std::sqrt(rmsState) * (1.0f - gripBlend)) + (absFiltered * gripBlend);
+        const float coeff = (detectionLevel > envelopeLevel) ? blendedAttackCoeff : releaseCoeff;
+        envelopeLevel = coeff * envelopeLevel + (1.0f - coeff) * detectionLevel;
+
+        // Gain computer (hard knee)
+        const float gainReductionDb = gainComputer.gainReductionDb(envelopeLevel);
+
+        // VCA overshoot
+        if (gainReductionDb - prevGainReductionDb > 3.0f) {
+            overshootDb = 3.0f;
+            overshootHoldCounter = mDetector.overshootHoldSamples;
+        }
+        prevGainReductionDb = gainReductionDb;
+        if (overshootHoldCounter > 0) {
+            overshootHoldCounter--;
+        } else {
+            overshootDb *= mDetector.overshootReleaseCoeff;
+        }
+        const float totalGainReductionDb = gainReductionDb + overshootDb;
+        const float gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+        peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
+
+        // Stack second pass on the post-pass-1 mono signal
+        float frameGain = Gate ? gateGain * gainReductionTotal : gainReductionTotal;
+        if constexpr (Stack) {
+            const float absPost1 = std::abs(monoSC * gainReductionTotal);
+            rmsState2 = mDetector.rmsCoeff * rmsState2 + (1.0f - mDetector.rmsCoeff) * (absPost1 * absPost1);
+            const float detectionLevel2 = (std::sqrt(rmsState2) * (1.0f - gripBlend)) + (absPost1 * gripBlend);
+            const float coeff2 = (detectionLevel2 > envelopeLevel2) ? blendedAttackCoeff : releaseCoeff;
+            envelopeLevel2 = coeff2 * envelopeLevel2 + (1.0f - coeff2) * detectionLevel2;
+
+            const float gainReductionDb2 = gainComputer.gainReductionDb2(envelopeLevel2);
+
+            if (gainReductionDb2 - prevGainReductionDb2 > 3.0f) {
+                overshootDb2 = 3.0f;
+                overshootHoldCounter2 = mDetector.overshootHoldSamples;
+            }
+            prevGainReductionDb2 = gainReductionDb2;
+            if (overshootHoldCounter2 > 0) {
+                overshootHoldCounter2--;
+            } else {
+                overshootDb2 *= mDetector.overshootReleaseCoeff;
+            }
+            const float totalGainReductionDb2 = gainReductionDb2 + overshootDb2;
+            frameGain = frameGain * VX1ExtensionGainComputer::gain(totalGainReductionDb2) * stackMakeupGain;
+
+            peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2);
+        }
+        gain[i] = frameGain;
+    }
+
+    mDetector.gateEnvelope = gateEnvelope; mDetector.gateGain = gateGain;
+    mDetector.gateHoldCounter = gateHoldCounter; mDetector.gateOpen = gateOpen;
+    mDetector.hpfX1 = hpfX1; mDetector.hpfX2 = hpfX2; mDetector.hpfY1 = hpfY1; mDetector.hpfY2 = hpfY2;
+    mDetector.rmsState = rmsState; mDetector.envelopeLevel = envelopeLevel;
+    mDetector.prevGainReductionDb = prevGainReductionDb; mDetector.overshootDb = overshootDb;
+    mDetector.overshootHoldCounter = overshootHoldCounter;
+    if constexpr (Stack) {
+        mDetector.rmsState2 = rmsState2; mDetector.envelopeLevel2 = envelopeLevel2;
+        mDetector.prevGainReductionDb2 = prevGainReductionDb2; mDetector.overshootDb2 = overshootDb2;
+        mDetector.overshootHoldCounter2 = overshootHoldCounter2;
+    }
+
+    uint64_t stageEnd = vx1::perf::stamp();
+    mPerf.recordStage(VX1PerfStage::detector, stageEnd - stageStart);
+    stageStart = stageEnd;
+
+    // --- Stage 3: per-channel gain, saturation, makeup and mix ---
+    std::array<float*, kMaxChannels> wetRows;
+    if constexpr (Bite) {
+        for (int channel = 0; channel < channelCount; ++channel) {
+            const float* in = inputBuffers[channel] + frameOffset;
+            float* wet = mScratch.data(mScratchWet) + channel * mScratchFrames;
+            wetRows[channel] = wet;
+            int i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                store(wet + i, load(in + i) * load(gain + i));
+            }
+            for (; i < frames; ++i) {
+                wet[i] = in[i] * gain[i];
+            }
+        }
+        applySaturationBlock(std::span<float* const>(wetRows.data(), (size_t)channelCount), frames);
+
+        stageEnd = vx1::perf::stamp();
+        mPerf.recordStage(VX1PerfStage::saturation, stageEnd - stageStart);
+        stageStart = stageEnd;
+    }
+
+    // Without Bite the wet path is input × gain, computed here instead of through a scratch row
+    const float mixWet = mParameters.mixPercent / 100.0f;
+    const float wetGain = mMakeupGainLinear * mixWet;
+    const FloatVec vMixDry = broadcast(1.0f - mixWet);
+    const FloatVec vWetGain = broadcast(wetGain);
+    for (int channel = 0; channel < channelCount; ++channel) {
+        const float* in = inputBuffers[channel] + frameOffset;
+        float* out = outputBuffers[channel] + frameOffset;
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            const FloatVec wet = Bite ? load(wetRows[channel] + i) : load(in + i) * load(gain + i);
+            if constexpr (FullWet) {
+                store(out + i, wet * vWetGain);
+            } else {
+                const FloatVec dry = Gate ? load(in + i) * load(gate + i) : load(in + i);
+                store(out + i, dry * vMixDry + wet * vWetGain);
+            }
+        }
+        for (; i < frames; ++i) {
+            const float wet = Bite ? wetRows[channel][i] : in[i] * gain[i];
+            if constexpr (FullWet) {
+                out[i] = wet * wetGain;
+            } else {
+                const float dry = Gate ? in[i] * gate[i] : in[i];
+                out[i] = dry * (1.0f - mixWet) + wet * wetGain;
+            }
+        }
+    }
+
+    mPerf.recordStage(VX1PerfStage::mix, vx1::perf::stamp() - stageStart);
+    return peakGainReductionDb;
+}
+
+void VX1ExtensionDSPKernel::applySaturationBlock(std::span<float* const> buffers, int frameCount) {
+    using namespace vx1::simd;
+
+    // Oversampled, the filters keep running at Bite 0% so the latency never jumps
+    const bool oversampled = mOversamplingFactor > 1;
+    if (mBite.blend <= 0.0f && !oversampled) return;
+
+    const int channelCount = (int)buffers.size();
+    assert(channelCount <= mChannelCount);
+    const float blend            = mBite.blend;
+    const float compensationGain = mBite.compensationGain;
+
+    // Three or more channels at the base rate: every stage runs across channel lanes in
+    // one pass. Mono and stereo don't fill enough lanes to pay for the shuffle, and the
+    // oversamplers work per channel, so those run channel by channel below.
+    if (channelCount > 2 && !oversampled) {
+        const int laneStride = (channelCount + kWidth - 1) / kWidth * kWidth;
+        float* lanes = mScratch.data(mScratchLanes);
+        interleaveLanes(buffers, lanes, laneStride, frameCount);
+        applySaturationLanes(lanes, laneStride, frameCount);
+
+        // Stage 4 while de-interleaving: gain compensation and dry/wet blend
+        for (int i = 0; i < frameCount; ++i) {
+            const float* frame = lanes + (size_t)i * laneStride;
+            for (int channel = 0; channel < channelCount; ++channel) {
+                float& sample = buffers[channel][i];
+                sample = sample * (1.0f - blend) + (frame[channel] * compensationGain) * blend;
+            }
+        }
+        return;
+    }
+
+    const int vecFrames = vectorFrames(frameCount);
+    const FloatVec vDry = broadcast(1.0f - blend);
+    const FloatVec vComp = broadcast(compensationGain);
+    const FloatVec vBlend = broadcast(blend);
+    float* shaped = mScratch.data(mScratchShaped);
+
+    for (int channel = 0; channel < channelCount; ++channel) {
+        float* buffer = buffers[channel];
+
+        // Stage 1a: pre-emphasis shelf scaled in with the Bite amount (recursive)
+        shelfChannel(buffer, shaped, frameCount, mShelfB0Pre, mShelfB1Pre, mShelfA1Pre, blend,
+                     mChannels.preX1[channel], mChannels.preY1[channel]);
+
+        // Stages 2 + 3: wave shaper and grit, at the base rate or oversampled
+        if (oversampled) {
+            float* oversampledBuffer = mScratch.data(mScratchOversampled);
+            mOversamplers[channel].upsample(shaped, oversampledBuffer, frameCount);
+            applyBiteShaper(oversampledBuffer, frameCount * mOversamplingFactor);
+            mOversamplers[channel].downsample(oversampledBuffer, shaped, frameCount);
+            // Align the dry half of the Stage 4 blend with the filtered wet half
+            mBiteDryDelay[channel].process(buffer, frameCount);
+        } else {
+            applyBiteShaper(shaped, frameCount);
+        }
+
+        // Stage 1b: de-emphasis shelf (recursive)
+        shelfChannel(shaped, shaped, frameCount, mShelfB0De, mShelfB1De, mShelfA1De, blend,
+                     mChannels.deX1[channel], mChannels.deY1[channel]);
+
+        // Stage 4: gain compensation and dry/wet blend
+        int i = 0;
+        for (; i < vecFrames; i += kWidth) {
+            store(buffer + i, load(buffer + i) * vDry + (load(shaped + i) * vComp) * vBlend);
+        }
+        for (; i < frameCount; ++i) {
+            buffer[i] = buffer[i] * (1.0f - blend) + (shaped[i] * compensationGain) * blend;
+        }
+    }
+}
+
+void VX1ExtensionDSPKernel::applySaturationLanes(float* lanes, int laneStride, int frameCount) {
+    using namespace vx1::simd;
+    using vx1::fastmath::kSaturationPrecision;
+
+    const FloatVec vBlend = broadcast(mBite.blend);
+    const FloatVec vB0Pre = broadcast(mShelfB0Pre), vB1Pre = broadcast(mShelfB1Pre), vA1Pre = broadcast(mShelfA1Pre);
+    const FloatVec vB0De = broadcast(mShelfB0De), vB1De = broadcast(mShelfB1De), vA1De = broadcast(mShelfA1De);
+    const FloatVec vDcOffset = broadcast(mBite.dcOffset);
+    const FloatVec vDrive = broadcast(mBite.drive);
+    const FloatVec vScale = broadcast(1.3f);
+    const FloatVec vShapedDc = broadcast(mBite.shapedDc);
+    const FloatVec vGritAmt = broadcast(mBite.gritAmt);
+
+    for (int lane = 0; lane < laneStride; lane += kWidth) {
+        FloatVec preX1 = load(mChannels.preX1 + lane), preY1 = load(mChannels.preY1 + lane);
+        FloatVec deX1 = load(mChannels.deX1 + lane), deY1 = load(mChannels.deY1 + lane);
+        float* frame = lanes + lane;
+        for (int i = 0; i < frameCount; ++i, frame += laneStride) {
+            // Stage 1a: pre-emphasis shelf, scaled in with the Bite amount
+            const FloatVec x = load(frame);
+            const FloatVec pre = vB0Pre * x + vB1Pre * preX1 - vA1Pre * preY1;
+            preX1 = x;
+            preY1 = pre;
+            const FloatVec emphasized = x + (pre - x) * vBlend;
+
+            // Stages 2 + 3: asymmetric shaper and cubic grit
+            const FloatVec s = tanh<kSaturationPrecision>((emphasized + vDcOffset) * vDrive * vScale) - vShapedDc;
+            const FloatVec withGrit = s + (s * s * s) * vGritAmt;
+
+            // Stage 1b: de-emphasis shelf
+            const FloatVec de = vB0De * withGrit + vB1De * deX1 - vA1De * deY1;
+            deX1 = withGrit;
+            deY1 = de;
+            store(frame, withGrit + (de - withGrit) * vBlend);
+        }
+        store(mChannels.preX1 + lane, preX1);
+        store(mChannels.preY1 + lane, preY1);
+        store(mChannels.deX1 + lane, deX1);
+        store(mChannels.deY1 + lane, deY1);
+    }
+}
+
+void VX1ExtensionDSPKernel::applyBiteShaper(float* buffer, int sampleCount) {
+    using namespace vx1::simd;
+    using vx1::fastmath::kSaturationPrecision;
+
+    const FloatVec vDcOffset = broadcast(mBite.dcOffset);
+    const FloatVec vDrive = broadcast(mBite.drive);
+    const FloatVec vScale = broadcast(1.3f);
+    const FloatVec vShapedDc = broadcast(mBite.shapedDc);
+    const FloatVec vGritAmt = broadcast(mBite.gritAmt);
+    const int vecSamples = vectorFrames(sampleCount);
+    int i = 0;
+    for (; i < vecSamples; i += kWidth) {
+        const FloatVec s = tanh<kSaturationPrecision>((load(buffer + i) + vDcOffset) * vDrive * vScale) - vShapedDc;
+        store(buffer + i, s + (s * s * s) * vGritAmt);
+    }
+    for (; i < sampleCount; ++i) {
+        const float s = vx1::fastmath::tanh<kSaturationPrecision>((buffer[i] + mBite.dcOffset) * mBite.drive * 1.3f) - mBite.shapedDc;
+        buffer[i] = s + (s * s * s) * mBite.gritAmt;
+    }
+}
@@ -7,91 +7,135 @@
 
 #pragma once
 
-#include <AudioToolbox/AudioToolbox.h>
 #include <algorithm>
-#include <span>
+#include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <span>
 #include <vector>
 
+#include "VX1ExtensionArena.hpp"
+#include "VX1ExtensionChannelState.hpp"
+#include "VX1ExtensionCrossover.hpp"
+#include "VX1ExtensionDelayLine.hpp"
+#include "VX1ExtensionDenormals.hpp"
+#include "VX1ExtensionDSPTypes.h"
+#include "VX1ExtensionGainComputer.hpp"
+#include "VX1ExtensionLookaheadLimiter.hpp"
+#include "VX1ExtensionOversampler.hpp"
+#include "VX1ExtensionParameterSmoother.hpp"
+#include "VX1ExtensionPerfCounters.hpp"
+#include "VX1ExtensionRealtime.hpp"
+#include "VX1ExtensionParameterTimeline.hpp"
+#include "VX1ExtensionTanh.hpp"
+#include "VX1ExtensionTelemetry.hpp"
+#include "VX1ExtensionTubeStage.hpp"
 #include "VX1ExtensionParameterAddresses.h"
 
 /*
  VX1ExtensionDSPKernel
  As a non-ObjC class, this is safe to use from render thread.
+ Pure C++20 with no Apple SDK dependency — the AU adapter (AUProcessHelper)
+ translates render events and buffer lists into calls on this class.
  */
 class VX1ExtensionDSPKernel {
 public:
-    void initialize(int inputChannelCount, int outputChannelCount, double inSampleRate) {
-        mSampleRate = inSampleRate;
-        mChannelCount = inputChannelCount;
-
-        // Initialize computed coefficients
-        mThresholdLinear = std::pow(10.0f, mThresholdDb / 20.0f);
-        mMakeupGainLinear = std::pow(10.0f, mMakeupGainDb / 20.0f);
-        mAttackCoeff = std::exp(-1.0f / (mAttackMs * 0.001f * mSampleRate));
-        mReleaseCoeff = std::exp(-1.0f / (mReleaseMs * 0.001f * mSampleRate));
-        // RMS detection: ~175ms squared-sample IIR window (averages across syllables, not individual transients)
-        mRmsCoeff = std::exp(-1.0f / (0.175f * (float)mSampleRate));
-        // Peak detection: ~2ms fast attack (aggressive on vocals without distortion artifacts)
-        mInstantCoeff = std::exp(-1.0f / (0.002f * (float)mSampleRate));
-
-        // GR overshoot timing (VCA punch): 0.5ms hold, 2ms exponential release
-        mOvershootReleaseCoeff = std::exp(-1.0f / (0.002f * (float)mSampleRate));
-        mOvershootHoldSamples  = static_cast<int>(0.0005f * mSampleRate);
-
-        // Noise gate timing: 0.5ms attack, 100ms release, 50ms hold
-        mGateAttackCoeff  = std::exp(-1.0f / (0.0005f * (float)mSampleRate));
-        mGateReleaseCoeff = std::exp(-1.0f / (0.100f  * (float)mSampleRate));
-        mGateHoldSamples  = static_cast<int>(0.050f   * mSampleRate);
-
-        // Compute sidechain HPF coefficients for current sample rate
-        computeHpfCoefficients();
-
-        // Allocate per-channel presence shelf state and compute coefficients
-        mPreX1.assign(inputChannelCount, 0.0f);
-        mPreY1.assign(inputChannelCount, 0.0f);
-        mDeX1.assign(inputChannelCount,  0.0f);
-        mDeY1.assign(inputChannelCount,  0.0f);
-        computePresenceCoefficients();
-
-        // Reset state
-        mEnvelopeLevel = 0.0f;
-        mRmsState = 0.0f;
-    }
-
-    void deInitialize() {
-        // Reset all state when deallocating
-        mEnvelopeLevel = 0.0f;
-        mCurrentGainReductionDb = 0.0f;
-
-        // Reset RMS detection state
-        mRmsState = 0.0f;
-
-        // Reset sidechain HPF state
-        mHpfX1 = mHpfX2 = mHpfY1 = mHpfY2 = 0.0f;
-
-        // Reset sheen saturation presence filter state
-        mPreX1.clear(); mPreY1.clear();
-        mDeX1.clear();  mDeY1.clear();
-
-        // Reset GR overshoot state
-        mPrevGainReductionDb = 0.0f;
-        mOvershootDb = 0.0f;
-        mOvershootHoldCounter = 0;
-
-        // Reset Stack second-pass state
-        mEnvelopeLevel2 = 0.0f;
-        mRmsState2 = 0.0f;
-        mPrevGainReductionDb2 = 0.0f;
-        mOvershootDb2 = 0.0f;
-        mOvershootHoldCounter2 = 0;
-
-        // Reset gate state
-        mGateEnvelope = 0.0f;
-        mGateGain = 1.0f;
-        mGateHoldCounter = 0;
-        mGateOpen = true;
-    }
+    /// Processing engine selection. Both produce the same sound; `block` runs the
+    /// staged, SIMD pipeline and is the default, `scalar` is the per-frame reference.
+    enum class Engine { scalar, block };
+
+    /**
+     Arithmetic of the linked detector recursion (gate → sidechain HPF → RMS/peak →
+     envelope → overshoot → Stack):
+       single  float, the default; the only one the block variants, the scalar engine
+               and VX1KernelBank implement
+       double  signal, coefficients and state in double (the reference)
+
+     Audio, the per-channel detector lanes (unlinked, max) and multiband stay float:
+     double only changes the `all` and `lcr` linked detector, and makes it run in the
+     generic block engine. There is no float-signal, double-state mode: the per-frame
+     float/double conversions made it cost more than all double for the same floor.
+     */
+    enum class DetectorPrecision { single, double_ };
+
+    /// Maximum absolute difference between the block and scalar engines' output.
+    static constexpr float kBlockEngineTolerance = 1e-5f;
+
+    /// Largest channel count initialize() accepts (one SoA lane per channel).
+    static constexpr int kMaxChannels = VX1ChannelState::kMaxChannels;
+
+    /**
+     How the sidechain detector combines channels (sidechainLink parameter):
+       all       mean of every channel drives one gain (the original stereo-linked behaviour)
+       lcr       mean of L, R and C only (channels 0–2, SMPTE/film order), so surrounds
+                 and LFE don't pump the front stage; same as `all` below 3 channels
+       unlinked  every channel has its own gate, detector and gain
+       max       per-channel detection, the loudest channel drives one shared gain
+
+     `unlinked` and `max` run per-channel detector lanes, which only the block engine
+     has — like oversampled Bite they override the engine choice. In multiband mode
+     the bands are detected on the linked sidechain: `lcr` still leaves the surrounds
+     out, `unlinked` and `max` behave as `all`.
+     */
+    enum class SidechainLink { all, lcr, unlinked, max };
+
+    /**
+     What the detector listens to (sidechainSource parameter):
+       internal  the main input, through the link mode above (the original behaviour)
+       external  the key: the mean of the sidechain buffers passed to process()
+       mix       the main input's linked mean plus the key's mean
+
+     The key goes through the same gate gain and 80 Hz HPF as the internal sidechain;
+     the gate itself keeps following the main input. External and mix detect on one
+     linked sidechain, so `unlinked` and `max` behave as `all`. With no key buffers
+     passed, external hears silence (no gain reduction) and mix equals internal.
+     */
+    enum class SidechainSource { internal, external, mix };
+
+    /**
+     Rate the `all`/`lcr` linked detector runs at (sidechainRate parameter):
+       full     every sample (the original behaviour)
+       reduced  from 176.4 kHz up, once per group of 2, 4 or 8 samples, the largest that
+                keeps the detector at kMinDecimatedDetectorRate or above. Each group's
+                mean x feeds the sidechain HPF and its peak |x| the gate; the detector
+                steps with its time constants, holds and HPF designed for the reduced
+                rate, in double, and its gate and gain are interpolated linearly back
+                up to the full rate, one group behind.
+
+     Reduced keeps the detector's cost per second of audio flat above 176.4 kHz; below
+     that it is the same as full. The per-channel lanes and multiband stay at the full
+     rate, and reduced takes the block engine, like the double detector precision.
+     */
+    enum class SidechainRate { full, reduced };
+
+    /// Highest sample rate the kernel is specified and tested at.
+    static constexpr double kMaxSampleRate = 768000.0;
+
+    /// Lowest rate the reduced-rate detector decimates to, and its largest factor.
+    static constexpr double kMinDecimatedDetectorRate = 88200.0;
+    static constexpr int kMaxSidechainDecimation = 8;
+
+    /**
+     Prepares the kernel for inputChannelCount channels at inSampleRate (up to
+     kMaxSampleRate) and blocks of up to maximumFramesToRender(), and puts it at rest.
+     Not realtime-safe the first time. After that, buffers are only ever grown: the
+     scratch arena and per-channel delays are sized for kMaxChannels, the limiter for
+     rates up to kMaxSampleRate, and the 8x oversampler buffers for the most channels
+     used so far. So a host that switches rate or re-prepares on transport start, at no
+     more channels or frames than before, costs no allocation.
+     */
+    void initialize(int inputChannelCount, int outputChannelCount, double inSampleRate);
+
+    /// Puts the kernel at rest (reset()) and keeps every buffer for the next initialize().
+    void deInitialize();
+
+    /**
+     Clears all signal state: detectors, gate, shelves, crossovers, oversamplers, dry
+     delays, limiter, tube stages and the meter, and finishes any parameter ramp.
+     Coefficients, parameters and buffers are kept. Never allocates, so it is safe on
+     the render thread.
+     */
+    void reset();
 
     // MARK: - Bypass
     bool isBypassed() {
@@ -102,77 +146,159 @@ public:
         mBypassed = shouldBypass;
     }
 
-    // MARK: - Parameter Getter / Setter
-    void setParameter(AUParameterAddress address, AUValue value) {
-        switch (address) {
-            case VX1ExtensionParameterAddress::compress: {
-                mCompressPercent = value;
-                float t = mCompressPercent / 100.0f;          // 0.0 → 1.0 (linear knob position)
-                float tThresh = std::pow(t, 0.2f);             // ^(1/5) curve: threshold drops extremely fast early
-                mThresholdDb = tThresh * -50.0f;               // 0% → 0dB, 100% → -50dB
-                mRatio = 1.0f + t * 29.0f;                    // 0% → 1:1, 100% → 30:1 (linear)
-                mThresholdLinear = std::pow(10.0f, mThresholdDb / 20.0f);
-                break;
-            }
-            case VX1ExtensionParameterAddress::speed:
-                mSpeedMs = value;
-                mAttackMs = mSpeedMs;
-                mReleaseMs = mSpeedMs * 3.0f;
-                mAttackCoeff = std::exp(-1.0f / (mAttackMs * 0.001f * mSampleRate));
-                mReleaseCoeff = std::exp(-1.0f / (mReleaseMs * 0.001f * mSampleRate));
-                break;
-            case VX1ExtensionParameterAddress::makeupGain:
-                mMakeupGainDb = value;
-                mMakeupGainLinear = std::pow(10.0f, mMakeupGainDb / 20.0f);
-                break;
-            case VX1ExtensionParameterAddress::bypass:
-                mBypassed = (value >= 0.5f);
-                break;
-            case VX1ExtensionParameterAddress::mix:
-                mMixPercent = value;
-                break;
-            case VX1ExtensionParameterAddress::grip:
-                mGripPercent = value;
-                break;
-            case VX1ExtensionParameterAddress::bite:
-                mBitePercent = value;
-                break;
-            case VX1ExtensionParameterAddress::stack:
-                mStackPercent = value;
-                break;
-            case VX1ExtensionParameterAddress::gateThreshold:
-                mGateThresholdDb = value;
-                break;
-        }
+    // MARK: - Engine
+    Engine processingEngine() const {
+        return mEngine;
     }
 
-    AUValue getParameter(AUParameterAddress address) {
-        switch (address) {
-            case VX1ExtensionParameterAddress::compress:
-                return (AUValue)mCompressPercent;
-            case VX1ExtensionParameterAddress::speed:
-                return (AUValue)mSpeedMs;
-            case VX1ExtensionParameterAddress::makeupGain:
-                return (AUValue)mMakeupGainDb;
-            case VX1ExtensionParameterAddress::bypass:
-                return (AUValue)(mBypassed ? 1.0f : 0.0f);
-            case VX1ExtensionParameterAddress::mix:
-                return (AUValue)mMixPercent;
-            case VX1ExtensionParameterAddress::grip:
-                return (AUValue)mGripPercent;
-            case VX1ExtensionParameterAddress::bite:
-                return (AUValue)mBitePercent;
-            case VX1ExtensionParameterAddress::stack:
-                return (AUValue)mStackPercent;
-            case VX1ExtensionParameterAddress::gainReductionMeter:
-                return (AUValue)mCurrentGainReductionDb;
-            case VX1ExtensionParameterAddress::gateThreshold:
-                return (AUValue)mGateThresholdDb;
-            default:
-                return 0.f;
+    void setProcessingEngine(Engine engine) {
+        mEngine = engine;
+    }
+
+    // MARK: - Detector Precision
+    DetectorPrecision detectorPrecision() const {
+        return mDetectorPrecision;
+    }
+
+    /// Takes effect from the next block; the detector carries on from where it is. Only
+    /// the `all` and `lcr` linked detector has a double version, and it takes the block
+    /// engine over the scalar one. Unlinked and max link, multiband and the reduced
+    /// sidechain rate have none, so with those the setting is kept but changes nothing.
+    void setDetectorPrecision(DetectorPrecision precision) {
+        if (precision != DetectorPrecision::single && mDetectorPrecision == DetectorPrecision::single) {
+            mDetectorWide.syncStateFrom(mDetector);
         }
+        mDetectorPrecision = precision;
     }
 
+    // MARK: - Event Segments
+
+    /// Shortest segment process(…, timeline) renders between parameter events.
+    static constexpr AUAudioFrameCount kDefaultMinSegmentFrames = 32;
+
+    AUAudioFrameCount minimumSegmentFrames() const {
+        return mMinSegmentFrames;
+    }
+
+    /// Events closer than this to the start of the current segment are applied at that
+    /// start instead of splitting the buffer; 1 splits at every event.
+    void setMinimumSegmentFrames(AUAudioFrameCount frames) {
+        mMinSegmentFrames = std::max<AUAudioFrameCount>(frames, 1);
+    }
+
+    // MARK: - Silence
+
+    /// Input level below which a segment counts as silent: -140 dBFS, under the 24-bit floor.
+    static constexpr float kSilenceFloor = 1e-7f;
+
+    /// Silent-block fast path, on by default: once the input is below kSilenceFloor and
+    /// every detector and filter state has decayed below it too, segments are written as
+    /// zeros without running the engine (see renderSilence()).
+    void setSilenceSkipping(bool enabled) {
+        mSilenceSkipping = enabled;
+    }
+
+    bool silenceSkipping() const {
+        return mSilenceSkipping;
+    }
+
+    // MARK: - Denormals
+
+    /// Flush-to-zero while process() runs (VX1DenormalScope), on by default. Off leaves
+    /// the caller's floating-point mode alone, so only the explicit flushing of decaying
+    /// state protects the recursions, as on platforms where the scope does nothing.
+    void setFlushToZero(bool enabled) {
+        mFlushToZero = enabled;
+    }
+
+    bool flushToZero() const {
+        return mFlushToZero;
+    }
+
+    // MARK: - Block Variants
+
+    /// Specialized block engine variants, on by default: blocks whose configuration has a
+    /// compiled variant (see BlockVariant) skip the generic per-frame feature tests. Off
+    /// sends every block through the generic path; the output is the same either way.
+    void setBlockVariants(bool enabled) {
+        mBlockVariants = enabled;
+    }
+
+    bool blockVariants() const {
+        return mBlockVariants;
+    }
+
+    // MARK: - Latency
+    /// Processing latency in samples, reported to the host: the oversampler round trip plus
+    /// the limiter lookahead while the limiter is on.
+    int latencySamples() const {
+        return mLatencySamples;
+    }
+
+    // MARK: - Telemetry
+
+    /// Entries the telemetry ring holds: over a second of 64-frame buffers at 48 kHz.
+    static constexpr size_t kTelemetryCapacity = 1024;
+
+    /// Turns the per-buffer telemetry on or off, from any thread. Off by default: the
+    /// level measurements cost an extra pass over the input and the output.
+    void setTelemetryEnabled(bool enabled) {
+        mTelemetryEnabled.store(enabled);
+    }
+
+    bool telemetryEnabled() const {
+        return mTelemetryEnabled.load();
+    }
+
+    /// Consumer side of the telemetry ring — one UI or logging thread, never the render
+    /// thread. Takes up to maxFrames of the oldest entries; never blocks or allocates.
+    size_t drainTelemetry(VX1TelemetryFrame* out, size_t maxFrames) {
+        return mTelemetry.drain(out, maxFrames);
+    }
+
+    bool popTelemetry(VX1TelemetryFrame& frame) {
+        return mTelemetry.pop(frame);
+    }
+
+    /// Entries lost because the consumer fell a whole ring behind.
+    uint64_t telemetryDropped() const {
+        return mTelemetry.dropped();
+    }
+
+    // MARK: - Performance Counters
+
+    /// Copy of the render-thread counters (block ticks, per-stage ticks, worst block,
+    /// denormal-heavy blocks, ticks-per-frame histogram). Any thread, never blocks the
+    /// render thread. Empty (`enabled` false) unless built with VX1_PERF_COUNTERS=1.
+    VX1PerfSnapshot perfSnapshot() const {
+        return mPerf.snapshot();
+    }
+
+    /// Zeroes the counters at the start of the next block.
+    void resetPerfCounters() {
+        mPerf.requestReset();
+    }
+
+    /// Called by the AU adapter with the ticks of a whole host render call.
+    void recordRenderTicks(uint64_t ticks) {
+        mPerf.recordRender(ticks);
+    }
+
+    // MARK: - Parameter Getter / Setter
+
+    /// Ramp applied to parameter steps that arrive without a ramp duration.
+    static constexpr double kDezipperSeconds = 0.020;
+
+    /// Sets a parameter. After initialize(), compress, speed, makeup gain and mix
+    /// move to the new value over kDezipperSeconds instead of stepping.
+    void setParameter(AUParameterAddress address, AUValue value);
+
+    /// Sets a parameter, ramping the smoothed ones (compress, speed, makeup gain, mix)
+    /// over rampFrames samples from their current value; 0 steps immediately.
+    void setParameterRamped(AUParameterAddress address, AUValue value, int rampFrames);
+
+    AUValue getParameter(AUParameterAddress address);
+
     // MARK: - Max Frames
     AUAudioFrameCount maximumFramesToRender() const {
         return mMaxFramesToRender;
@@ -182,11 +308,6 @@ public:
         mMaxFramesToRender = maxFrames;
     }
 
-    // MARK: - Musical Context
-    void setMusicalContextBlock(AUHostMusicalContextBlock contextBlock) {
-        mMusicalContextBlock = contextBlock;
-    }
-
     // MARK: - Sheen Saturation
     /**
      Four-stage "sheen" saturation — produces JJP-style aggressive presence shimmer.
@@ -216,63 +337,142 @@ public:
              Fixed formula keeps wet path at consistent loudness across all Sheen values.
              Previous algorithm under-compensated by ~10 dB at Sheen=100%.
 
-     @param channel  Per-channel index needed for stateful pre/de-emphasis filters.
+     All Bite-dependent constants (drive, DC offset and its tanh, grit amount and the
+     1/tanh compensation) live in mBite and are recomputed only when Bite changes.
+
+     @param channel  Per-channel index (SoA lane) of the stateful pre/de-emphasis filters.
      */
-    float applySaturation(float input, float amount, int channel) {
-        if (amount <= 0.0f) return input;
+    float applySaturation(float input, int channel) {
+        if (mBite.blend <= 0.0f) return input;
 
-        const float blend = amount / 100.0f;
+        const float blend = mBite.blend;
 
         // --- Stage 1a: Pre-emphasis high shelf (+5 dB @ 3.5 kHz) ---
         // Harmonic generation is louder above 3.5 kHz → presence-band sheen
         float preOut = mShelfB0Pre * input
-                     + mShelfB1Pre * mPreX1[channel]
-                     - mShelfA1Pre * mPreY1[channel];
-        mPreX1[channel] = input;
-        mPreY1[channel] = preOut;
+                     + mShelfB1Pre * mChannels.preX1[channel]
+                     - mShelfA1Pre * mChannels.preY1[channel];
+        mChannels.preX1[channel] = input;
+        mChannels.preY1[channel] = preOut;
         // Scale shelf in with Sheen amount: transparent at 0%, full boost at 100%
         float emphasized = input + (preOut - input) * blend;
 
         // --- Stage 2: Asymmetric wave shaper (2nd harmonic — "sheen/sparkle") ---
         // Small positive DC offset makes the wave shaper clip asymmetrically,
         // generating stronger even harmonics (2nd harmonic = octave above fundamental).
-        float drive     = 1.0f + blend * 4.0f;    // 1.0 at 0% → 5.0 at 100%
-        float dcOffset  = 0.18f * blend;           // offset grows with Bite amount
-        float driven    = (emphasized + dcOffset) * drive * 1.3f;
-        float shaped    = std::tanh(driven);
-        float shapedDc  = std::tanh(dcOffset * drive * 1.3f);
-        shaped -= shapedDc;                        // remove DC from asymmetry
+        float driven    = (emphasized + mBite.dcOffset) * mBite.drive * 1.3f;
+        float shaped    = vx1::fastmath::tanh<vx1::fastmath::kSaturationPrecision>(driven);
+        shaped -= mBite.shapedDc;                  // remove DC from asymmetry
 
         // --- Stage 3: Cubic grit layer (3rd harmonic — "edge") ---
         // x^3 generates 3rd harmonic (two octaves up), sits in 4–12 kHz for vocals.
         // Scaled by (1 - blend*0.5) so it fades back at high drive where shaped is
         // already near clipping — prevents aliasing/intermodulation at top of knob.
         float cubic    = shaped * shaped * shaped;
-        float gritAmt  = 0.06f * blend * (1.0f - blend * 0.5f);
-        float withGrit = shaped + cubic * gritAmt;
+        float withGrit = shaped + cubic * mBite.gritAmt;
 
         // --- Stage 1b: De-emphasis high shelf (-5 dB @ 3.5 kHz) ---
         // Restores the tonal balance of the fundamental content.
         // Generated harmonics live above the shelf region so they survive.
         float deOut = mShelfB0De * withGrit
-                    + mShelfB1De * mDeX1[channel]
-                    - mShelfA1De * mDeY1[channel];
-        mDeX1[channel] = withGrit;
-        mDeY1[channel] = deOut;
+                    + mShelfB1De * mChannels.deX1[channel]
+                    - mShelfA1De * mChannels.deY1[channel];
+        mChannels.deX1[channel] = withGrit;
+        mChannels.deY1[channel] = deOut;
         float deEmphasized = withGrit + (deOut - withGrit) * blend;
 
-        // --- Stage 4: Gain compensation ---
-        // Normalize the wet path back to unity by inverting the tanh's actual ceiling
-        // at the current drive setting. 1/tanh(drive*1.3) exactly compensates for
-        // how much the wave shaper has compressed the signal, keeping perceived level
-        // consistent across the full knob range.
-        float compensationGain = 1.0f / std::tanh(drive * 1.3f);
-        deEmphasized *= compensationGain;
+        // --- Stage 4: Gain compensation (1/tanh(drive*1.3), see updateBiteCoefficients) ---
+        deEmphasized *= mBite.compensationGain;
 
         // Final dry/wet blend
         return input * (1.0f - blend) + deEmphasized * blend;
     }
 
+    /// Recomputes mBite from mParameters.bitePercent. Called on Bite parameter changes and in initialize().
+    void updateBiteCoefficients();
+
+    // MARK: - Sheen Saturation: Oversampling
+
+    /**
+     The wave shaper and grit layer (stages 2 + 3) can run at 2x/4x/8x inside the
+     block engine so the harmonics they generate above Nyquist are filtered out
+     instead of folding back — most audible on sibilants at 44.1/48 kHz.
+     The shelves stay at the base rate (they are linear), and both dry paths
+     (Bite's own blend and the parallel mix) are delayed by the oversampler latency
+     so nothing comb-filters. The scalar reference engine always runs at 1x.
+     */
+    void applyOversamplingFactor();
+
+    // MARK: - Tube
+
+    /**
+     Post-compressor tube saturation after the parallel mix and before the limiter
+     (VX1TubeStage, one specialization per curve). Memoryless apart from its DC
+     blocker, so it adds no latency; it runs on whole output blocks in both engines.
+     */
+    void applyTube(std::span<float *> outputBuffers, AUAudioFrameCount frameCount);
+
+    /// Calls visit(stage) on each of the three tube stages.
+    template <typename Visitor>
+    void forEachTubeStage(Visitor&& visit) {
+        visit(mTubeStandard);
+        visit(mTubeWarm);
+        visit(mTubeAggressive);
+    }
+
+    template <typename Visitor>
+    void forEachTubeStage(Visitor&& visit) const {
+        visit(mTubeStandard);
+        visit(mTubeWarm);
+        visit(mTubeAggressive);
+    }
+
+    // MARK: - Multiband
+
+    /**
+     Multiband mode (multiband parameter, 2–4 bands): the gated, high-passed linked
+     sidechain is split by Linkwitz-Riley crossovers (VX1Crossover) and each band runs
+     its own detector, Grip blend, envelope, gain computer and VCA overshoot on the
+     shared compress/speed settings. Each channel's audio goes through the same
+     crossovers, every band gets its own gain, and the bands are summed back into the
+     wet path ahead of Bite, makeup and mix. Stack only acts on the single-band path.
+
+     Bands live in the four lanes of VX1CrossoverState / VX1BandState, so a frame of
+     the crossovers, detectors and band gains advances every band with one set of
+     vx1::simd::Float4 operations. Block engine only, like the detector lanes.
+
+     Two bands split at the high crossover (body / sibilance), three at the low and
+     high ones, four at all three.
+     */
+    void updateCrossovers();
+
+    /// Stage 2 of the block engine in multiband mode: linked gate and sidechain HPF, then
+    /// the band split and one detector/gain track per band, into frame-major band gain
+    /// rows of mScratchBandGain (gate folded in). Returns the peak gain reduction (dB).
+    float processDetectorMultiband(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                   AUAudioFrameCount frameOffset, int frameCount);
+
+    /// Multiband wet path of one channel: splits in[] into its bands and sums them back
+    /// with their gains from mScratchBandGain.
+    void applyBandGains(const float* in, float* wet, int channel, int frameCount);
+
+    // MARK: - Output Limiter
+
+    /**
+     Brickwall lookahead limiter after the parallel mix (VX1LookaheadLimiter).
+     Grip 100% still lets the first 2 ms of a transient through; the limiter sees
+     1.5 ms ahead and holds the output at the ceiling. It runs in both engines and
+     adds its lookahead to latencySamples() while enabled. Returns the block's peak
+     limiter gain reduction in dB.
+     */
+    float applyLimiter(std::span<float *> outputBuffers, AUAudioFrameCount frameCount);
+
+    /// Recomputes mLatencySamples from the oversampling factor and the limiter state.
+    void updateLatency();
+
+    /// Stages 2 + 3 in place: asymmetric tanh shaper and cubic grit (memoryless, SIMD).
+    void applyBiteShaper(float* buffer, int sampleCount);
+
     // MARK: - Sheen Saturation: Presence Pre/De-Emphasis
 
     /**
@@ -290,55 +490,39 @@ public:
        Cut:    b0 = (K + 1)/(G*K + 1),  b1 = (K - 1)/(G*K + 1),  a1 = (G*K - 1)/(G*K + 1)
        where G = linear gain = 10^(5/20) ≈ 1.778
      */
-    void computePresenceCoefficients() {
-        const float fc = 3500.0f;
-        const float gainDb = 5.0f;
-        const float G = std::pow(10.0f, gainDb / 20.0f);  // ≈ 1.778
-        const float K = std::tan((float)M_PI * fc / (float)mSampleRate);
-
-        // Pre-emphasis: +5 dB shelf boost above 3.5 kHz
-        mShelfB0Pre = (G * K + 1.0f) / (K + 1.0f);
-        mShelfB1Pre = (G * K - 1.0f) / (K + 1.0f);
-        mShelfA1Pre = (K - 1.0f)     / (K + 1.0f);
-
-        // De-emphasis: matching -5 dB shelf cut (exact inverse)
-        mShelfB0De  = (K + 1.0f)     / (G * K + 1.0f);
-        mShelfB1De  = (K - 1.0f)     / (G * K + 1.0f);
-        mShelfA1De  = (G * K - 1.0f) / (G * K + 1.0f);
-    }
+    void computePresenceCoefficients();
 
     // MARK: - Sidechain HPF
 
     /// Computes 2-pole Butterworth HPF coefficients for the fixed 80 Hz sidechain filter.
     /// Must be called once per initialize() and whenever sample rate changes.
-    void computeHpfCoefficients() {
-        const float fc = 80.0f;
-        const float omega = 2.0f * (float)M_PI * fc / (float)mSampleRate;
-        const float cosOmega = std::cos(omega);
-        const float sinOmega = std::sin(omega);
-        // Butterworth: Q = 1/sqrt(2) ≈ 0.7071
-        const float alpha = sinOmega / (2.0f * 0.7071f);
-
-        float b0 =  (1.0f + cosOmega) / 2.0f;
-        float b1 = -(1.0f + cosOmega);
-        float b2 =  (1.0f + cosOmega) / 2.0f;
-        float a0 =   1.0f + alpha;
-        float a1 =  -2.0f * cosOmega;
-        float a2 =   1.0f - alpha;
-
-        mHpfA0 = b0 / a0;
-        mHpfA1 = b1 / a0;
-        mHpfA2 = b2 / a0;
-        mHpfB1 = a1 / a0;
-        mHpfB2 = a2 / a0;
+    void computeHpfCoefficients();
+
+    /// Coefficients and holds of the double detectors: mDetectorWide at mSampleRate and
+    /// mDetectorDecimated at mSampleRate / mSidechainDecimation, from the same formulas as
+    /// mDetector's (initialize(), speed, computeHpfCoefficients()) evaluated in double.
+    void computeDoubleDetectorCoefficients();
+
+    /// The linked detector's coefficients and holds for sampleRate, in double.
+    void designDetector(VX1DetectorStateT<double>& detector, double sampleRate) const;
+
+    /// True when the reduced-rate linked detector is in use (see SidechainRate).
+    bool sidechainDecimationActive() const {
+        return mSidechainRate == SidechainRate::reduced && mSidechainDecimation > 1;
+    }
+
+    /// True for the plain float, full-rate linked detector: the only one the block
+    /// variants, the scalar engine and VX1KernelBank implement.
+    bool detectorIsStandard() const {
+        return mDetectorPrecision == DetectorPrecision::single && !sidechainDecimationActive();
     }
 
     /// Runs one sample through the sidechain HPF (Direct Form II Transposed).
     float applyHpf(float x) {
-        float y = mHpfA0 * x + mHpfA1 * mHpfX1 + mHpfA2 * mHpfX2
-                             - mHpfB1 * mHpfY1  - mHpfB2 * mHpfY2;
-        mHpfX2 = mHpfX1; mHpfX1 = x;
-        mHpfY2 = mHpfY1; mHpfY1 = y;
+        float y = mDetector.hpfA0 * x + mDetector.hpfA1 * mDetector.hpfX1 + mDetector.hpfA2 * mDetector.hpfX2
+                             - mDetector.hpfB1 * mDetector.hpfY1  - mDetector.hpfB2 * mDetector.hpfY2;
+        mDetector.hpfX2 = mDetector.hpfX1; mDetector.hpfX1 = x;
+        mDetector.hpfY2 = mDetector.hpfY1; mDetector.hpfY1 = y;
         return y;
     }
 
@@ -348,331 +532,378 @@ public:
      This function does the core signal processing.
      Implements a feed-forward RMS compressor with attack/release envelope follower.
      */
-    void process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime, AUAudioFrameCount frameCount) {
-        assert(inputBuffers.size() == outputBuffers.size());
-
-        if (mBypassed) {
-            // Pass the samples through unmodified
-            for (UInt32 channel = 0; channel < inputBuffers.size(); ++channel) {
-                std::copy_n(inputBuffers[channel], frameCount, outputBuffers[channel]);
-            }
-            mCurrentGainReductionDb = 0.0f;
-        } else {
-            // Track peak gain reduction in this buffer
-            float peakGainReductionDb = 0.0f;
-
-            // Process each frame
-            for (UInt32 frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-
-                // --- Noise Gate: pre-input-gain, runs on raw input level ---
-                // Envelope follower on the peak of the raw (pre-gain) mono sum.
-                // When signal drops below threshold: hold for 50ms, then close over 100ms.
-                // Gate gain (0=closed, 1=open) is applied to both sidechain and audio paths.
-                {
-                    float rawMono = 0.0f;
-                    for (UInt32 ch = 0; ch < inputBuffers.size(); ++ch) {
-                        rawMono += std::abs(inputBuffers[ch][frameIndex]);
-                    }
-                    rawMono /= (float)inputBuffers.size();
-
-                    // Peak envelope follower: fast attack, slow release
-                    if (rawMono > mGateEnvelope) {
-                        mGateEnvelope = mGateAttackCoeff * mGateEnvelope + (1.0f - mGateAttackCoeff) * rawMono;
-                    } else {
-                        mGateEnvelope = mGateReleaseCoeff * mGateEnvelope + (1.0f - mGateReleaseCoeff) * rawMono;
-                    }
-
-                    float gateThresholdLinear = std::pow(10.0f, mGateThresholdDb / 20.0f);
-                    bool signalAboveThreshold = (mGateEnvelope >= gateThresholdLinear);
-
-                    if (signalAboveThreshold) {
-                        // Signal present: open gate, reset hold counter
-                        mGateOpen = true;
-                        mGateHoldCounter = mGateHoldSamples;
-                        mGateGain = 1.0f;  // snap open instantly
-                    } else if (mGateHoldCounter > 0) {
-                        // Signal gone but still in hold period: stay open
-                        mGateHoldCounter--;
-                        mGateGain = 1.0f;
-                    } else {
-                        // Hold expired: close gate with smoothed release
-                        mGateOpen = false;
-                        mGateGain *= mGateReleaseCoeff;
-                    }
-                }
-
-                // --- Detection: always runs on the current (undelayed) input ---
-                // Sidechain signal: mono sum → fixed 80 Hz HPF
-                float monoSC = 0.0f;
-                for (UInt32 channel = 0; channel < inputBuffers.size(); ++channel) {
-                    monoSC += inputBuffers[channel][frameIndex] * mGateGain;
-                }
-                monoSC /= (float)inputBuffers.size();
-                float filteredSC = applyHpf(monoSC);
-                float absFiltered = std::abs(filteredSC);
-
-                // Peak detection: instantaneous absolute value — grabs transients hard
-                float peak = absFiltered;
-
-                // RMS detection: IIR squared-sample accumulator (~50ms window)
-                // Responds to energy, not individual peaks — smooth and musical
-                mRmsState = mRmsCoeff * mRmsState + (1.0f - mRmsCoeff) * (absFiltered * absFiltered);
-                float rms = std::sqrt(mRmsState);
-
-                // Blend detected level: 0% = pure RMS (smooth), 100% = pure Peak (tight/aggressive)
-                float gripBlend = mGripPercent / 100.0f;
-                float detectionLevel = (rms * (1.0f - gripBlend)) + (peak * gripBlend);
-
-                // Dramatic mode difference: envelope attack changes with grip knob
-                // RMS (0%): uses the user's attack knob — compressor breathes with the music
-                // Peak (100%): ~2ms near-instant attack — compressor slams on every transient
-                float blendedAttackCoeff = mAttackCoeff * (1.0f - gripBlend) + mInstantCoeff * gripBlend;
-
-                // Envelope follower (blended attack, fixed release)
-                float coeff = (detectionLevel > mEnvelopeLevel) ? blendedAttackCoeff : mReleaseCoeff;
-                mEnvelopeLevel = coeff * mEnvelopeLevel + (1.0f - coeff) * detectionLevel;
-
-                // Calculate gain reduction (hard knee)
-                float gainReduction = 1.0f;
-                float gainReductionDb = 0.0f;
-                float envelopeDb = 20.0f * std::log10(std::max(mEnvelopeLevel, 1e-6f));
-                float overThresholdDb = envelopeDb - mThresholdDb;
-
-                if (overThresholdDb > 0.0f) {
-                    gainReductionDb = overThresholdDb * (1.0f - 1.0f / mRatio);
-                    gainReduction = std::pow(10.0f, -gainReductionDb / 20.0f);
-                }
-                // else: below threshold, gainReduction stays at 1.0
-
-                // --- GR Overshoot: VCA-style transient punch ---
-                // Replicates the physical overshoot of a VCA gain cell (dbx 160 / SSL G-bus):
-                // when a transient causes GR to jump by more than 3 dB in one sample,
-                // briefly over-apply 3 dB of extra GR for 0.5ms (hold), then release
-                // exponentially over 2ms. Creates the "slammed" transient grab feel.
-                float grJump = gainReductionDb - mPrevGainReductionDb;
-                if (grJump > 3.0f) {
-                    mOvershootDb = 3.0f;
-                    mOvershootHoldCounter = mOvershootHoldSamples;
-                }
-                mPrevGainReductionDb = gainReductionDb;
-                if (mOvershootHoldCounter > 0) {
-                    mOvershootHoldCounter--;              // hold phase: overshoot stays fixed
-                } else {
-                    mOvershootDb *= mOvershootReleaseCoeff; // release phase: exponential decay
-                }
-                float totalGainReductionDb = gainReductionDb + mOvershootDb;
-                float gainReductionTotal = std::pow(10.0f, -totalGainReductionDb / 20.0f);
-
-                // Track peak gain reduction for metering (includes overshoot — meter shows what you hear)
-                peakGainReductionDb = std::max(peakGainReductionDb, totalGainReductionDb);
-
-                // --- Stack: true serial second compression pass ---
-                // Detects on the post-pass-1 signal so the second stage sees an already-compressed
-                // input, just like chaining two hardware units. Stack lowers the second stage's
-                // threshold (making it hit progressively harder as the knob increases).
-                // GR multiplies — no blend/lerp — so at any Stack > 0 you feel the stacking.
-                float stackBlend = mStackPercent / 100.0f;
-                float gainReductionTotal2 = 1.0f;
-
-                if (stackBlend > 0.0f) {
-                    // Sidechain: mono sum of post-pass-1 audio
-                    float monoPost1 = 0.0f;
-                    for (UInt32 ch = 0; ch < inputBuffers.size(); ++ch) {
-                        monoPost1 += inputBuffers[ch][frameIndex] * mGateGain * gainReductionTotal;
-                    }
-                    monoPost1 /= (float)inputBuffers.size();
-                    float absPost1 = std::abs(monoPost1);
-
-                    float peak2 = absPost1;
-                    mRmsState2 = mRmsCoeff * mRmsState2 + (1.0f - mRmsCoeff) * (absPost1 * absPost1);
-                    float rms2 = std::sqrt(mRmsState2);
-
-                    float detectionLevel2 = (rms2 * (1.0f - gripBlend)) + (peak2 * gripBlend);
-                    float coeff2 = (detectionLevel2 > mEnvelopeLevel2) ? blendedAttackCoeff : mReleaseCoeff;
-                    mEnvelopeLevel2 = coeff2 * mEnvelopeLevel2 + (1.0f - coeff2) * detectionLevel2;
-
-                    // Stack knob lowers the second stage threshold proportionally so it bites
-                    // harder as you turn it up. At 100% Stack the threshold is halved in dB.
-                    float thresholdDb2 = mThresholdDb + (mThresholdDb * stackBlend * 0.5f);
-
-                    float gainReductionDb2 = 0.0f;
-                    float envelopeDb2 = 20.0f * std::log10(std::max(mEnvelopeLevel2, 1e-6f));
-                    float overThresholdDb2 = envelopeDb2 - thresholdDb2;
-                    if (overThresholdDb2 > 0.0f) {
-                        gainReductionDb2 = overThresholdDb2 * (1.0f - 1.0f / mRatio);
-                        gainReductionTotal2 = std::pow(10.0f, -gainReductionDb2 / 20.0f);
-                    }
-
-                    // VCA overshoot on pass 2
-                    float grJump2 = gainReductionDb2 - mPrevGainReductionDb2;
-                    if (grJump2 > 3.0f) {
-                        mOvershootDb2 = 3.0f;
-                        mOvershootHoldCounter2 = mOvershootHoldSamples;
-                    }
-                    mPrevGainReductionDb2 = gainReductionDb2;
-                    if (mOvershootHoldCounter2 > 0) {
-                        mOvershootHoldCounter2--;
-                    } else {
-                        mOvershootDb2 *= mOvershootReleaseCoeff;
-                    }
-                    float totalGainReductionDb2 = gainReductionDb2 + mOvershootDb2;
-                    gainReductionTotal2 = std::pow(10.0f, -totalGainReductionDb2 / 20.0f);
-
-                    peakGainReductionDb = std::max(peakGainReductionDb,
-                                                   totalGainReductionDb + totalGainReductionDb2);
-                }
-
-                // Stack auto-makeup: compensate for the expected additional GR from pass 2.
-                // Derived from how much the second stage's threshold was lowered:
-                //   extraThresholdDb = mThresholdDb * stackBlend * 0.5  (negative number)
-                //   expectedGR2Db    = -extraThresholdDb * (1 - 1/ratio) (positive dB)
-                // This is static per Stack value (not per-sample), so it is stable and
-                // does not add pumping. At Stack=0 it evaluates to exactly 1.0 (no change).
-                float stackMakeupGain = 1.0f;
-                if (stackBlend > 0.0f) {
-                    float extraThresholdDb  = mThresholdDb * stackBlend * 0.5f;   // e.g. -5 dB at 50%
-                    float expectedGR2Db     = -extraThresholdDb * (1.0f - 1.0f / mRatio);
-                    stackMakeupGain = std::pow(10.0f, expectedGR2Db / 20.0f);
-                }
-
-                // Apply compression, saturation, makeup gain, then mix with dry signal
-                float mixWet = mMixPercent / 100.0f;
-                float mixDry = 1.0f - mixWet;
-
-                for (UInt32 channel = 0; channel < inputBuffers.size(); ++channel) {
-                    float audioInput = inputBuffers[channel][frameIndex] * mGateGain;
-
-                    // Apply pass 1 compression, then pass 2 GR multiplies on top (true serial stacking).
-                    // stackMakeupGain compensates for the expected volume drop from the second pass.
-                    float compressed = audioInput * gainReductionTotal * gainReductionTotal2 * stackMakeupGain;
-
-                    // Apply sheen saturation (presence-biased harmonic coloration)
-                    float saturated = applySaturation(compressed, mBitePercent, (int)channel);
-
-                    // Apply makeup gain
-                    saturated *= mMakeupGainLinear;
-
-                    // Parallel mix: blend dry and processed signals
-                    float output = (audioInput * mixDry) + (saturated * mixWet);
-                    outputBuffers[channel][frameIndex] = output;
-                }
-
-            }
-
-            // Update meter with peak gain reduction from this buffer
-            // Apply smoothing for visual stability (instant attack, adaptive release)
-            if (peakGainReductionDb > mCurrentGainReductionDb) {
-                // Attack - snap immediately to peak so the needle reacts without lag
-                mCurrentGainReductionDb = peakGainReductionDb;
-            } else {
-                // Release - use adaptive strategy based on how close to zero we are
-                if (peakGainReductionDb < 0.05f) {
-                    // When minimal or no compression, snap to zero immediately
-                    // This ensures meter resets quickly when audio stops
-                    mCurrentGainReductionDb = 0.0f;
-                } else if (peakGainReductionDb < 1.0f) {
-                    // Fast release when light compression (0.5 coefficient = much faster)
-                    mCurrentGainReductionDb = 0.5f * mCurrentGainReductionDb + 0.5f * peakGainReductionDb;
-                } else {
-                    // Normal slow release for readability during active compression
-                    float meterReleaseCoeff = 0.95f;
-                    mCurrentGainReductionDb = meterReleaseCoeff * mCurrentGainReductionDb + (1.0f - meterReleaseCoeff) * peakGainReductionDb;
-                }
-            }
+    void process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime, AUAudioFrameCount frameCount);
+
+    /**
+     Renders a whole host buffer and its parameter events in one call. The buffer is
+     split only where an event lands at least minimumSegmentFrames() after the start
+     of the current segment; events closer than that are applied at the segment start,
+     with the time they were brought forward added to their ramp, so smoothed
+     parameters (compress, speed, makeup gain, mix) still arrive on time and the rest
+     step at most minimumSegmentFrames() − 1 samples early. Per-sample automation of a
+     512-frame buffer therefore costs 512 / minimumSegmentFrames() engine passes, not
+     512, and the meter updates once per buffer. Events at or after frameCount apply
+     after the last frame.
+     */
+    void process(std::span<float const*> inputBuffers, std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime,
+                 AUAudioFrameCount frameCount, const VX1ParameterTimeline& timeline);
+
+    /**
+     process() with an external sidechain key: sidechainBuffers[c] holds frameCount
+     samples of key channel c (any count up to kMaxChannels, independent of the main
+     channel count). The kernel only reads through the pointers, so a host bus or an
+     offline renderer hands its buffers over without a copy. Ignored while the
+     sidechainSource parameter is internal.
+     */
+    void process(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                 std::span<float *> outputBuffers, AUEventSampleTime bufferStartTime,
+                 AUAudioFrameCount frameCount, const VX1ParameterTimeline& timeline);
+
+    /// Bypass, engine and limiter for frames [0, frameCount) of the given buffers, without
+    /// the meter update. sidechainBuffers is empty unless an external or mixed key is in
+    /// use. Returns the peak gain reduction (dB); 0 when bypassed.
+    float renderSegment(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                        std::span<float *> outputBuffers, AUAudioFrameCount frameCount);
+
+    /// Applies a timeline event at frame `now` (≤ its offset), lengthening its ramp by the
+    /// frames it was brought forward.
+    void applyTimelineEvent(const VX1TimelineEvent& event, AUAudioFrameCount now);
+
+    /// Per-frame reference engine. Returns the peak gain reduction (dB) of the block.
+    float processScalar(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                        std::span<float *> outputBuffers, AUAudioFrameCount frameCount);
+
+    /// Staged block engine over at most mMaxFramesToRender frames starting at frameOffset.
+    /// Returns the peak gain reduction (dB) of the block.
+    float processBlock(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                       std::span<float *> outputBuffers, AUAudioFrameCount frameOffset, AUAudioFrameCount frameCount);
+
+    /**
+     Block form of applySaturation(), in place on every channel's buffer (buffers[c]
+     is SoA lane c). With three or more channels at the base rate the buffers are
+     interleaved frame-major into mScratchLanes and applySaturationLanes() runs the
+     whole chain across channels; otherwise each channel runs planar, SIMD across frames.
+     */
+    void applySaturationBlock(std::span<float* const> buffers, int frameCount);
+
+    /**
+     Stages 1a → 2 + 3 → 1b in one pass over frame-major lanes (laneStride floats per
+     frame, a multiple of kWidth): each FloatVec holds kWidth channels of one frame, so
+     a step of the shelf recursions advances all of them, and the shaper fills the
+     latency between steps. Shelf history is loaded from and stored back to the SoA
+     lanes in mChannels. Same arithmetic per lane as applySaturation(), so the result
+     is bit-identical to the per-channel path.
+     */
+    void applySaturationLanes(float* lanes, int laneStride, int frameCount);
 
+    /**
+     Feature set a block of the linked block engine is compiled for. selectBlockVariant()
+     reads it from the parameters and state once per block, and each combination is its
+     own instantiation of processBlockVariant(), so the per-frame loops test nothing that
+     is off:
+       stack     Stack > 0: the second detector pass runs
+       gate      the gate can move during the block. Otherwise it is open with more hold
+                 left than the block has frames, so its gain is exactly 1 throughout and
+                 drops out of the sidechain, gain and dry-path products
+       bite      Bite > 0: the saturation stage runs; off, gain, makeup and mix are one pass
+       fullWet   mix at 100%: no dry path
+       channels  1, 2, or 0 for any count: the mono-sum stage is unrolled for 1 and 2
+     Only the common case has variants: `all` / `lcr` link, Bite at the base rate and no
+     parameter ramp in flight. Everything else runs the generic processBlock() path.
+     */
+    struct BlockVariant {
+        int  channels = 0;
+        bool stack = false;
+        bool gate = false;
+        bool bite = false;
+        bool fullWet = false;
+    };
+
+    using BlockVariantFunction = float (VX1ExtensionDSPKernel::*)(std::span<float const*>, std::span<float *>,
+                                                                  AUAudioFrameCount, int);
+
+    /// The variant for the next frameCount frames, or nullptr if the configuration has none.
+    BlockVariantFunction selectBlockVariant(int channelCount, int frameCount) const;
+
+    /// Block engine for one feature set: the generic stages with the features that are off
+    /// compiled out. Same arithmetic as processBlock(), so the output is bit-identical.
+    template <int Channels, bool Stack, bool Gate, bool Bite, bool FullWet>
+    float processBlockVariant(std::span<float const*> inputBuffers, std::span<float *> outputBuffers,
+                              AUAudioFrameCount frameOffset, int frameCount);
+
+    /// Stage 1 of the block engine for the `all` and `lcr` link modes and multiband: mean
+    /// |x| of the detector channels into mScratchAbsMono (the gate), and into mScratchMono
+    /// the mean x of the detector channels, of the key, or both (see SidechainSource).
+    void sumDetectorChannels(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                             AUAudioFrameCount frameOffset, int frameCount);
+
+    /// Stages 1 + 2 of the block engine for the `all` and `lcr` link modes: mono sums of
+    /// the detector channels, then one gate/detector/gain recursion into row 0 of
+    /// mScratchGate/mScratchGain. Returns the peak gain reduction (dB) of the block.
+    float processDetectorLinked(std::span<float const*> inputBuffers, std::span<float const*> sidechainBuffers,
+                                AUAudioFrameCount frameOffset, int frameCount);
+
+    /// Stage 2 of processDetectorLinked() on `detector`, in Real arithmetic throughout
+    /// (see DetectorPrecision).
+    template <typename Real>
+    float runLinkedDetector(VX1DetectorStateT<Real>& detector, int frameCount);
+
+    /// Stage 2 of processDetectorLinked() at the reduced rate (SidechainRate::reduced) on
+    /// mDetectorDecimated, carrying part-filled groups across blocks in mDecimator.
+    float runDecimatedLinkedDetector(int frameCount);
+
+    /**
+     Stage 2 of the block engine for the `unlinked` and `max` link modes: gate,
+     sidechain HPF and RMS/peak detection per channel over the SoA detector lanes
+     in mChannels, then either one envelope/gain track per lane (unlinked: gate and
+     gain rows per channel in mScratchGate/mScratchGain) or one track driven by the
+     loudest lane (max: row 0). The per-lane loops are branch-free over contiguous
+     arrays so the channels' independent recursions overlap.
+     Returns the peak gain reduction (dB) of the block.
+     */
+    float processDetectorLanes(std::span<float const*> inputBuffers, AUAudioFrameCount frameOffset, int frameCount);
+
+    /// The link mode detection runs in: multiband and an external or mixed key detect on
+    /// the linked sidechain, so `unlinked` and `max` fall back to `all` for them.
+    SidechainLink activeSidechainLink() const {
+        const bool linkedOnly = mBandCount > 1 || mSidechainSource != SidechainSource::internal;
+        if (linkedOnly && (mSidechainLink == SidechainLink::unlinked || mSidechainLink == SidechainLink::max)) {
+            return SidechainLink::all;
         }
+        return mSidechainLink;
     }
 
-    void handleOneEvent(AUEventSampleTime now, AURenderEvent const *event) {
-        switch (event->head.eventType) {
-            case AURenderEventParameter: {
-                handleParameterEvent(now, event->parameter);
-                break;
-            }
-            default:
-                break;
-        }
+    /**
+     True if stage 2 of the next frameCount frames can run in a VX1KernelBank's lanes
+     instead: the linked (`all` / `lcr`) block engine on one band and the internal
+     sidechain, no compress or speed ramp in flight, the block within the scratch
+     capacity, and not a block the silent fast path would skip anyway.
+     */
+    bool detectorIsBankable(std::span<float const*> inputBuffers, AUAudioFrameCount frameCount) const;
+
+    /// Channels summed by the linked (`all` / `lcr`) detector: channels [0, n).
+    int detectorChannelCount(int channelCount) const {
+        return (mSidechainLink == SidechainLink::lcr && channelCount >= 3) ? 3 : channelCount;
+    }
+
+    /// Meter ballistics: instant attack, adaptive release.
+    void updateGainReductionMeter(float peakGainReductionDb);
+
+    /// True if every frame of every input channel is below kSilenceFloor. Scans a chunk at a
+    /// time, so ordinary audio returns within the first few frames.
+    bool inputIsSilent(std::span<float const*> inputBuffers, AUAudioFrameCount frameCount) const;
+
+    /// True once the state the current link mode uses has gone quiet: gate closed with its
+    /// hold expired and its gain below kSilenceFloor, and the gate envelope, sidechain HPF,
+    /// RMS (kSilenceFloor squared), envelopes, overshoot, crossovers, Bite shelves and the
+    /// tube DC blocker below kSilenceFloor.
+    /// From there silent input produces output below -260 dBFS.
+    bool stateIsSettled() const;
+
+    /**
+     Silent-block fast path: writes zeros and advances the parameter ramps by frameCount so
+     automation stays on time. On the first silent segment it puts the settled state
+     exactly at rest — detector, shelf and tube state to zero, the gate fully closed, the
+     oversamplers, dry delays and limiter lookahead cleared. The gate held its gain below
+     -140 dB for at least its 50 ms hold before the state could settle, which is longer
+     than any of those delays, so nothing audible is dropped.
+     */
+    void renderSilence(std::span<float *> outputBuffers, AUAudioFrameCount frameCount);
+
+    /// Sets recursive state that has decayed below vx1::denormals::kFlushFloor to zero, so
+    /// release tails stop before they reach the subnormal range. Once per buffer.
+    void flushDecayingState();
+
+    /// True if any recursive filter or detector state is subnormal — the blocks where
+    /// denormal arithmetic slows the recursions down. Only used by the perf counters.
+    bool stateHasDenormals() const;
+
+    /// Fills the detector fields of a telemetry frame (pass-1/pass-2 GR, overshoot, gate)
+    /// from the state left by the last frame rendered.
+    void captureDetectorTelemetry(VX1TelemetryFrame& frame) const;
+
+    /// A render-thread parameter event. A non-zero rampDurationSampleFrames is honoured
+    /// exactly; plain steps get the de-zipper ramp.
+    void handleParameterEvent(AUEventSampleTime now, AUParameterAddress address, AUValue value,
+                              AUAudioFrameCount rampDurationSampleFrames = 0) {
+        setParameterRamped(address, value, rampDurationSampleFrames > 0 ? (int)rampDurationSampleFrames : mDezipperFrames);
     }
 
-    void handleParameterEvent(AUEventSampleTime now, AUParameterEvent const& parameterEvent) {
-        setParameter(parameterEvent.parameterAddress, parameterEvent.value);
+    // MARK: - Parameter Smoothing
+
+    /// Jumps every smoothed parameter to its target (initialize() / deInitialize()).
+    void snapSmoothedParameters();
+
+    /// Rows of mScratchRamps: per-frame values of the smoothed parameters for one block.
+    enum RampRow { kRampThresholdDb, kRampSlope, kRampAttackCoeff, kRampReleaseCoeff, kRampMixDry, kRampWetGain, kRampRowCount };
+
+    float* rampRow(RampRow row) {
+        return mScratch.data(mScratchRamps) + (size_t)row * mScratchFrames;
     }
 
+    /// While compress or speed is ramping: fills the threshold, slope, attack and release
+    /// rows for the next frameCount frames and returns true. Otherwise returns false and
+    /// the detector keeps using the cached targets.
+    bool fillDetectorRamps(int frameCount);
+
+    /// While makeup gain or mix is ramping: fills the dry-gain (1 − mix) and wet-gain
+    /// (makeup · mix) rows and returns true.
+    bool fillMixRamps(int frameCount);
+
     // MARK: Member Variables
-    AUHostMusicalContextBlock mMusicalContextBlock;
+
+    // Hot: the linked detector's coefficients and recursive state, two cache lines read
+    // and written every frame. First, so it starts the (64-byte aligned) kernel.
+    VX1DetectorState mDetector;
+
+    Engine mEngine = Engine::block;
+    DetectorPrecision mDetectorPrecision = DetectorPrecision::single;
     double mSampleRate = 44100.0;
     bool mBypassed = false;
     AUAudioFrameCount mMaxFramesToRender = 1024;
+    AUAudioFrameCount mMinSegmentFrames = kDefaultMinSegmentFrames;
+    bool mSilenceSkipping = true;
+    bool mFlushToZero = true;
+    bool mBlockVariants = true;
+    bool mSilent = false;           // the fast path put the state at rest; cleared by the engine
 
-    // Compressor parameters (in dB and ms)
-    float mCompressPercent = 30.0f; // 0% = no compression (0dB thresh, 1:1), 100% = max (−50dB thresh, 30:1)
-    float mThresholdDb = -15.0f;    // Derived from mCompressPercent
-    float mRatio = 9.7f;            // Derived from mCompressPercent
-    float mSpeedMs = 10.0f;   // Speed knob; attack = mSpeedMs, release = mSpeedMs * 3
-    float mAttackMs = 10.0f;  // Derived: mSpeedMs
-    float mReleaseMs = 30.0f; // Derived: mSpeedMs * 3
-    float mMakeupGainDb = 0.0f;
-    float mMixPercent = 100.0f;
-    float mGripPercent = 0.0f;    // 0% = RMS (smooth), 100% = Peak (tight/aggressive)
-    float mBitePercent = 25.0f;   // 0% = Clean, 100% = Aggressive presence-biased harmonic bite
-    float mStackPercent = 0.0f;   // 0% = single compression pass, 100% = double compression pass
-
-    // Computed/cached values (linear)
-    float mThresholdLinear = 0.1f;  // 10^(thresholdDb/20)
-    float mMakeupGainLinear = 1.0f; // 10^(makeupGainDb/20)
-    float mAttackCoeff = 0.0f;      // exp(-1/(attackMs * 0.001 * sampleRate))
-    float mReleaseCoeff = 0.0f;     // exp(-1/(releaseMs * 0.001 * sampleRate))
-    float mRmsCoeff = 0.0f;         // exp(-1/(0.175 * sampleRate)) — ~175ms RMS window (vocal syllable averaging)
-    float mInstantCoeff = 0.0f;     // exp(-1/(0.002 * sampleRate)) — ~2ms peak grab (fast but distortion-safe)
-
-    // State
-    float mEnvelopeLevel = 0.0f;           // Envelope follower state
-    float mRmsState = 0.0f;                // IIR squared-sample accumulator for RMS detection
-    float mCurrentGainReductionDb = 0.0f;  // Current gain reduction for metering
-
-    // Stack — second-pass envelope follower state (independent from pass 1)
-    float mEnvelopeLevel2 = 0.0f;
-    float mRmsState2 = 0.0f;
-    float mPrevGainReductionDb2 = 0.0f;
-    float mOvershootDb2 = 0.0f;
-    int   mOvershootHoldCounter2 = 0;
+    // Set by VX1KernelBank when it has already filled row 0 of mScratchGate/mScratchGain for
+    // the next block; processBlock() then skips stages 1–2 and takes this peak. One block only.
+    bool  mDetectorPrecomputed = false;
+    float mPrecomputedPeakGainReductionDb = 0.0f;
 
     // Channel count
     int mChannelCount = 2;                 // Set during initialize()
-
-    // Sidechain HPF — fixed 80 Hz 2-pole Butterworth, detection path only
-    float mHpfX1 = 0.0f, mHpfX2 = 0.0f;  // input delay history
-    float mHpfY1 = 0.0f, mHpfY2 = 0.0f;  // output delay history
-    float mHpfA0 = 1.0f, mHpfA1 = -2.0f, mHpfA2 = 1.0f; // numerator coefficients
-    float mHpfB1 = 0.0f, mHpfB2 = 0.0f;  // denominator coefficients (B0 normalised to 1)
-
-    // Sheen saturation — presence pre/de-emphasis filter state (per channel)
-    // 1-pole high shelf at ~3.5 kHz: boosts before saturation, cuts after
-    // Result: harmonic generation is biased toward presence/air band (Neve/SSL transformer character)
-    std::vector<float> mPreX1, mPreY1;   // pre-emphasis shelf: input and output history per channel
-    std::vector<float> mDeX1,  mDeY1;    // de-emphasis shelf:  input and output history per channel
+    float mCurrentGainReductionDb = 0.0f;  // Current gain reduction for metering (render thread)
+
+    // Block engine scratch — one aligned arena, laid out and allocated in initialize() so
+    // process() never allocates. Each region is one entry per frame (mScratchFrames);
+    // per-channel regions hold one row of mScratchFrames per channel, channel after channel.
+    size_t mScratchFrames = 0;
+    VX1ScratchArena mScratch;
+    VX1ScratchArena::Region mScratchAbsMono;  // mean |x| across detector channels (gate detector input)
+    VX1ScratchArena::Region mScratchMono;     // mean x across detector channels (sidechain input)
+    VX1ScratchArena::Region mScratchGate;     // gate gain per frame (a row per channel when unlinked)
+    VX1ScratchArena::Region mScratchGain;     // gate × pass 1 × pass 2 × Stack makeup per frame (ditto)
+    VX1ScratchArena::Region mScratchWet;      // per-channel rows: wet path
+    VX1ScratchArena::Region mScratchShaped;   // saturation intermediate of one channel
+    VX1ScratchArena::Region mScratchLanes;    // frame-major channel lanes for applySaturationLanes()
+    VX1ScratchArena::Region mScratchDry;      // delayed dry path of one channel (oversampled Bite only)
+    VX1ScratchArena::Region mScratchOversampled;  // one channel's shaper input at up to 8x the base rate
+    VX1ScratchArena::Region mScratchRamps;        // kRampRowCount rows of smoothed parameter values
+    VX1ScratchArena::Region mScratchBands;        // multiband: frame-major band split of the sidechain or one channel
+    VX1ScratchArena::Region mScratchBandGain;     // multiband: frame-major, one gain per band lane
+
+    // The linked detector in double, for the double precision. It is synced
+    // from mDetector before each of its blocks and narrowed back into it after, so the
+    // meter, telemetry, silence checks and the other engines keep reading mDetector.
+    VX1DetectorStateT<double> mDetectorWide;
+
+    // The reduced-rate linked detector (SidechainRate::reduced), synced with mDetector the
+    // same way. Its coefficients are for mSampleRate / mSidechainDecimation.
+    VX1DetectorStateT<double> mDetectorDecimated;
+    int mSidechainDecimation = 1;       // samples per detector step at this rate when reduced
+
+    // The group being gathered and the last two detector outputs the gain is interpolated
+    // between. Not primed: the next reduced block starts both from the detector's state.
+    struct SidechainDecimator {
+        float absPeak = 0.0f;           // peak |x| of the group (gate input)
+        float sum = 0.0f;               // sum of x over the group (sidechain input)
+        int count = 0;                  // samples gathered
+        float gatePrevious = 1.0f, gateCurrent = 1.0f;
+        float gainPrevious = 1.0f, gainCurrent = 1.0f;
+        bool primed = false;
+    };
+    SidechainDecimator mDecimator;
+
+    // Per-channel state, one SoA lane per channel: the sheen presence shelves
+    // (1-pole high shelf at ~3.5 kHz, boost before saturation and cut after, so harmonic
+    // generation is biased toward the presence/air band) and the unlinked/max detector lanes
+    VX1ChannelState mChannels;
     float mShelfB0Pre = 1.0f, mShelfB1Pre = 0.0f, mShelfA1Pre = 0.0f; // pre-emphasis coefficients
     float mShelfB0De  = 1.0f, mShelfB1De  = 0.0f, mShelfA1De  = 0.0f; // de-emphasis coefficients
 
-    // GR overshoot — VCA-style transient punch
-    // When a transient causes GR to jump >3 dB in one sample, over-apply 3 dB extra GR
-    // for a brief hold (0.5ms), then exponentially release back over 2ms.
-    // Replicates the physical VCA overshoot of the dbx 160 / SSL G-bus gain cell.
-    float mPrevGainReductionDb = 0.0f;   // GR from previous sample (for jump detection)
-    float mOvershootDb = 0.0f;           // Currently active overshoot amount (decays to 0)
-    float mOvershootReleaseCoeff = 0.0f; // exp(-1 / (2ms * sr)) — computed in initialize()
-    int   mOvershootHoldSamples = 0;     // 0.5ms * sr — computed in initialize()
-    int   mOvershootHoldCounter = 0;     // Counts down from mOvershootHoldSamples
-
-    // Noise gate — pre-input-gain, before entire compressor chain
-    // Threshold: -80 to -20 dB. At -80 dB (default) the gate is effectively always open.
-    // Attack: 0.5ms (fast open), Hold: 50ms (prevents chatter), Release: 100ms (smooth close).
-    float mGateThresholdDb = -80.0f;     // User-set threshold (-80 = off)
-    float mGateEnvelope = 0.0f;          // Peak envelope follower on raw input (pre-gain)
-    float mGateGain = 1.0f;              // Current gate gain scalar (0=closed, 1=open), smoothed
-    float mGateAttackCoeff = 0.0f;       // exp(-1 / (0.5ms * sr))
-    float mGateReleaseCoeff = 0.0f;      // exp(-1 / (100ms * sr))
-    int   mGateHoldSamples = 0;          // 50ms * sr
-    int   mGateHoldCounter = 0;          // Counts down when signal drops below threshold
-    bool  mGateOpen = true;              // Current gate state (open/closed)
+    // Sheen saturation — constants derived from mParameters.bitePercent, see updateBiteCoefficients()
+    struct BiteCoefficients {
+        float blend = 0.0f;             // Bite / 100
+        float drive = 1.0f;             // 1.0 at 0% → 5.0 at 100%
+        float dcOffset = 0.0f;          // asymmetry offset, 0 → 0.18
+        float shapedDc = 0.0f;          // tanh(dcOffset * drive * 1.3), removed after shaping
+        float gritAmt = 0.0f;           // cubic layer amount
+        float compensationGain = 1.0f;  // 1 / tanh(drive * 1.3)
+    };
+    BiteCoefficients mBite;
+
+    // Hard-knee gain computer — caches threshold/slope/Stack/gate values at event time
+    VX1ExtensionGainComputer mGainComputer;
+
+    // Smoothed parameters. mParameters holds the targets; these hold the values the
+    // engines actually use while a ramp is running (see VX1SmoothedParameter).
+    int mDezipperFrames = 0;                        // kDezipperSeconds at mSampleRate
+    VX1SmoothedParameter mSmoothedThresholdDb;      // compress → threshold
+    VX1SmoothedParameter mSmoothedSlope;            // compress → 1 − 1/ratio
+    VX1SmoothedParameter mSmoothedAttackCoeff;      // speed
+    VX1SmoothedParameter mSmoothedReleaseCoeff;     // speed
+    VX1SmoothedParameter mSmoothedMakeupGain { VX1SmoothedParameter::Curve::exponential };
+    VX1SmoothedParameter mSmoothedMixWet;           // mix / 100
+
+    // Cold: knob values (in %, dB, ms and Hz) as last set, read when a parameter changes
+    // or to answer getParameter(). The engines use the derived coefficients above.
+    struct Parameters {
+        float compressPercent = 30.0f; // 0% = no compression (0dB thresh, 1:1), 100% = max (−50dB thresh, 30:1)
+        float thresholdDb = -15.0f;    // Derived from compressPercent
+        float ratio = 9.7f;            // Derived from compressPercent
+        float speedMs = 10.0f;         // Speed knob; attack = speedMs, release = speedMs * 3
+        float attackMs = 10.0f;        // Derived: speedMs
+        float releaseMs = 30.0f;       // Derived: speedMs * 3
+        float makeupGainDb = 0.0f;
+        float mixPercent = 100.0f;
+        float gripPercent = 0.0f;      // 0% = RMS (smooth), 100% = Peak (tight/aggressive)
+        float bitePercent = 25.0f;     // 0% = Clean, 100% = Aggressive presence-biased harmonic bite
+        float stackPercent = 0.0f;     // 0% = single compression pass, 100% = double compression pass
+        float gateThresholdDb = -80.0f;  // -80 to -20 dB; -80 (default) = off
+        float crossoverLowHz = 200.0f;
+        float crossoverMidHz = 1500.0f;
+        float crossoverHighHz = 5000.0f;
+        float limiterCeilingDb = -1.0f;
+    };
+    Parameters mParameters;
+    SidechainLink mSidechainLink = SidechainLink::all;
+    SidechainSource mSidechainSource = SidechainSource::internal;
+    SidechainRate mSidechainRate = SidechainRate::full;
+
+    // Computed/cached values (linear)
+    float mThresholdLinear = 0.1f;  // 10^(thresholdDb/20)
+    float mMakeupGainLinear = 1.0f; // 10^(makeupGainDb/20)
+
+    // Sheen saturation — oversampling around the wave shaper, all buffers sized for 8x in initialize()
+    int mOversamplingFactor = 1;                // 1 (off), 2, 4 or 8
+    int mLatencySamples = 0;                    // oversampler round trip + limiter lookahead (updateLatency())
+    std::vector<VX1Oversampler> mOversamplers;  // per channel
+    std::vector<VX1DelayLine> mBiteDryDelay;    // per channel: Bite's internal dry/wet blend
+    std::vector<VX1DelayLine> mMixDryDelay;     // per channel: parallel mix dry path
+
+    // Tube — post-compressor saturation, one stage per curve so each is compiled on its own
+    VX1TubeModel mTubeModel = VX1TubeModel::off;
+    VX1TubeStage<VX1TubeCurveStandard> mTubeStandard;
+    VX1TubeStage<VX1TubeCurveWarm> mTubeWarm;
+    VX1TubeStage<VX1TubeCurveAggressive> mTubeAggressive;
+
+    // Multiband — 1 = off; crossover coefficients shared by the sidechain and every channel
+    int   mBandCount = 1;
+    VX1Crossover mCrossover;
+    VX1CrossoverState mSidechainSplit;                         // band split of the sidechain
+    VX1CrossoverState mBandSplits[kMaxChannels];               // band split of each channel's audio
+    VX1BandState mBands;                                       // per-band detector lanes
+
+    // Output limiter — prepared in initialize() whether or not it is enabled
+    bool  mLimiterEnabled = false;
+    VX1LookaheadLimiter mLimiter;
+
+    // Meter and telemetry for other threads: the meter value is published once per
+    // buffer, telemetry frames go through a wait-free SPSC ring
+    VX1RelaxedAtomic<float> mPublishedGainReductionDb;
+    VX1RelaxedAtomic<bool> mTelemetryEnabled { false };
+    VX1TelemetryRing mTelemetry { kTelemetryCapacity };
+    VX1PerfCounters mPerf;                 // empty unless VX1_PERF_COUNTERS
 };
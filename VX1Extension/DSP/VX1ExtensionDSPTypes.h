@@ -0,0 +1,18 @@
+//
+//  VX1ExtensionDSPTypes.h
+//  VX1Extension
+//
+//  Scalar types shared by the platform-neutral DSP core.
+//
+
+#pragma once
+
+#include <cstdint>
+
+// The kernel only needs the plain scalar typedefs from AudioToolbox. These are
+// declared identically to the SDK, so they can coexist with <AudioToolbox/AudioToolbox.h>
+// in the AU adapter while the DSP core builds on any platform with a C++20 compiler.
+typedef float    AUValue;
+typedef uint64_t AUParameterAddress;
+typedef int64_t  AUEventSampleTime;
+typedef uint32_t AUAudioFrameCount;
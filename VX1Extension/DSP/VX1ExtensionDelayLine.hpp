@@ -0,0 +1,74 @@
+//
+//  VX1ExtensionDelayLine.hpp
+//  VX1Extension
+//
+//  Fixed-capacity integer delay for latency compensation.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ VX1DelayLine
+
+ Power-of-two ring buffer, so the read/write positions wrap with a mask instead
+ of a branch or modulo. Capacity is allocated once in prepare(); setDelay() and
+ reset() never allocate and are safe on the render thread.
+ */
+class VX1DelayLine {
+public:
+    /// Allocates room for delays up to maxDelaySamples. Not realtime-safe; called again
+    /// with the same or a shorter maximum it reuses the buffer and does not allocate.
+    void prepare(int maxDelaySamples) {
+        uint32_t capacity = 1;
+        while (capacity < (uint32_t)maxDelaySamples + 1) {
+            capacity <<= 1;
+        }
+        mBuffer.assign(capacity, 0.0f);
+        mMask = capacity - 1;
+        mWrite = 0;
+        mDelay = std::min(mDelay, (int)mMask);
+    }
+
+    /// Sets the delay in samples, clamped to the prepared capacity.
+    void setDelay(int delaySamples) {
+        mDelay = std::clamp(delaySamples, 0, (int)mMask);
+    }
+
+    int delay() const { return mDelay; }
+
+    void reset() {
+        std::fill(mBuffer.begin(), mBuffer.end(), 0.0f);
+        mWrite = 0;
+    }
+
+    float process(float x) {
+        mBuffer[mWrite] = x;
+        const float y = mBuffer[(mWrite - (uint32_t)mDelay) & mMask];
+        mWrite = (mWrite + 1) & mMask;
+        return y;
+    }
+
+    /// Delays a block in place.
+    void process(float* buffer, int frameCount) {
+        if (mDelay == 0) return;
+        float* ring = mBuffer.data();
+        uint32_t write = mWrite;
+        const uint32_t delay = (uint32_t)mDelay;
+        for (int i = 0; i < frameCount; ++i) {
+            ring[write] = buffer[i];
+            buffer[i] = ring[(write - delay) & mMask];
+            write = (write + 1) & mMask;
+        }
+        mWrite = write;
+    }
+
+private:
+    std::vector<float> mBuffer = std::vector<float>(1, 0.0f);
+    uint32_t mMask = 0;
+    uint32_t mWrite = 0;
+    int mDelay = 0;
+};
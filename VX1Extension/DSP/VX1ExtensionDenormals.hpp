@@ -0,0 +1,88 @@
+//
+//  VX1ExtensionDenormals.hpp
+//  VX1Extension
+//
+//  Denormal protection: scoped flush-to-zero and explicit flushing of decaying state.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VX1_DENORMALS_SSE 1
+#elif defined(__aarch64__)
+#define VX1_DENORMALS_ARM64 1
+#endif
+
+namespace vx1::denormals {
+
+/// Recursive state below this magnitude (-300 dBFS) is set to zero at the end of each
+/// buffer. Far above the subnormal range (~1.2e-38), so a decaying filter or envelope
+/// never gets there, and far below anything audible.
+inline constexpr float kFlushFloor = 1e-15f;
+
+inline void flush(float& value) {
+    if (std::abs(value) < kFlushFloor) value = 0.0f;
+}
+
+/// Flushes lanes[0, count) of a per-channel state array.
+inline void flush(float* lanes, int count) {
+    for (int i = 0; i < count; ++i) flush(lanes[i]);
+}
+
+}
+
+/**
+ VX1DenormalScope
+
+ Sets flush-to-zero and denormals-are-zero for the current thread while it is in
+ scope and puts the previous mode back on exit, so the host's own floating-point
+ environment is left as it was found. x86: MXCSR FTZ | DAZ. arm64: FPCR.FZ (which
+ flushes subnormal inputs and results alike). Elsewhere it does nothing and the
+ explicit flushing in vx1::denormals is the only protection.
+
+ The control register is only written when the mode actually changes; hosts that
+ already render with FTZ set pay two register reads per buffer. A scope constructed
+ with `enabled` false leaves the mode alone.
+ */
+class VX1DenormalScope {
+public:
+    explicit VX1DenormalScope(bool enabled = true) {
+#if defined(VX1_DENORMALS_SSE)
+        if (!enabled) return;   // mSaved reads as already flushing, so nothing is restored
+        mSaved = _mm_getcsr();
+        const uint32_t flushing = mSaved | kMxcsrFlushBits;
+        if (flushing != mSaved) _mm_setcsr(flushing);
+#elif defined(VX1_DENORMALS_ARM64)
+        if (!enabled) return;
+        asm volatile("mrs %0, fpcr" : "=r"(mSaved));
+        const uint64_t flushing = mSaved | kFpcrFlushBit;
+        if (flushing != mSaved) asm volatile("msr fpcr, %0" : : "r"(flushing));
+#else
+        (void)enabled;
+#endif
+    }
+
+    ~VX1DenormalScope() {
+#if defined(VX1_DENORMALS_SSE)
+        if ((mSaved | kMxcsrFlushBits) != mSaved) _mm_setcsr(mSaved);
+#elif defined(VX1_DENORMALS_ARM64)
+        if ((mSaved | kFpcrFlushBit) != mSaved) asm volatile("msr fpcr, %0" : : "r"(mSaved));
+#endif
+    }
+
+    VX1DenormalScope(const VX1DenormalScope&) = delete;
+    VX1DenormalScope& operator=(const VX1DenormalScope&) = delete;
+
+private:
+#if defined(VX1_DENORMALS_SSE)
+    static constexpr uint32_t kMxcsrFlushBits = 0x8040;   // FTZ (bit 15) | DAZ (bit 6)
+    uint32_t mSaved = kMxcsrFlushBits;
+#elif defined(VX1_DENORMALS_ARM64)
+    static constexpr uint64_t kFpcrFlushBit = 1ull << 24; // FZ
+    uint64_t mSaved = kFpcrFlushBit;
+#endif
+};
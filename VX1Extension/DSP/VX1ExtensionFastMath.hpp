@@ -0,0 +1,191 @@
+//
+//  VX1ExtensionFastMath.hpp
+//  VX1Extension
+//
+//  Bounded-error log2/exp2 approximations for the per-sample gain computer.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "VX1ExtensionSIMD.hpp"
+
+namespace vx1::fastmath {
+
+/**
+ Precision levels for the dB <-> linear conversions in the per-sample path.
+
+   exact → std::log10 / std::pow, bit-identical to the original kernel
+   high  → 5th-order polynomials: log2 |err| < 1.5e-5, exp2 rel. err < 1.2e-7
+           (≤ 1e-4 dB on the detector, ≤ 1e-6 dB on the applied gain)
+   fast  → 3rd-order polynomials: log2 |err| < 7.8e-4, exp2 rel. err < 1.3e-4
+           (≤ 5e-3 dB on the detector, ≤ 1.1e-3 dB on the applied gain)
+
+ Coefficients are near-minimax fits on the mantissa / fractional interval.
+ All variants are branch-free so loops calling them stay vectorizable.
+ */
+enum class Precision { exact, high, fast };
+
+inline uint32_t floatBits(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+inline float bitsToFloat(uint32_t bits) {
+    float x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+/// log2(x) for positive, normal x.
+template <Precision P>
+inline float log2(float x) {
+    if constexpr (P == Precision::exact) {
+        return std::log2(x);
+    } else {
+        const uint32_t bits = floatBits(x);
+        const float exponent = (float)((int32_t)((bits >> 23) & 0xFF) - 127);
+        const float m = bitsToFloat((bits & 0x007FFFFFu) | 0x3F800000u) - 1.0f;  // mantissa - 1, in [0, 1)
+        float p;
+        if constexpr (P == Precision::high) {
+            p = m * (1.44196491f + m * (-0.70965601f + m * (0.417575302f + m * (-0.196245282f + m * 0.0463753631f))));
+        } else {
+            p = m * (1.42458095f + m * (-0.589164961f + m * 0.16535378f));
+        }
+        return exponent + p;
+    }
+}
+
+/// 2^x, clamped to the normal float range.
+template <Precision P>
+inline float exp2(float x) {
+    if constexpr (P == Precision::exact) {
+        return std::exp2(x);
+    } else {
+        x = std::min(std::max(x, -126.0f), 126.0f);
+        // floor() via truncation, so no libm call is needed without SSE4.1
+        const int32_t truncated = (int32_t)x;
+        const int32_t whole = truncated - (x < (float)truncated ? 1 : 0);
+        const float f = x - (float)whole;  // in [0, 1)
+        float p;
+        if constexpr (P == Precision::high) {
+            p = 1.0f + f * (0.693152473f + f * (0.2401528f + f * (0.0558359446f + f * (0.00897336124f + f * 0.0018853035f))));
+        } else {
+            p = 1.0f + f * (0.695557116f + f * (0.226172958f + f * 0.0781459278f));
+        }
+        return p * bitsToFloat((uint32_t)(whole + 127) << 23);
+    }
+}
+
+/// 20·log10(x). The exact variant keeps the kernel's original expression.
+template <Precision P>
+inline float linearToDb(float x) {
+    if constexpr (P == Precision::exact) {
+        return 20.0f * std::log10(x);
+    } else {
+        return 6.02059991f * log2<P>(x);   // 20·log10(2)
+    }
+}
+
+/// 10^(dB/20). The exact variant keeps the kernel's original expression.
+template <Precision P>
+inline float dbToLinear(float db) {
+    if constexpr (P == Precision::exact) {
+        return std::pow(10.0f, db / 20.0f);
+    } else {
+        return exp2<P>(db * 0.166096404f);  // log2(10)/20
+    }
+}
+
+}
+
+namespace vx1::simd {
+
+/// Four-lane log2: the same formula and coefficients as vx1::fastmath::log2, lane for lane.
+template <vx1::fastmath::Precision P>
+inline Float4 log2(Float4 x) {
+    using vx1::fastmath::Precision;
+    if constexpr (P == Precision::exact) {
+        alignas(16) float lanes[4];
+        store(lanes, x);
+        for (float& lane : lanes) {
+            lane = std::log2(lane);
+        }
+        return load4(lanes);
+    } else {
+        const Int4 bits = asBits(x);
+        const Float4 exponent = toFloat(shiftRight<23>(bits) & broadcastInt4(0xFF)) - broadcast4(127.0f);
+        const Float4 m = fromBits((bits & broadcastInt4(0x007FFFFF)) | broadcastInt4(0x3F800000)) - broadcast4(1.0f);
+        Float4 p;
+        if constexpr (P == Precision::high) {
+            p = m * (broadcast4(1.44196491f) + m * (broadcast4(-0.70965601f) + m * (broadcast4(0.417575302f)
+              + m * (broadcast4(-0.196245282f) + m * broadcast4(0.0463753631f)))));
+        } else {
+            p = m * (broadcast4(1.42458095f) + m * (broadcast4(-0.589164961f) + m * broadcast4(0.16535378f)));
+        }
+        return exponent + p;
+    }
+}
+
+/// Four-lane exp2: the same formula and coefficients as vx1::fastmath::exp2, lane for lane.
+template <vx1::fastmath::Precision P>
+inline Float4 exp2(Float4 x) {
+    using vx1::fastmath::Precision;
+    if constexpr (P == Precision::exact) {
+        alignas(16) float lanes[4];
+        store(lanes, x);
+        for (float& lane : lanes) {
+            lane = std::exp2(lane);
+        }
+        return load4(lanes);
+    } else {
+        x = min(max(x, broadcast4(-126.0f)), broadcast4(126.0f));
+        // floor(): a true compare is an all-ones lane, i.e. −1 as an integer
+        const Int4 truncated = truncate(x);
+        const Int4 whole = truncated + asBits(greater(toFloat(truncated), x));
+        const Float4 f = x - toFloat(whole);
+        Float4 p;
+        if constexpr (P == Precision::high) {
+            p = broadcast4(1.0f) + f * (broadcast4(0.693152473f) + f * (broadcast4(0.2401528f)
+              + f * (broadcast4(0.0558359446f) + f * (broadcast4(0.00897336124f) + f * broadcast4(0.0018853035f)))));
+        } else {
+            p = broadcast4(1.0f) + f * (broadcast4(0.695557116f) + f * (broadcast4(0.226172958f) + f * broadcast4(0.0781459278f)));
+        }
+        return p * fromBits(shiftLeft<23>(whole + broadcastInt4(127)));
+    }
+}
+
+template <vx1::fastmath::Precision P>
+inline Float4 linearToDb(Float4 x) {
+    if constexpr (P == vx1::fastmath::Precision::exact) {
+        alignas(16) float lanes[4];
+        store(lanes, x);
+        for (float& lane : lanes) {
+            lane = vx1::fastmath::linearToDb<P>(lane);
+        }
+        return load4(lanes);
+    } else {
+        return broadcast4(6.02059991f) * log2<P>(x);
+    }
+}
+
+template <vx1::fastmath::Precision P>
+inline Float4 dbToLinear(Float4 db) {
+    if constexpr (P == vx1::fastmath::Precision::exact) {
+        alignas(16) float lanes[4];
+        store(lanes, db);
+        for (float& lane : lanes) {
+            lane = vx1::fastmath::dbToLinear<P>(lane);
+        }
+        return load4(lanes);
+    } else {
+        return exp2<P>(db * broadcast4(0.166096404f));
+    }
+}
+
+}
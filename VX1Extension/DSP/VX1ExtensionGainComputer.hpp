@@ -0,0 +1,150 @@
+//
+//  VX1ExtensionGainComputer.hpp
+//  VX1Extension
+//
+//  Hard-knee gain computer shared by both compression passes.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "VX1ExtensionFastMath.hpp"
+
+// Compile-time precision of the per-sample dB conversions:
+//   0 = exact (std::log10 / std::pow), 1 = high (default), 2 = fast.
+// See vx1::fastmath::Precision for the error bounds of each level.
+#ifndef VX1_GAIN_COMPUTER_PRECISION
+#define VX1_GAIN_COMPUTER_PRECISION 1
+#endif
+
+/**
+ VX1GainComputer
+
+ Everything that depends only on parameters — threshold, slope, the Stack
+ pass-2 threshold and makeup, the gate threshold in linear — is cached when
+ a parameter changes (event time). The per-sample path is then one log2 of
+ the envelope and one exp2 for the applied gain, both at the selected
+ Precision, with no std::pow/std::log10 calls.
+ */
+template <vx1::fastmath::Precision P>
+class VX1GainComputer {
+public:
+    static constexpr vx1::fastmath::Precision kPrecision = P;
+
+    // MARK: - Event-time configuration
+
+    void setCompression(float thresholdDb, float ratio) {
+        mThresholdDb = thresholdDb;
+        mSlope = 1.0f - 1.0f / ratio;
+        updateStack();
+    }
+
+    /// Per-sample variant of setCompression() for parameter ramps: takes the slope
+    /// directly and derives the Stack makeup with the Precision-P dB conversion
+    /// instead of std::pow.
+    void rampCompression(float thresholdDb, float slope) {
+        mThresholdDb = thresholdDb;
+        mSlope = slope;
+        const float extraThresholdDb = thresholdDb * mStackBlend * 0.5f;
+        mThresholdDb2 = thresholdDb + extraThresholdDb;
+        mStackMakeupGain = mStackBlend > 0.0f ? vx1::fastmath::dbToLinear<P>(-extraThresholdDb * slope) : 1.0f;
+    }
+
+    void setStack(float stackPercent) {
+        mStackBlend = stackPercent / 100.0f;
+        updateStack();
+    }
+
+    void setGateThreshold(float gateThresholdDb) {
+        mGateThresholdLinear = std::pow(10.0f, gateThresholdDb / 20.0f);
+    }
+
+    // MARK: - Per-sample
+
+    /// Pass-1 gain reduction in dB (≥ 0) for the given envelope level.
+    float gainReductionDb(float envelopeLevel) const {
+        return reduction(envelopeLevel, mThresholdDb);
+    }
+
+    /// Stack pass-2 gain reduction in dB (≥ 0); its threshold is lowered by the Stack amount.
+    float gainReductionDb2(float envelopeLevel) const {
+        return reduction(envelopeLevel, mThresholdDb2);
+    }
+
+    /// Linear gain for a gain reduction in dB: 10^(-dB/20).
+    static float gain(float gainReductionDb) {
+        return vx1::fastmath::dbToLinear<P>(-gainReductionDb);
+    }
+
+    /// gainReductionDb() of four envelopes at once (the multiband band lanes).
+    vx1::simd::Float4 gainReductionDb(vx1::simd::Float4 envelopeLevel) const {
+        using namespace vx1::simd;
+        const Float4 envelopeDb = linearToDb<P>(max(envelopeLevel, broadcast4(1e-6f)));
+        return max(envelopeDb - broadcast4(mThresholdDb), broadcast4(0.0f)) * broadcast4(mSlope);
+    }
+
+    /// gainReductionDb() with its own threshold and slope per lane (VX1KernelBank: one
+    /// instance per lane).
+    static vx1::simd::Float4 gainReductionDb(vx1::simd::Float4 envelopeLevel, vx1::simd::Float4 thresholdDb,
+                                             vx1::simd::Float4 slope) {
+        using namespace vx1::simd;
+        const Float4 envelopeDb = linearToDb<P>(max(envelopeLevel, broadcast4(1e-6f)));
+        return max(envelopeDb - thresholdDb, broadcast4(0.0f)) * slope;
+    }
+
+    /// gain() of four gain reductions at once.
+    static vx1::simd::Float4 gain(vx1::simd::Float4 gainReductionDb) {
+        using namespace vx1::simd;
+        return dbToLinear<P>(broadcast4(0.0f) - gainReductionDb);
+    }
+
+    // MARK: - Cached values
+
+    bool  stackEnabled() const        { return mStackBlend > 0.0f; }
+    float stackMakeupGain() const     { return mStackMakeupGain; }
+    float gateThresholdLinear() const { return mGateThresholdLinear; }
+    float thresholdDb() const         { return mThresholdDb; }
+    float thresholdDb2() const        { return mThresholdDb2; }
+    float slope() const               { return mSlope; }
+
+private:
+    float reduction(float envelopeLevel, float thresholdDb) const {
+        const float envelopeDb = vx1::fastmath::linearToDb<P>(std::max(envelopeLevel, 1e-6f));
+        const float overThresholdDb = envelopeDb - thresholdDb;
+        return overThresholdDb > 0.0f ? overThresholdDb * mSlope : 0.0f;
+    }
+
+    /*
+     Stack lowers the second stage's threshold proportionally (halved in dB at 100%)
+     and auto-makeup compensates for the expected additional GR of pass 2:
+       extraThresholdDb = thresholdDb * stackBlend * 0.5  (negative number)
+       expectedGR2Db    = -extraThresholdDb * (1 - 1/ratio)
+     At Stack = 0 the makeup is exactly 1.0.
+     */
+    void updateStack() {
+        mThresholdDb2 = mThresholdDb + (mThresholdDb * mStackBlend * 0.5f);
+        mStackMakeupGain = 1.0f;
+        if (mStackBlend > 0.0f) {
+            float extraThresholdDb = mThresholdDb * mStackBlend * 0.5f;
+            float expectedGR2Db    = -extraThresholdDb * mSlope;
+            mStackMakeupGain = std::pow(10.0f, expectedGR2Db / 20.0f);
+        }
+    }
+
+    float mThresholdDb = -15.0f;
+    float mSlope = 1.0f - 1.0f / 9.7f;   // 1 - 1/ratio
+    float mStackBlend = 0.0f;
+    float mThresholdDb2 = -15.0f;
+    float mStackMakeupGain = 1.0f;
+    float mGateThresholdLinear = 1e-4f;  // -80 dB
+};
+
+#if VX1_GAIN_COMPUTER_PRECISION == 0
+using VX1ExtensionGainComputer = VX1GainComputer<vx1::fastmath::Precision::exact>;
+#elif VX1_GAIN_COMPUTER_PRECISION == 2
+using VX1ExtensionGainComputer = VX1GainComputer<vx1::fastmath::Precision::fast>;
+#else
+using VX1ExtensionGainComputer = VX1GainComputer<vx1::fastmath::Precision::high>;
+#endif
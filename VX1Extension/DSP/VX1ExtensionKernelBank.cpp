@@ -0,0 +1,324 @@
+//
+//  VX1ExtensionKernelBank.cpp
+//  VX1Extension
+//
+//  Many kernel instances with their detector recursions run side by side in SIMD lanes.
+//
+
+#include "VX1ExtensionKernelBank.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void VX1KernelBank::initialize(int instanceCount, int channelCount, double sampleRate, AUAudioFrameCount maxFrames) {
+    assert(instanceCount >= 1);
+    mMaxFrames = std::max<AUAudioFrameCount>(maxFrames, 1);
+    mKernels.assign(instanceCount, VX1ExtensionDSPKernel());
+    for (VX1ExtensionDSPKernel& kernel : mKernels) {
+        kernel.setMaximumFramesToRender(mMaxFrames);
+        kernel.initialize(channelCount, channelCount, sampleRate);
+    }
+
+    mLaneCount = (instanceCount + kLanes - 1) / kLanes * kLanes;
+    mBanked.assign(instanceCount, 0);
+    mBankedCount = 0;
+    mLaneRows.assign((size_t)kLaneRowCount * mLaneCount, 0.0f);
+    const size_t groupFrames = (size_t)mMaxFrames * kLanes;
+    mGroupAbsMono.assign(groupFrames, 0.0f);
+    mGroupMono.assign(groupFrames, 0.0f);
+    mGroupGate.assign(groupFrames, 0.0f);
+    mGroupGain.assign(groupFrames, 0.0f);
+}
+
+void VX1KernelBank::deInitialize() {
+    for (VX1ExtensionDSPKernel& kernel : mKernels) {
+        kernel.deInitialize();
+    }
+    mBankedCount = 0;
+}
+
+void VX1KernelBank::process(std::span<const InstanceBuffers> instances, AUEventSampleTime bufferStartTime,
+                            AUAudioFrameCount frameCount) {
+    assert(instances.size() == mKernels.size() && frameCount <= mMaxFrames);
+    const VX1RealtimeScope realtimeScope;
+    const int frames = (int)frameCount;
+    mBankedCount = 0;
+
+    if (mBanking) {
+        const VX1DenormalScope denormalScope;
+
+        for (int instance = 0; instance < instanceCount(); ++instance) {
+            if (mKernels[instance].detectorIsBankable(instances[instance].inputBuffers, frameCount)) {
+                mBanked[mBankedCount++] = instance;
+            }
+        }
+        // A group short of kMinGroupSize lanes costs more than its instances alone: they
+        // render through their own process() instead
+        if (mBankedCount % kLanes < kMinGroupSize) mBankedCount -= mBankedCount % kLanes;
+
+        // Stage 1 per instance, then pack its lane
+        for (int lane = 0; lane < mBankedCount; ++lane) {
+            const int instance = mBanked[lane];
+            mKernels[instance].sumDetectorChannels(instances[instance].inputBuffers, {}, 0, frames);
+            packLane(mKernels[instance], lane);
+        }
+        // Lanes past the last instance run on zeros and are discarded
+        const int usedLanes = (mBankedCount + kLanes - 1) / kLanes * kLanes;
+        for (int r = 0; r < kLaneRowCount; ++r) {
+            std::fill(row((LaneRow)r) + mBankedCount, row((LaneRow)r) + usedLanes, 0.0f);
+        }
+
+        for (int firstLane = 0; firstLane < mBankedCount; firstLane += kLanes) {
+            const int groupSize = std::min(kLanes, mBankedCount - firstLane);
+
+            // The group's mono sums, frame-major: one Float4 per frame
+            for (int lane = 0; lane < kLanes; ++lane) {
+                if (lane < groupSize) {
+                    const VX1ExtensionDSPKernel& kernel = mKernels[mBanked[firstLane + lane]];
+                    const float* absMono = kernel.mScratch.data(kernel.mScratchAbsMono);
+                    const float* mono = kernel.mScratch.data(kernel.mScratchMono);
+                    for (int i = 0; i < frames; ++i) {
+                        mGroupAbsMono[(size_t)i * kLanes + lane] = absMono[i];
+                        mGroupMono[(size_t)i * kLanes + lane] = mono[i];
+                    }
+                } else {
+                    for (int i = 0; i < frames; ++i) {
+                        mGroupAbsMono[(size_t)i * kLanes + lane] = 0.0f;
+                        mGroupMono[(size_t)i * kLanes + lane] = 0.0f;
+                    }
+                }
+            }
+
+            const float* stackOn = row(kStackOn) + firstLane;
+            if (std::any_of(stackOn, stackOn + kLanes, [](float on) { return on > 0.5f; })) {
+                processGroup<true>(firstLane, frames);
+            } else {
+                processGroup<false>(firstLane, frames);
+            }
+
+            // Gate and gain rows back to each instance's scratch (row 0: linked detection)
+            for (int lane = 0; lane < groupSize; ++lane) {
+                VX1ExtensionDSPKernel& kernel = mKernels[mBanked[firstLane + lane]];
+                float* gate = kernel.mScratch.data(kernel.mScratchGate);
+                float* gain = kernel.mScratch.data(kernel.mScratchGain);
+                for (int i = 0; i < frames; ++i) {
+                    gate[i] = mGroupGate[(size_t)i * kLanes + lane];
+                    gain[i] = mGroupGain[(size_t)i * kLanes + lane];
+                }
+            }
+        }
+
+        for (int lane = 0; lane < mBankedCount; ++lane) {
+            unpackLane(mKernels[mBanked[lane]], lane);
+        }
+    }
+
+    // Stage 3 onwards, and everything for the instances that were not banked
+    for (int instance = 0; instance < instanceCount(); ++instance) {
+        mKernels[instance].process(instances[instance].inputBuffers, instances[instance].outputBuffers,
+                                   bufferStartTime, frameCount);
+    }
+}
+
+// MARK: - Lanes
+
+void VX1KernelBank::packLane(const VX1ExtensionDSPKernel& kernel, int lane) {
+    const VX1ExtensionGainComputer& gainComputer = kernel.mGainComputer;
+    const float gripBlend = kernel.mParameters.gripPercent / 100.0f;
+    auto set = [&](LaneRow laneRow, float value) { row(laneRow)[lane] = value; };
+
+    set(kGateThreshold, gainComputer.gateThresholdLinear());
+    set(kGateAttack, kernel.mDetector.gateAttackCoeff);
+    set(kGateRelease, kernel.mDetector.gateReleaseCoeff);
+    set(kGateHoldSamples, (float)kernel.mDetector.gateHoldSamples);
+    set(kHpfA0, kernel.mDetector.hpfA0);
+    set(kHpfA1, kernel.mDetector.hpfA1);
+    set(kHpfA2, kernel.mDetector.hpfA2);
+    set(kHpfB1, kernel.mDetector.hpfB1);
+    set(kHpfB2, kernel.mDetector.hpfB2);
+    set(kRmsCoeff, kernel.mDetector.rmsCoeff);
+    set(kGrip, gripBlend);
+    set(kAttack, kernel.mDetector.attackCoeff * (1.0f - gripBlend) + kernel.mDetector.instantCoeff * gripBlend);
+    set(kRelease, kernel.mDetector.releaseCoeff);
+    set(kThresholdDb, gainComputer.thresholdDb());
+    set(kThresholdDb2, gainComputer.thresholdDb2());
+    set(kSlope, gainComputer.slope());
+    set(kStackOn, gainComputer.stackEnabled() ? 1.0f : 0.0f);
+    set(kStackMakeup, gainComputer.stackMakeupGain());
+    set(kOvershootRelease, kernel.mDetector.overshootReleaseCoeff);
+    set(kOvershootHoldSamples, (float)kernel.mDetector.overshootHoldSamples);
+
+    set(kGateEnvelope, kernel.mDetector.gateEnvelope);
+    set(kGateGain, kernel.mDetector.gateGain);
+    set(kGateHold, (float)kernel.mDetector.gateHoldCounter);
+    set(kGateOpen, kernel.mDetector.gateOpen ? 1.0f : 0.0f);
+    set(kHpfX1, kernel.mDetector.hpfX1);
+    set(kHpfX2, kernel.mDetector.hpfX2);
+    set(kHpfY1, kernel.mDetector.hpfY1);
+    set(kHpfY2, kernel.mDetector.hpfY2);
+    set(kRmsState, kernel.mDetector.rmsState);
+    set(kEnvelope, kernel.mDetector.envelopeLevel);
+    set(kPrevGainReductionDb, kernel.mDetector.prevGainReductionDb);
+    set(kOvershootDb, kernel.mDetector.overshootDb);
+    set(kOvershootHold, (float)kernel.mDetector.overshootHoldCounter);
+    set(kRmsState2, kernel.mDetector.rmsState2);
+    set(kEnvelope2, kernel.mDetector.envelopeLevel2);
+    set(kPrevGainReductionDb2, kernel.mDetector.prevGainReductionDb2);
+    set(kOvershootDb2, kernel.mDetector.overshootDb2);
+    set(kOvershootHold2, (float)kernel.mDetector.overshootHoldCounter2);
+}
+
+void VX1KernelBank::unpackLane(VX1ExtensionDSPKernel& kernel, int lane) {
+    auto get = [&](LaneRow laneRow) { return row(laneRow)[lane]; };
+
+    kernel.mDetector.gateEnvelope = get(kGateEnvelope);
+    kernel.mDetector.gateGain = get(kGateGain);
+    kernel.mDetector.gateHoldCounter = (int)get(kGateHold);
+    kernel.mDetector.gateOpen = get(kGateOpen) > 0.5f;
+    kernel.mDetector.hpfX1 = get(kHpfX1);
+    kernel.mDetector.hpfX2 = get(kHpfX2);
+    kernel.mDetector.hpfY1 = get(kHpfY1);
+    kernel.mDetector.hpfY2 = get(kHpfY2);
+    kernel.mDetector.rmsState = get(kRmsState);
+    kernel.mDetector.envelopeLevel = get(kEnvelope);
+    kernel.mDetector.prevGainReductionDb = get(kPrevGainReductionDb);
+    kernel.mDetector.overshootDb = get(kOvershootDb);
+    kernel.mDetector.overshootHoldCounter = (int)get(kOvershootHold);
+    kernel.mDetector.rmsState2 = get(kRmsState2);
+    kernel.mDetector.envelopeLevel2 = get(kEnvelope2);
+    kernel.mDetector.prevGainReductionDb2 = get(kPrevGainReductionDb2);
+    kernel.mDetector.overshootDb2 = get(kOvershootDb2);
+    kernel.mDetector.overshootHoldCounter2 = (int)get(kOvershootHold2);
+
+    kernel.mDetectorPrecomputed = true;
+    kernel.mPrecomputedPeakGainReductionDb = get(kPeakGainReductionDb);
+}
+
+// MARK: - Detector Lanes
+
+template <bool Stack>
+void VX1KernelBank::processGroup(int firstLane, int frameCount) {
+    using namespace vx1::simd;
+    auto lanes = [&](LaneRow laneRow) { return load4(row(laneRow) + firstLane); };
+
+    const Float4 zero = broadcast4(0.0f), one = broadcast4(1.0f), jumpDb = broadcast4(3.0f);
+    const Float4 gateThreshold = lanes(kGateThreshold);
+    const Float4 gateAttack = lanes(kGateAttack), gateRelease = lanes(kGateRelease);
+    const Float4 gateHoldSamples = lanes(kGateHoldSamples);
+    const Float4 hpfA0 = lanes(kHpfA0), hpfA1 = lanes(kHpfA1), hpfA2 = lanes(kHpfA2);
+    const Float4 hpfB1 = lanes(kHpfB1), hpfB2 = lanes(kHpfB2);
+    const Float4 rmsCoeff = lanes(kRmsCoeff), rmsInput = one - rmsCoeff;
+    const Float4 grip = lanes(kGrip), rmsShare = one - grip;
+    const Float4 attack = lanes(kAttack), release = lanes(kRelease);
+    const Float4 thresholdDb = lanes(kThresholdDb), thresholdDb2 = lanes(kThresholdDb2), slope = lanes(kSlope);
+    const Float4 stackOn = greater(lanes(kStackOn), broadcast4(0.5f));
+    const Float4 stackMakeup = lanes(kStackMakeup);
+    const Float4 overshootRelease = lanes(kOvershootRelease), overshootHoldSamples = lanes(kOvershootHoldSamples);
+
+    // Recursive state lives in registers for the whole block, as in processDetectorLinked()
+    Float4 gateEnvelope = lanes(kGateEnvelope), gateGain = lanes(kGateGain);
+    Float4 gateHold = lanes(kGateHold), gateOpen = lanes(kGateOpen);
+    Float4 hpfX1 = lanes(kHpfX1), hpfX2 = lanes(kHpfX2), hpfY1 = lanes(kHpfY1), hpfY2 = lanes(kHpfY2);
+    Float4 rmsState = lanes(kRmsState), envelope = lanes(kEnvelope);
+    Float4 prevGainReductionDb = lanes(kPrevGainReductionDb), overshootDb = lanes(kOvershootDb);
+    Float4 overshootHold = lanes(kOvershootHold);
+    Float4 rmsState2 = lanes(kRmsState2), envelope2 = lanes(kEnvelope2);
+    Float4 prevGainReductionDb2 = lanes(kPrevGainReductionDb2), overshootDb2 = lanes(kOvershootDb2);
+    Float4 overshootHold2 = lanes(kOvershootHold2);
+    Float4 peakGainReductionDb = zero;
+
+    const float* absMono = mGroupAbsMono.data();
+    const float* mono = mGroupMono.data();
+    float* gate = mGroupGate.data();
+    float* gain = mGroupGain.data();
+
+    for (int i = 0; i < frameCount; ++i) {
+        const size_t frame = (size_t)i * kLanes;
+
+        // Noise gate: open while the envelope is at the threshold, then hold, then release
+        const Float4 rawMono = load4(absMono + frame);
+        const Float4 gateCoeff = select(greater(rawMono, gateEnvelope), gateAttack, gateRelease);
+        gateEnvelope = gateCoeff * gateEnvelope + (one - gateCoeff) * rawMono;
+        const Float4 below = greater(gateThreshold, gateEnvelope);
+        const Float4 holding = greater(gateHold, zero);
+        gateGain = select(below, select(holding, one, gateGain * gateRelease), one);
+        gateOpen = select(below, select(holding, gateOpen, zero), one);
+        gateHold = select(below, max(gateHold - one, zero), gateHoldSamples);
+
+        // Sidechain HPF
+        const Float4 monoSC = load4(mono + frame) * gateGain;
+        const Float4 filtered = hpfA0 * monoSC + hpfA1 * hpfX1 + hpfA2 * hpfX2 - hpfB1 * hpfY1 - hpfB2 * hpfY2;
+        hpfX2 = hpfX1; hpfX1 = monoSC;
+        hpfY2 = hpfY1; hpfY1 = filtered;
+        const Float4 absFiltered = abs(filtered);
+
+        // Detector + envelope
+        rmsState = rmsCoeff * rmsState + rmsInput * (absFiltered * absFiltered);
+        const Float4 detection = (sqrt(rmsState) * rmsShare) + (absFiltered * grip);
+        const Float4 coeff = select(greater(detection, envelope), attack, release);
+        envelope = coeff * envelope + (one - coeff) * detection;
+
+        // Gain computer and VCA overshoot
+        const Float4 gainReductionDb = VX1ExtensionGainComputer::gainReductionDb(envelope, thresholdDb, slope);
+        const Float4 jump = greater(gainReductionDb - prevGainReductionDb, jumpDb);
+        overshootDb = select(jump, jumpDb, overshootDb);
+        overshootHold = select(jump, overshootHoldSamples, overshootHold);
+        prevGainReductionDb = gainReductionDb;
+        overshootDb = select(greater(overshootHold, zero), overshootDb, overshootDb * overshootRelease);
+        overshootHold = max(overshootHold - one, zero);
+        const Float4 totalGainReductionDb = gainReductionDb + overshootDb;
+        const Float4 gainReductionTotal = VX1ExtensionGainComputer::gain(totalGainReductionDb);
+        peakGainReductionDb = max(peakGainReductionDb, totalGainReductionDb);
+
+        // Stack second pass, kept only in the lanes that have Stack on
+        Float4 gainReductionTotal2 = one;
+        if constexpr (Stack) {
+            const Float4 absPost1 = abs(monoSC * gainReductionTotal);
+            const Float4 rms2 = rmsCoeff * rmsState2 + rmsInput * (absPost1 * absPost1);
+            const Float4 detection2 = (sqrt(rms2) * rmsShare) + (absPost1 * grip);
+            const Float4 coeff2 = select(greater(detection2, envelope2), attack, release);
+            const Float4 env2 = coeff2 * envelope2 + (one - coeff2) * detection2;
+            const Float4 gainReductionDb2 = VX1ExtensionGainComputer::gainReductionDb(env2, thresholdDb2, slope);
+            const Float4 jump2 = greater(gainReductionDb2 - prevGainReductionDb2, jumpDb);
+            Float4 overshoot2 = select(jump2, jumpDb, overshootDb2);
+            Float4 hold2 = select(jump2, overshootHoldSamples, overshootHold2);
+            overshoot2 = select(greater(hold2, zero), overshoot2, overshoot2 * overshootRelease);
+            hold2 = max(hold2 - one, zero);
+            const Float4 totalGainReductionDb2 = gainReductionDb2 + overshoot2;
+
+            rmsState2 = select(stackOn, rms2, rmsState2);
+            envelope2 = select(stackOn, env2, envelope2);
+            prevGainReductionDb2 = select(stackOn, gainReductionDb2, prevGainReductionDb2);
+            overshootDb2 = select(stackOn, overshoot2, overshootDb2);
+            overshootHold2 = select(stackOn, hold2, overshootHold2);
+            gainReductionTotal2 = select(stackOn, VX1ExtensionGainComputer::gain(totalGainReductionDb2), one);
+            peakGainReductionDb = select(stackOn, max(peakGainReductionDb, totalGainReductionDb + totalGainReductionDb2),
+                                         peakGainReductionDb);
+        }
+
+        // Gate, pass 1, pass 2 and Stack makeup folded into one per-frame gain
+        store(gate + frame, gateGain);
+        store(gain + frame, gateGain * gainReductionTotal * gainReductionTotal2 * stackMakeup);
+    }
+
+    auto storeLanes = [&](LaneRow laneRow, Float4 value) { store(row(laneRow) + firstLane, value); };
+    storeLanes(kGateEnvelope, gateEnvelope);
+    storeLanes(kGateGain, gateGain);
+    storeLanes(kGateHold, gateHold);
+    storeLanes(kGateOpen, gateOpen);
+    storeLanes(kHpfX1, hpfX1);
+    storeLanes(kHpfX2, hpfX2);
+    storeLanes(kHpfY1, hpfY1);
+    storeLanes(kHpfY2, hpfY2);
+    storeLanes(kRmsState, rmsState);
+    storeLanes(kEnvelope, envelope);
+    storeLanes(kPrevGainReductionDb, prevGainReductionDb);
+    storeLanes(kOvershootDb, overshootDb);
+    storeLanes(kOvershootHold, overshootHold);
+    storeLanes(kRmsState2, rmsState2);
+    storeLanes(kEnvelope2, envelope2);
+    storeLanes(kPrevGainReductionDb2, prevGainReductionDb2);
+    storeLanes(kOvershootDb2, overshootDb2);
+    storeLanes(kOvershootHold2, overshootHold2);
+    storeLanes(kPeakGainReductionDb, peakGainReductionDb);
+}
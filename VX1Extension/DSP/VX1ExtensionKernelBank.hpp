@@ -0,0 +1,149 @@
+//
+//  VX1ExtensionKernelBank.hpp
+//  VX1Extension
+//
+//  Many kernel instances with their detector recursions run side by side in SIMD lanes.
+//
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "VX1ExtensionDSPKernel.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+/**
+ VX1KernelBank
+
+ N independent VX1ExtensionDSPKernel instances (one per mic channel on a desk, say)
+ that render the same block size together. Each keeps its own parameters, meters
+ and every stage of its own; what the bank shares is the part a single instance
+ cannot vectorize, the per-sample gate → sidechain HPF → RMS/peak detector →
+ envelope → gain computer → overshoot → Stack recursion. An instance has one such
+ chain, so its block engine runs it one frame at a time; the bank runs four
+ instances' chains per Float4 step, one instance per lane, with every coefficient
+ a lane of its own so the instances can be set up differently.
+
+ A block goes:
+   1. each instance that can take a banked detector (detectorIsBankable()) sums its
+      detector channels into its own scratch (stage 1, SIMD across frames)
+   2. those instances are packed four to a lane group: coefficients and recursive
+      state into the lane rows, the mono sums transposed frame-major, and each group
+      runs the recursion over the whole block with its state in registers
+   3. the gate and gain rows go back to each instance's scratch, with its state and
+      peak gain reduction, and the instance renders the rest of its block (Bite,
+      makeup, mix, tube, limiter, meter) through its own process()
+
+ Instances the bank cannot take (unlinked or max link, multiband, an external key,
+ a compress or speed ramp, the scalar engine, bypass, a silent settled block), and
+ the one or two left over past the last full group, just render through their own
+ process(). Packing is redone every block, so an instance
+ moves in and out of the lanes without a discontinuity: the kernel's own state stays
+ the reference, and the lanes hold it only for the block. Per lane the arithmetic is
+ the kernel's own, in the same order, so a banked instance renders what it would
+ alone to float rounding (bit-identical where the compiler does not contract to FMA).
+
+ Nothing allocates after initialize(); process() is realtime-safe.
+ */
+class VX1KernelBank {
+public:
+    /// Instances per Float4 step.
+    static constexpr int kLanes = 4;
+
+    /// Fewest instances a lane group runs with. The step costs about the same however
+    /// many lanes are live, and below three it loses to the instances' own detectors.
+    static constexpr int kMinGroupSize = 3;
+
+    /// One instance's buffers for process(): as for VX1ExtensionDSPKernel::process().
+    struct InstanceBuffers {
+        std::span<float const*> inputBuffers;
+        std::span<float *> outputBuffers;
+    };
+
+    /// Creates instanceCount kernels with channelCount channels each at sampleRate and
+    /// sizes every buffer for blocks of up to maxFrames. Parameters set afterwards go
+    /// through kernel(i).
+    void initialize(int instanceCount, int channelCount, double sampleRate, AUAudioFrameCount maxFrames = 1024);
+    void deInitialize();
+
+    int instanceCount() const {
+        return (int)mKernels.size();
+    }
+
+    VX1ExtensionDSPKernel& kernel(int instance) {
+        return mKernels[instance];
+    }
+
+    /// Banked detectors, on by default. Off, every instance renders through its own
+    /// process(), the same output at the single-instance cost (the benchmark baseline).
+    void setBanking(bool enabled) {
+        mBanking = enabled;
+    }
+
+    bool banking() const {
+        return mBanking;
+    }
+
+    /// Instances whose detector ran in the lanes during the last process().
+    int bankedInstanceCount() const {
+        return mBankedCount;
+    }
+
+    /// Renders frameCount frames (≤ maxFrames) of every instance: instances[i] belongs
+    /// to kernel(i).
+    void process(std::span<const InstanceBuffers> instances, AUEventSampleTime bufferStartTime, AUAudioFrameCount frameCount);
+
+private:
+    /**
+     Lane rows: one row of mLaneCount floats per coefficient or state variable, lane
+     k of a row belonging to the k-th banked instance of the block. Hold counters are
+     whole numbers kept as floats so they share the Float4 arithmetic; the gate's open
+     flag is 1 or 0.
+     */
+    enum LaneRow {
+        // Coefficients
+        kGateThreshold, kGateAttack, kGateRelease, kGateHoldSamples,
+        kHpfA0, kHpfA1, kHpfA2, kHpfB1, kHpfB2,
+        kRmsCoeff, kGrip, kAttack, kRelease,
+        kThresholdDb, kThresholdDb2, kSlope, kStackOn, kStackMakeup,
+        kOvershootRelease, kOvershootHoldSamples,
+        // Recursive state
+        kGateEnvelope, kGateGain, kGateHold, kGateOpen,
+        kHpfX1, kHpfX2, kHpfY1, kHpfY2,
+        kRmsState, kEnvelope, kPrevGainReductionDb, kOvershootDb, kOvershootHold,
+        kRmsState2, kEnvelope2, kPrevGainReductionDb2, kOvershootDb2, kOvershootHold2,
+        // Result
+        kPeakGainReductionDb,
+        kLaneRowCount
+    };
+
+    float* row(LaneRow laneRow) {
+        return mLaneRows.data() + (size_t)laneRow * mLaneCount;
+    }
+
+    /// Copies a kernel's detector coefficients and state into lane `lane`.
+    void packLane(const VX1ExtensionDSPKernel& kernel, int lane);
+
+    /// Copies lane `lane`'s state and peak back into the kernel and marks its detector done.
+    void unpackLane(VX1ExtensionDSPKernel& kernel, int lane);
+
+    /// Stage 2 of the block for lanes [firstLane, firstLane + kLanes): reads the
+    /// frame-major mono sums in mGroupAbsMono / mGroupMono, writes frame-major gate and
+    /// gain into mGroupGate / mGroupGain. Stack compiles the second pass in or out.
+    template <bool Stack>
+    void processGroup(int firstLane, int frameCount);
+
+    std::vector<VX1ExtensionDSPKernel> mKernels;
+    std::vector<int> mBanked;          // kernel index of each lane this block
+    int mBankedCount = 0;
+    int mLaneCount = 0;                // instance count rounded up to whole lane groups
+    bool mBanking = true;
+    AUAudioFrameCount mMaxFrames = 0;
+
+    std::vector<float> mLaneRows;      // kLaneRowCount rows of mLaneCount
+    std::vector<float> mGroupAbsMono;  // frame-major, kLanes per frame
+    std::vector<float> mGroupMono;
+    std::vector<float> mGroupGate;
+    std::vector<float> mGroupGain;
+};
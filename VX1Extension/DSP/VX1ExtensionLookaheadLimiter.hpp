@@ -0,0 +1,218 @@
+//
+//  VX1ExtensionLookaheadLimiter.hpp
+//  VX1Extension
+//
+//  Lookahead brickwall peak limiter for the end of the chain.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "VX1ExtensionDelayLine.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+/**
+ VX1SlidingMax
+
+ Maximum of the last `window` samples in O(1) amortized time per sample. A
+ monotonic deque keeps only the samples that can still become the maximum
+ (values strictly decreasing from front to back). Each sample is pushed once and
+ popped at most once. The deque lives in a power-of-two ring of (index, value)
+ pairs allocated in prepare(), so push() never allocates or branches on wrap.
+ */
+class VX1SlidingMax {
+public:
+    /// Allocates room for windows up to maxWindow samples. Not realtime-safe.
+    void prepare(int maxWindow) {
+        uint32_t capacity = 1;
+        while (capacity < (uint32_t)maxWindow) {
+            capacity <<= 1;
+        }
+        mValues.assign(capacity, 0.0f);
+        mIndices.assign(capacity, 0);
+        mMask = capacity - 1;
+        mWindow = std::min<uint32_t>(std::max(mWindow, 1u), capacity);
+        reset();
+    }
+
+    /// Sets the window length in samples (clamped to the prepared capacity) and clears it.
+    void setWindow(int window) {
+        mWindow = (uint32_t)std::clamp(window, 1, (int)mMask + 1);
+        reset();
+    }
+
+    void reset() {
+        mHead = mTail = 0;
+        mIndex = 0;
+    }
+
+    /// Adds x and returns the maximum of the last `window` samples, x included.
+    float push(float x) {
+        // Indices are consecutive, so at most the front entry leaves the window per sample.
+        // Expired before x is stored: with window == capacity a full ring's next slot is
+        // the head's own.
+        if (mTail != mHead && mIndex - mIndices[mHead & mMask] >= mWindow) {
+            ++mHead;
+        }
+        // Older samples that are not larger than x can never be the maximum again
+        while (mTail != mHead && mValues[(mTail - 1) & mMask] <= x) {
+            --mTail;
+        }
+        mValues[mTail & mMask] = x;
+        mIndices[mTail & mMask] = mIndex;
+        ++mTail;
+        ++mIndex;
+        return mValues[mHead & mMask];
+    }
+
+private:
+    std::vector<float> mValues = std::vector<float>(1, 0.0f);
+    std::vector<uint32_t> mIndices = std::vector<uint32_t>(1, 0);
+    uint32_t mMask = 0;
+    uint32_t mWindow = 1;
+    uint32_t mHead = 0, mTail = 0;   // deque bounds, free-running and masked on access
+    uint32_t mIndex = 0;             // running sample index, wraps harmlessly (unsigned distance)
+};
+
+/**
+ VX1LookaheadLimiter
+
+ Brickwall peak limiter with L = kLookaheadSeconds of lookahead, linked across
+ channels so the image never shifts:
+
+   peak[n]   = max over channels |x[n]|
+   target[n] = min(1, ceiling / max(peak[n−L … n]))     VX1SlidingMax, window L+1
+   hold[n]   = target[n] if it is lower than hold[n−1], else a 1-pole release
+               towards it (never above target[n])
+   gain[n]   = mean(hold[n−L … n])                       box filter, running sum
+   y[n]      = x[n−L] · gain[n]                          VX1DelayLine per channel
+
+ A peak at input frame k lowers target for frames k … k+L, so every term of the
+ box average at frame k+L — where the delayed peak comes out — is at or below the
+ gain it needs. Gain reduction therefore ramps in over the whole lookahead without
+ ever letting the peak through. Output is also clamped to ±ceiling, which catches
+ only the float rounding of the running sum.
+
+ Latency is L samples. Everything is sized in prepare(); process() and reset()
+ never allocate.
+ */
+class VX1LookaheadLimiter {
+public:
+    static constexpr double kLookaheadSeconds = 0.0015;  // 1.5 ms: catches the fastest transients
+    static constexpr double kReleaseSeconds = 0.080;     // 80 ms: no low-frequency ripple
+    static constexpr double kCapacitySampleRate = 768000.0;  // rings are never sized for less
+
+    /// Sizes the delays and scratch for channelCount channels and blocks of up to maxFrames.
+    /// Not realtime-safe. The rings are sized for at least kCapacitySampleRate, so calling
+    /// it again at any rate up to that with the same or fewer channels and frames reuses
+    /// the storage and does not allocate.
+    void prepare(int channelCount, double sampleRate, int maxFrames) {
+        mLookahead = std::max(1, (int)std::lround(kLookaheadSeconds * sampleRate));
+        mReleaseCoeff = std::exp(-1.0f / (float)(kReleaseSeconds * sampleRate));
+        const int maxLookahead = std::max(mLookahead, (int)std::lround(kLookaheadSeconds * kCapacitySampleRate));
+
+        mPeakMax.prepare(maxLookahead + 1);
+        mPeakMax.setWindow(mLookahead + 1);
+
+        uint32_t capacity = 1;
+        while (capacity < (uint32_t)maxLookahead + 1) {
+            capacity <<= 1;
+        }
+        mBox.assign(capacity, 1.0f);
+        mBoxMask = capacity - 1;
+        mBoxScale = 1.0 / (double)(mLookahead + 1);
+
+        mDelays.resize(std::max((int)mDelays.size(), channelCount));
+        for (VX1DelayLine& delay : mDelays) {
+            delay.prepare(maxLookahead);
+            delay.setDelay(mLookahead);
+        }
+        mGain.assign(std::max(maxFrames, 1), 1.0f);
+        reset();
+    }
+
+    void setCeilingDb(float ceilingDb) {
+        mCeiling = std::pow(10.0f, ceilingDb / 20.0f);
+    }
+
+    int latencySamples() const { return mLookahead; }
+
+    void reset() {
+        mPeakMax.reset();
+        std::fill(mBox.begin(), mBox.end(), 1.0f);
+        mBoxWrite = 0;
+        mBoxSum = (double)(mLookahead + 1);
+        mHold = 1.0f;
+        for (VX1DelayLine& delay : mDelays) {
+            delay.reset();
+        }
+    }
+
+    /// Limits channels[c][0, frameCount) in place (frameCount ≤ maxFrames).
+    /// Returns the lowest gain applied in the block (1 when nothing was limited).
+    float process(std::span<float* const> channels, int frameCount) {
+        using namespace vx1::simd;
+
+        const int channelCount = (int)channels.size();
+        const uint32_t boxLength = (uint32_t)mLookahead + 1;
+        float* gain = mGain.data();
+        float minGain = 1.0f;
+
+        // Gain recursion on the linked peak
+        for (int i = 0; i < frameCount; ++i) {
+            float peak = 0.0f;
+            for (int channel = 0; channel < channelCount; ++channel) {
+                peak = std::max(peak, std::abs(channels[channel][i]));
+            }
+            const float windowPeak = mPeakMax.push(peak);
+            const float target = windowPeak > mCeiling ? mCeiling / windowPeak : 1.0f;
+            mHold = target < mHold ? target : target + (mHold - target) * mReleaseCoeff;
+
+            mBoxSum += (double)mHold - (double)mBox[(mBoxWrite - boxLength) & mBoxMask];
+            mBox[mBoxWrite] = mHold;
+            mBoxWrite = (mBoxWrite + 1) & mBoxMask;
+            gain[i] = (float)(mBoxSum * mBoxScale);
+            minGain = std::min(minGain, gain[i]);
+        }
+
+        // Delay the audio by the lookahead and apply the gain
+        const FloatVec vCeiling = broadcast(mCeiling);
+        const FloatVec vFloor = broadcast(-mCeiling);
+        const int vecFrames = vectorFrames(frameCount);
+        for (int channel = 0; channel < channelCount; ++channel) {
+            float* buffer = channels[channel];
+            mDelays[channel].process(buffer, frameCount);
+            int i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                store(buffer + i, min(max(load(buffer + i) * load(gain + i), vFloor), vCeiling));
+            }
+            for (; i < frameCount; ++i) {
+                buffer[i] = std::min(std::max(buffer[i] * gain[i], -mCeiling), mCeiling);
+            }
+        }
+        return minGain;
+    }
+
+private:
+    int mLookahead = 1;
+    float mCeiling = 1.0f;
+    float mReleaseCoeff = 0.0f;
+    float mHold = 1.0f;                  // release envelope, never above the window target
+
+    VX1SlidingMax mPeakMax;
+
+    // Box filter over the last L+1 hold values: power-of-two ring plus a running sum
+    std::vector<float> mBox = std::vector<float>(1, 1.0f);
+    uint32_t mBoxMask = 0;
+    uint32_t mBoxWrite = 0;
+    double mBoxSum = 1.0;
+    double mBoxScale = 1.0;
+
+    std::vector<VX1DelayLine> mDelays;   // per channel, L samples
+    std::vector<float> mGain;            // per-frame gain scratch
+};
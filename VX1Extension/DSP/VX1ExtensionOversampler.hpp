@@ -0,0 +1,265 @@
+//
+//  VX1ExtensionOversampler.hpp
+//  VX1Extension
+//
+//  2x / 4x / 8x polyphase half-band FIR oversampling for the Bite shaper.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "VX1ExtensionDelayLine.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+/**
+ VX1HalfBandStage
+
+ One linear-phase 2x stage, one channel. The prototype is a Kaiser-windowed
+ half-band sinc with 4k+3 taps: every other tap except the centre is zero, so
+ the polyphase split leaves
+   - one branch of (taps+1)/2 symmetric taps (folded into pairs), and
+   - one branch that is a pure delay with the centre tap 0.5.
+ Upsampling therefore costs (taps+1)/4 multiplies per input sample, and
+ downsampling the same per output sample. The even taps are normalised to sum to
+ 0.5 so both branches have exactly unity gain at DC.
+
+ Round-trip latency (up + down) is (taps-1)/2 samples at the lower rate.
+ */
+class VX1HalfBandStage {
+public:
+    static constexpr int kMaxTaps = 63;
+
+    /// Designs the filter (taps ≤ kMaxTaps) and sizes the work buffers for up to
+    /// maxInputFrames lower-rate frames per call. Not realtime-safe; called again with
+    /// the same or fewer frames it reuses the buffers and does not allocate.
+    void prepare(int taps, double kaiserBeta, int maxInputFrames) {
+        assert(taps <= kMaxTaps);
+        mBranchTaps = (taps + 1) / 2;
+        mPairs = mBranchTaps / 2;
+        mCentreDelay = (taps - 3) / 4;
+
+        const int centre = (taps - 1) / 2;
+        std::array<double, kMaxTaps> prototype {};
+        double evenSum = 0.0;
+        for (int n = 0; n < taps; ++n) {
+            const double t = 0.5 * (double)(n - centre);
+            const double sinc = (n == centre) ? 0.5 : 0.5 * std::sin(M_PI * t) / (M_PI * t);
+            const double r = (double)(n - centre) / (double)centre;
+            const double window = besselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(kaiserBeta);
+            prototype[n] = sinc * window;
+            if (n % 2 == 0) evenSum += prototype[n];
+        }
+
+        mDownCoeffs.assign(mPairs, 0.0f);
+        mUpCoeffs.assign(mPairs, 0.0f);
+        for (int m = 0; m < mPairs; ++m) {
+            const double h = prototype[2 * m] * 0.5 / evenSum;
+            mDownCoeffs[m] = (float)h;
+            mUpCoeffs[m] = (float)(2.0 * h);   // zero-stuffing loses half the energy
+        }
+
+        mUpWork.assign(mBranchTaps - 1 + maxInputFrames, 0.0f);
+        mDownEven.assign(mBranchTaps - 1 + maxInputFrames, 0.0f);
+        mDownOdd.assign(mCentreDelay + 1 + maxInputFrames, 0.0f);
+    }
+
+    void reset() {
+        std::fill(mUpWork.begin(), mUpWork.end(), 0.0f);
+        std::fill(mDownEven.begin(), mDownEven.end(), 0.0f);
+        std::fill(mDownOdd.begin(), mDownOdd.end(), 0.0f);
+    }
+
+    /// frameCount input samples → 2·frameCount output samples.
+    void upsample(const float* in, float* out, int frameCount) {
+        using namespace vx1::simd;
+        const int history = mBranchTaps - 1;
+        float* w = mUpWork.data();
+        std::copy_n(in, frameCount, w + history);
+
+        // Output 2n is the filtered branch, output 2n+1 the centre-tap delay x[n - k]
+        const float* delayed = w + mCentreDelay + 1;
+        const int vecFrames = vectorFrames(frameCount);
+        int n = 0;
+        for (; n < vecFrames; n += kWidth) {
+            FloatVec acc = broadcast(0.0f);
+            for (int m = 0; m < mPairs; ++m) {
+                acc = acc + broadcast(mUpCoeffs[m]) * (load(w + history + n - m) + load(w + n + m));
+            }
+            alignas(32) float lanes[kWidth];
+            store(lanes, acc);
+            for (int j = 0; j < kWidth; ++j) {
+                out[2 * (n + j)]     = lanes[j];
+                out[2 * (n + j) + 1] = delayed[n + j];
+            }
+        }
+        for (; n < frameCount; ++n) {
+            float acc = 0.0f;
+            for (int m = 0; m < mPairs; ++m) {
+                acc += mUpCoeffs[m] * (w[history + n - m] + w[n + m]);
+            }
+            out[2 * n]     = acc;
+            out[2 * n + 1] = delayed[n];
+        }
+
+        std::copy_n(w + frameCount, history, w);
+    }
+
+    /// 2·frameCount input samples → frameCount output samples.
+    void downsample(const float* in, float* out, int frameCount) {
+        using namespace vx1::simd;
+        const int evenHistory = mBranchTaps - 1;
+        const int oddHistory = mCentreDelay + 1;
+        float* e = mDownEven.data();
+        float* o = mDownOdd.data();
+        for (int n = 0; n < frameCount; ++n) {
+            e[evenHistory + n] = in[2 * n];
+            o[oddHistory + n]  = in[2 * n + 1];
+        }
+
+        const FloatVec vCentre = broadcast(0.5f);
+        const int vecFrames = vectorFrames(frameCount);
+        int n = 0;
+        for (; n < vecFrames; n += kWidth) {
+            FloatVec acc = vCentre * load(o + n);
+            for (int m = 0; m < mPairs; ++m) {
+                acc = acc + broadcast(mDownCoeffs[m]) * (load(e + evenHistory + n - m) + load(e + n + m));
+            }
+            store(out + n, acc);
+        }
+        for (; n < frameCount; ++n) {
+            float acc = 0.5f * o[n];
+            for (int m = 0; m < mPairs; ++m) {
+                acc += mDownCoeffs[m] * (e[evenHistory + n - m] + e[n + m]);
+            }
+            out[n] = acc;
+        }
+
+        std::copy_n(e + frameCount, evenHistory, e);
+        std::copy_n(o + frameCount, oddHistory, o);
+    }
+
+private:
+    static double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+
+    int mBranchTaps = 0;     // (taps + 1) / 2 non-zero taps in the filtered branch
+    int mPairs = 0;          // symmetric pairs in that branch
+    int mCentreDelay = 0;    // k, for taps = 4k + 3
+    std::vector<float> mUpCoeffs, mDownCoeffs;
+    std::vector<float> mUpWork;               // [history | input] at the lower rate
+    std::vector<float> mDownEven, mDownOdd;   // de-interleaved [history | input] branches
+};
+
+/**
+ VX1Oversampler
+
+ Cascade of up to three half-band stages for one channel:
+   stage 1 (base ↔ 2x):  63 taps, Kaiser β = 8 → ≥ 80 dB stopband, passband to 0.417·fs
+   stages 2–3:           23 taps, Kaiser β = 7 → ≥ 69 dB stopband (the input is
+                          already band-limited to a quarter of their rate)
+
+ The stage latencies add up to a fractional number of base-rate samples at 4x/8x,
+ so a short delay at the highest rate pads the round trip to a whole number of
+ base-rate samples; the rest of the plugin can then be aligned with a plain
+ integer delay (see latencySamples()).
+
+ Every buffer is sized for 8x in prepare(), so setFactor() only clears state and
+ can be called from the render thread.
+ */
+class VX1Oversampler {
+public:
+    static constexpr int kMaxFactor = 8;
+    static constexpr int kFirstStageTaps = 63;
+    static constexpr int kLaterStageTaps = 23;
+
+    /// Whole base-rate samples of round-trip latency at the given factor (1, 2, 4 or 8).
+    static constexpr int latencySamples(int factor) {
+        return (cascadeDelay(factor) + factor - 1) / factor;
+    }
+
+    /// Allocates all stages and buffers for up to maxFrames base-rate frames. Not realtime-safe;
+    /// called again with the same or fewer frames it does not allocate.
+    void prepare(int maxFrames) {
+        mMaxFrames = maxFrames;
+        mStages[0].prepare(kFirstStageTaps, 8.0, maxFrames);
+        mStages[1].prepare(kLaterStageTaps, 7.0, maxFrames * 2);
+        mStages[2].prepare(kLaterStageTaps, 7.0, maxFrames * 4);
+        mIntermediate.assign((size_t)maxFrames * 6, 0.0f);
+        mPad.prepare(kMaxFactor);
+        setFactor(mFactor);
+    }
+
+    /// 1 (off), 2, 4 or 8. Clears the filter state.
+    void setFactor(int factor) {
+        mFactor = factor;
+        mStageCount = factor >= 8 ? 3 : factor >= 4 ? 2 : factor >= 2 ? 1 : 0;
+        mPad.setDelay(latencySamples(factor) * factor - cascadeDelay(factor));
+        reset();
+    }
+
+    int factor() const { return mFactor; }
+
+    void reset() {
+        for (VX1HalfBandStage& stage : mStages) {
+            stage.reset();
+        }
+        mPad.reset();
+    }
+
+    /// frameCount base-rate samples → frameCount·factor() samples in out.
+    void upsample(const float* in, float* out, int frameCount) {
+        float* buffers[3] = { mIntermediate.data(), mIntermediate.data() + 2 * mMaxFrames, out };
+        const float* source = in;
+        int frames = frameCount;
+        for (int s = 0; s < mStageCount; ++s) {
+            float* destination = (s == mStageCount - 1) ? out : buffers[s];
+            mStages[s].upsample(source, destination, frames);
+            source = destination;
+            frames *= 2;
+        }
+        mPad.process(out, frames);
+    }
+
+    /// frameCount·factor() samples → frameCount base-rate samples in out.
+    void downsample(const float* in, float* out, int frameCount) {
+        float* buffers[3] = { mIntermediate.data(), mIntermediate.data() + 2 * mMaxFrames, out };
+        const float* source = in;
+        int frames = frameCount * mFactor;
+        for (int s = mStageCount - 1; s >= 0; --s) {
+            frames /= 2;
+            float* destination = (s == 0) ? out : buffers[s - 1];
+            mStages[s].downsample(source, destination, frames);
+            source = destination;
+        }
+    }
+
+private:
+    /// Round-trip delay of the stage cascade, in samples at the highest rate.
+    /// Each stage contributes (taps - 1) samples at its upper rate.
+    static constexpr int cascadeDelay(int factor) {
+        int delay = 0;
+        for (int rate = 2; rate <= factor; rate *= 2) {
+            delay += ((rate == 2 ? kFirstStageTaps : kLaterStageTaps) - 1) * (factor / rate);
+        }
+        return delay;
+    }
+
+    VX1HalfBandStage mStages[3];
+    VX1DelayLine mPad;                  // rounds the cascade latency up to whole base-rate samples
+    std::vector<float> mIntermediate;   // 2x and 4x intermediate signals
+    int mMaxFrames = 0;
+    int mFactor = 1;
+    int mStageCount = 0;
+};
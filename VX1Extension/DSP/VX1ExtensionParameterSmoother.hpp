@@ -0,0 +1,134 @@
+//
+//  VX1ExtensionParameterSmoother.hpp
+//  VX1Extension
+//
+//  Per-sample parameter ramps for automation and de-zippering.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "VX1ExtensionSIMD.hpp"
+
+/**
+ VX1SmoothedParameter
+
+ A parameter value that moves to a new target over a set number of samples
+ instead of stepping. The kernel uses it for AU parameter ramps
+ (AUParameterEvent::rampDurationSampleFrames), and for plain steps it ramps
+ over a short de-zipper time instead.
+
+   linear       fixed step per sample (dB, percentages, filter coefficients)
+   exponential  fixed ratio per sample, i.e. linear in dB (strictly positive gains;
+                falls back to linear if either end is not positive)
+
+ A ramp lands exactly on the target after the requested number of samples, and
+ from then on current() is the target bit for bit. Static settings therefore
+ sound exactly as before and cost one isRamping() check per block.
+
+ next() advances one sample (scalar engine); fill() writes a block of per-sample
+ values (block engine, SIMD for linear ramps). Both produce identical sequences:
+ sample k of a linear ramp is always start + step·k, never an accumulated sum.
+ */
+class VX1SmoothedParameter {
+public:
+    enum class Curve { linear, exponential };
+
+    explicit VX1SmoothedParameter(Curve curve = Curve::linear) : mCurve(curve) {}
+
+    /// Jumps straight to value and ends any ramp (initialize(), zero-length ramps).
+    void snap(float value) {
+        mStart = mCurrent = mTarget = value;
+        mElapsed = 0;
+        mRemaining = 0;
+    }
+
+    /// Ramps from the current value to target over rampFrames samples (≤ 0 snaps).
+    void setTarget(float target, int rampFrames) {
+        if (rampFrames <= 0) {
+            snap(target);
+            return;
+        }
+        rampFrames = std::min(rampFrames, 1 << 24);  // sample indices stay exact in float
+        mTarget = target;
+        mStart = mCurrent;
+        mElapsed = 0;
+        mRemaining = rampFrames;
+        mExponential = mCurve == Curve::exponential && mStart > 0.0f && target > 0.0f;
+        mStep = mExponential ? std::pow(target / mStart, 1.0f / (float)rampFrames)
+                             : (target - mStart) / (float)rampFrames;
+    }
+
+    bool  isRamping() const { return mRemaining > 0; }
+    float current() const   { return mCurrent; }
+    float target() const    { return mTarget; }
+
+    /// Advances one sample and returns the new value.
+    float next() {
+        if (mRemaining == 0) return mTarget;
+        ++mElapsed;
+        --mRemaining;
+        if (mRemaining == 0) {
+            mCurrent = mTarget;
+        } else {
+            mCurrent = mExponential ? mCurrent * mStep : mStart + mStep * (float)mElapsed;
+        }
+        return mCurrent;
+    }
+
+    /// Advances frameCount samples without producing them, to the same state as
+    /// frameCount next() calls (silent-block fast path).
+    void skip(int frameCount) {
+        const int rampFrames = std::min(frameCount, mRemaining);
+        if (rampFrames <= 0) return;
+        if (mExponential) {
+            for (int i = 0; i < rampFrames; ++i) next();
+            return;
+        }
+        mElapsed += rampFrames;
+        mRemaining -= rampFrames;
+        mCurrent = mRemaining == 0 ? mTarget : mStart + mStep * (float)mElapsed;
+    }
+
+    /// Writes the next frameCount values to out and advances past them.
+    void fill(float* out, int frameCount) {
+        using namespace vx1::simd;
+
+        const int rampFrames = std::min(frameCount, mRemaining);
+        if (mExponential) {
+            for (int i = 0; i < rampFrames; ++i) out[i] = next();
+        } else if (rampFrames > 0) {
+            // start + step·k with k as an exact float index, kWidth frames at a time
+            alignas(64) float lane[kWidth];
+            for (int k = 0; k < kWidth; ++k) lane[k] = (float)(mElapsed + 1 + k);
+            FloatVec index = load(lane);
+            const FloatVec vStart = broadcast(mStart), vStep = broadcast(mStep), vWidth = broadcast((float)kWidth);
+            const int vecFrames = vectorFrames(rampFrames);
+            int i = 0;
+            for (; i < vecFrames; i += kWidth) {
+                store(out + i, vStart + vStep * index);
+                index = index + vWidth;
+            }
+            for (; i < rampFrames; ++i) {
+                out[i] = mStart + mStep * (float)(mElapsed + 1 + i);
+            }
+            mElapsed += rampFrames;
+            mRemaining -= rampFrames;
+            if (mRemaining == 0) out[rampFrames - 1] = mTarget;
+            mCurrent = out[rampFrames - 1];
+        }
+        std::fill(out + std::max(rampFrames, 0), out + frameCount, mTarget);
+    }
+
+private:
+    Curve mCurve;
+    bool  mExponential = false;  // this ramp multiplies (mCurve exponential and both ends > 0)
+    float mStart = 0.0f;         // value when the ramp began
+    float mCurrent = 0.0f;
+    float mTarget = 0.0f;
+    float mStep = 0.0f;          // per-sample increment (linear) or ratio (exponential)
+    int   mElapsed = 0;          // samples since the ramp began
+    int   mRemaining = 0;        // samples left until mCurrent == mTarget
+};
@@ -0,0 +1,81 @@
+//
+//  VX1ExtensionParameterTimeline.hpp
+//  VX1Extension
+//
+//  Per-buffer list of parameter events for the kernel to consume in one pass.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "VX1ExtensionDSPTypes.h"
+
+/// One parameter change, at a frame offset into the buffer it was collected for.
+struct VX1TimelineEvent {
+    AUAudioFrameCount frameOffset = 0;
+    AUParameterAddress address = 0;
+    AUValue value = 0.0f;
+    AUAudioFrameCount rampFrames = 0;   // host ramp duration; 0 = step (de-zippered)
+};
+
+/**
+ VX1ParameterTimeline
+
+ The adapter (AUProcessHelper, vx1-render) collects a buffer's parameter events
+ here in time order and hands the whole buffer to
+ VX1ExtensionDSPKernel::process(…, timeline), instead of calling process() once
+ per gap between events. Storage is reserved at construction, so collecting
+ events on the render thread never allocates: push() refuses events once the
+ timeline is full, and the caller renders what it has so far and starts again.
+ A copy reserves the same capacity (copying is not realtime-safe).
+ */
+class VX1ParameterTimeline {
+public:
+    /// Room for per-sample automation of several parameters in a 1024-frame buffer.
+    static constexpr size_t kDefaultCapacity = 4096;
+
+    explicit VX1ParameterTimeline(size_t capacity = kDefaultCapacity) : mCapacity(capacity) {
+        mEvents.reserve(mCapacity);
+    }
+
+    // A vector's copy only reserves what it holds, so copies reserve the capacity
+    // themselves; there are no move operations, so a moved-from timeline keeps its
+    // storage too.
+    VX1ParameterTimeline(const VX1ParameterTimeline& other) : mCapacity(other.mCapacity) {
+        mEvents.reserve(mCapacity);
+        mEvents.assign(other.mEvents.begin(), other.mEvents.end());
+    }
+
+    VX1ParameterTimeline& operator=(const VX1ParameterTimeline& other) {
+        if (this != &other) {
+            mCapacity = other.mCapacity;
+            mEvents.reserve(mCapacity);
+            mEvents.assign(other.mEvents.begin(), other.mEvents.end());
+        }
+        return *this;
+    }
+
+    void clear() { mEvents.clear(); }
+
+    bool empty() const { return mEvents.empty(); }
+    bool full() const  { return mEvents.size() >= mCapacity; }
+    size_t capacity() const { return mCapacity; }
+
+    /// Appends an event; offsets must not decrease. Returns false (and drops nothing
+    /// already stored) when the timeline is full.
+    bool push(AUAudioFrameCount frameOffset, AUParameterAddress address, AUValue value,
+              AUAudioFrameCount rampFrames = 0) {
+        if (full()) return false;
+        mEvents.push_back({ frameOffset, address, value, rampFrames });
+        return true;
+    }
+
+    std::span<const VX1TimelineEvent> events() const { return mEvents; }
+
+private:
+    size_t mCapacity;
+    std::vector<VX1TimelineEvent> mEvents;
+};
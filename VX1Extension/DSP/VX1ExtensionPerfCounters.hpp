@@ -0,0 +1,257 @@
+//
+//  VX1ExtensionPerfCounters.hpp
+//  VX1Extension
+//
+//  Compile-time-optional render-thread performance counters.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "VX1ExtensionTelemetry.hpp"
+
+// Build the counters into the kernel: 0 = compiled out (default), 1 = on.
+// Compiled out, every hook below is an empty inline function and the counter
+// storage does not exist, so release builds pay nothing.
+#ifndef VX1_PERF_COUNTERS
+#define VX1_PERF_COUNTERS 0
+#endif
+
+namespace vx1::perf {
+
+inline constexpr bool kEnabled = VX1_PERF_COUNTERS != 0;
+
+/// Current CPU tick count: the TSC on x86, the virtual counter on arm64 (coarser,
+/// ~24 MHz on Apple silicon, still far below a block), steady_clock nanoseconds
+/// elsewhere. Always 0 when the counters are compiled out.
+inline uint64_t stamp() {
+    if constexpr (!kEnabled) {
+        return 0;
+    } else {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+}
+
+/// Rate of stamp() in ticks per second, measured against steady_clock over
+/// `duration`. Sleeps; call from a reader thread, never the render thread.
+inline double ticksPerSecond(std::chrono::milliseconds duration = std::chrono::milliseconds(50)) {
+    const auto wallStart = std::chrono::steady_clock::now();
+    const uint64_t tickStart = stamp();
+    std::this_thread::sleep_for(duration);
+    const uint64_t ticks = stamp() - tickStart;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return seconds > 0.0 ? (double)ticks / seconds : 0.0;
+}
+
+}
+
+/**
+ Stages of a kernel block with their own counters. The block engine fuses gate,
+ sidechain HPF, detector, gain computer and Stack into one per-sample recursion
+ (splitting it would cost more than it measures), so they share `detector`; the
+ scalar engine is one per-frame loop and is counted whole as `scalar`.
+ */
+enum class VX1PerfStage : int {
+    detector,    // block engine stages 1–2: mono sums, gate → HPF → detector → gain computer → Stack
+    saturation,  // block engine: per-channel gain, then Bite (shelves, shaper, oversampling)
+    mix,         // makeup and parallel mix
+    tube,        // post-compressor tube stage
+    limiter,     // output limiter
+    scalar,      // scalar engine, whole
+    count
+};
+
+inline constexpr const char* vx1PerfStageName(VX1PerfStage stage) {
+    constexpr const char* kNames[] = { "detector", "saturation", "mix", "tube", "limiter", "scalar" };
+    return kNames[(int)stage];
+}
+
+/**
+ VX1PerfSnapshot
+
+ A reader's copy of the counters. Ticks are stamp() units: convert with
+ vx1::perf::ticksPerSecond(). The histogram counts process() calls by ticks per
+ frame, four buckets per octave (bucketLowerBound()), so it does not depend on
+ the block size; at sample rate fs a bucket at T ticks/frame is a realtime load
+ of T · fs / ticksPerSecond.
+ */
+struct VX1PerfSnapshot {
+    static constexpr int kStageCount = (int)VX1PerfStage::count;
+    static constexpr int kHistogramBuckets = 64;
+
+    bool enabled = vx1::perf::kEnabled;
+    uint64_t blocks = 0;                  // process() calls
+    uint64_t frames = 0;
+    uint64_t ticks = 0;                   // inside process()
+    uint64_t renderBlocks = 0;            // host render calls (AU internalRenderBlock only)
+    uint64_t renderTicks = 0;             // inside internalRenderBlock, event handling included
+    uint64_t worstBlockTicks = 0;         // slowest process() call
+    uint32_t worstBlockFrames = 0;
+    uint64_t denormalBlocks = 0;          // blocks that left subnormal values in recursive state
+    uint64_t silentFrames = 0;            // frames the silent-block fast path skipped
+    std::array<uint64_t, kStageCount> stageTicks {};
+    std::array<uint64_t, kHistogramBuckets> histogram {};
+
+    /// Lowest ticks per frame counted in `bucket` (bucket 0 also holds everything below).
+    static double bucketLowerBound(int bucket) {
+        return std::ldexp(1.0 + (double)(bucket % 4) / 4.0, bucket / 4);
+    }
+
+    double denormalBlockRate() const {
+        return blocks > 0 ? (double)denormalBlocks / (double)blocks : 0.0;
+    }
+};
+
+/**
+ VX1PerfCounters
+
+ Written by the render thread only: every counter is a relaxed atomic updated
+ with a plain load and store (single writer, no read-modify-write), so recording
+ costs a few stamp() reads and adds per block. Any thread can take a snapshot()
+ at any time without blocking the render thread; counters that change during
+ the copy may be one block apart. requestReset() asks the render thread to zero
+ everything at the start of its next block.
+ */
+class VX1PerfCounters {
+public:
+    static constexpr int kStageCount = VX1PerfSnapshot::kStageCount;
+    static constexpr int kHistogramBuckets = VX1PerfSnapshot::kHistogramBuckets;
+
+    // MARK: - Render thread
+
+    void recordStage(VX1PerfStage stage, uint64_t ticks) {
+#if VX1_PERF_COUNTERS
+        add(mStageTicks[(int)stage], ticks);
+#else
+        (void)stage; (void)ticks;
+#endif
+    }
+
+    /// One process() call of frameCount frames that took `ticks`.
+    void recordBlock(uint64_t ticks, uint32_t frameCount, bool denormalHeavy) {
+#if VX1_PERF_COUNTERS
+        if (frameCount == 0) return;
+        add(mBlocks, 1);
+        add(mFrames, frameCount);
+        add(mTicks, ticks);
+        if (denormalHeavy) add(mDenormalBlocks, 1);
+        if (ticks > mWorstBlockTicks.load()) {
+            mWorstBlockTicks.store(ticks);
+            mWorstBlockFrames.store(frameCount);
+        }
+        add(mHistogram[bucket(ticks, frameCount)], 1);
+#else
+        (void)ticks; (void)frameCount; (void)denormalHeavy;
+#endif
+    }
+
+    /// Frames rendered by the silent-block fast path instead of the engine.
+    void recordSilence(uint32_t frameCount) {
+#if VX1_PERF_COUNTERS
+        add(mSilentFrames, frameCount);
+#else
+        (void)frameCount;
+#endif
+    }
+
+    /// One host render call (event collection and process()) that took `ticks`.
+    void recordRender(uint64_t ticks) {
+#if VX1_PERF_COUNTERS
+        add(mRenderBlocks, 1);
+        add(mRenderTicks, ticks);
+#else
+        (void)ticks;
+#endif
+    }
+
+    /// Zeroes the counters if a reader asked for it. Called at the start of a block.
+    void applyPendingReset() {
+#if VX1_PERF_COUNTERS
+        if (!mResetRequested.load()) return;
+        mResetRequested.store(false);
+        for (auto* counter : { &mBlocks, &mFrames, &mTicks, &mRenderBlocks, &mRenderTicks,
+                               &mWorstBlockTicks, &mDenormalBlocks, &mSilentFrames }) {
+            counter->store(0);
+        }
+        mWorstBlockFrames.store(0);
+        for (auto& counter : mStageTicks) counter.store(0);
+        for (auto& counter : mHistogram) counter.store(0);
+#endif
+    }
+
+    // MARK: - Any thread
+
+    void requestReset() {
+#if VX1_PERF_COUNTERS
+        mResetRequested.store(true);
+#endif
+    }
+
+    VX1PerfSnapshot snapshot() const {
+        VX1PerfSnapshot snapshot;
+#if VX1_PERF_COUNTERS
+        snapshot.blocks = mBlocks.load();
+        snapshot.frames = mFrames.load();
+        snapshot.ticks = mTicks.load();
+        snapshot.renderBlocks = mRenderBlocks.load();
+        snapshot.renderTicks = mRenderTicks.load();
+        snapshot.worstBlockTicks = mWorstBlockTicks.load();
+        snapshot.worstBlockFrames = mWorstBlockFrames.load();
+        snapshot.denormalBlocks = mDenormalBlocks.load();
+        snapshot.silentFrames = mSilentFrames.load();
+        for (int stage = 0; stage < kStageCount; ++stage) snapshot.stageTicks[stage] = mStageTicks[stage].load();
+        for (int i = 0; i < kHistogramBuckets; ++i) snapshot.histogram[i] = mHistogram[i].load();
+#endif
+        return snapshot;
+    }
+
+private:
+#if VX1_PERF_COUNTERS
+    using Counter = VX1RelaxedAtomic<uint64_t>;
+
+    static void add(Counter& counter, uint64_t amount) {
+        counter.store(counter.load() + amount);
+    }
+
+    /// Quarter-octave bucket of ticks per frame: the octave from the bit width of the
+    /// ratio in fixed point with two fraction bits, the quarter from the two bits
+    /// below its leading one.
+    static int bucket(uint64_t ticks, uint32_t frameCount) {
+        const uint64_t ratio = (ticks << 2) / frameCount;   // ticks per frame, 2 fraction bits
+        if (ratio < 4) return 0;
+        const int octave = std::bit_width(ratio) - 1;       // ≥ 2
+        const int quarter = (int)((ratio >> (octave - 2)) & 3);
+        return std::min((octave - 2) * 4 + quarter, kHistogramBuckets - 1);
+    }
+
+    Counter mBlocks, mFrames, mTicks;
+    Counter mRenderBlocks, mRenderTicks;
+    Counter mWorstBlockTicks, mDenormalBlocks, mSilentFrames;
+    VX1RelaxedAtomic<uint32_t> mWorstBlockFrames;
+    std::array<Counter, kStageCount> mStageTicks;
+    std::array<Counter, kHistogramBuckets> mHistogram;
+    VX1RelaxedAtomic<bool> mResetRequested { false };
+#endif
+};
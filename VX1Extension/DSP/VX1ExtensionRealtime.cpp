@@ -0,0 +1,110 @@
+//
+//  VX1ExtensionRealtime.cpp
+//  VX1Extension
+//
+//  Debug trap for heap allocations on the render thread.
+//
+
+#include "VX1ExtensionRealtime.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdlib.h>
+#include <new>
+
+namespace vx1::realtime {
+
+namespace detail {
+thread_local int scopeDepth = 0;
+}
+
+namespace {
+
+void reportAndAbort(size_t bytes) {
+    std::fprintf(stderr, "VX1: heap allocation of %zu bytes on the render thread\n", bytes);
+    std::abort();
+}
+
+std::atomic<AllocationHandler> gHandler { &reportAndAbort };
+
+}
+
+void setAllocationHandler(AllocationHandler handler) {
+    gHandler.store(handler != nullptr ? handler : &reportAndAbort, std::memory_order_relaxed);
+}
+
+#if VX1_REALTIME_ALLOCATION_TRAP
+
+namespace {
+
+void checkAllocation(size_t bytes) {
+    if (detail::scopeDepth <= 0) return;
+    // The handler runs outside the scope, so reporting can allocate without recursing
+    const int depth = detail::scopeDepth;
+    detail::scopeDepth = 0;
+    gHandler.load(std::memory_order_relaxed)(bytes);
+    detail::scopeDepth = depth;
+}
+
+void* allocate(size_t bytes) {
+    checkAllocation(bytes);
+    return std::malloc(bytes > 0 ? bytes : 1);
+}
+
+void* allocateAligned(size_t bytes, std::align_val_t alignment) {
+    checkAllocation(bytes);
+    const size_t align = std::max((size_t)alignment, sizeof(void*));
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, align, bytes > 0 ? bytes : 1) == 0 ? pointer : nullptr;
+}
+
+}
+
+#endif
+
+}
+
+#if VX1_REALTIME_ALLOCATION_TRAP
+
+// Global replacements: every operator new goes through the check, every delete is free()
+
+void* operator new(size_t bytes) {
+    if (void* pointer = vx1::realtime::allocate(bytes)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t bytes) {
+    if (void* pointer = vx1::realtime::allocate(bytes)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept {
+    return vx1::realtime::allocate(bytes);
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept {
+    return vx1::realtime::allocate(bytes);
+}
+
+void* operator new(size_t bytes, std::align_val_t alignment) {
+    if (void* pointer = vx1::realtime::allocateAligned(bytes, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t bytes, std::align_val_t alignment) {
+    if (void* pointer = vx1::realtime::allocateAligned(bytes, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+#endif
@@ -0,0 +1,68 @@
+//
+//  VX1ExtensionRealtime.hpp
+//  VX1Extension
+//
+//  Debug trap for heap allocations on the render thread.
+//
+
+#pragma once
+
+#include <cstddef>
+
+// Trap heap allocations made inside a VX1RealtimeScope: 0 = off (default), 1 = on.
+// On, VX1ExtensionRealtime.cpp replaces the global operator new / delete for the
+// whole program, and any allocation while the calling thread is inside a scope goes
+// to the allocation handler (by default: a message on stderr, then abort()). Off,
+// the scope is an empty object and operator new is the standard library's.
+#ifndef VX1_REALTIME_ALLOCATION_TRAP
+#define VX1_REALTIME_ALLOCATION_TRAP 0
+#endif
+
+namespace vx1::realtime {
+
+inline constexpr bool kAllocationTrap = VX1_REALTIME_ALLOCATION_TRAP != 0;
+
+/// Receives the size of a trapped allocation. Runs on the offending thread, outside
+/// the scope, so it may allocate itself; if it returns, the allocation goes ahead.
+using AllocationHandler = void (*)(size_t bytes);
+
+/// Replaces the handler (nullptr restores the default). No effect with the trap off.
+void setAllocationHandler(AllocationHandler handler);
+
+namespace detail {
+/// Scope nesting depth of the calling thread (trap builds only).
+extern thread_local int scopeDepth;
+}
+
+/// True while the calling thread is inside a VX1RealtimeScope (always false with the trap off).
+inline bool inRealtimeScope() {
+    if constexpr (kAllocationTrap) {
+        return detail::scopeDepth > 0;
+    } else {
+        return false;
+    }
+}
+
+}
+
+/**
+ VX1RealtimeScope
+
+ Marks the calling thread as rendering for as long as it is in scope: process(),
+ reset() and VX1KernelBank::process() open one. Scopes nest. In trap builds every
+ heap allocation inside one is reported; in normal builds the scope compiles to
+ nothing.
+ */
+class VX1RealtimeScope {
+public:
+    VX1RealtimeScope() {
+        if constexpr (vx1::realtime::kAllocationTrap) ++vx1::realtime::detail::scopeDepth;
+    }
+
+    ~VX1RealtimeScope() {
+        if constexpr (vx1::realtime::kAllocationTrap) --vx1::realtime::detail::scopeDepth;
+    }
+
+    VX1RealtimeScope(const VX1RealtimeScope&) = delete;
+    VX1RealtimeScope& operator=(const VX1RealtimeScope&) = delete;
+};
@@ -0,0 +1,228 @@
+//
+//  VX1ExtensionSIMD.hpp
+//  VX1Extension
+//
+//  Minimal portable SIMD abstraction for the block engine.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+/**
+ vx1::simd
+
+ One float vector type per target, selected at compile time:
+   - AVX2      → 8 lanes (__m256)
+   - SSE2      → 4 lanes (__m128), baseline on every x86-64 build
+   - NEON      → 4 lanes (float32x4_t), baseline on every Apple Silicon build
+   - otherwise → 1 lane scalar fallback
+
+ Only the handful of operations the kernel's block stages need are provided.
+ All loads/stores are unaligned so callers can pass any frame offset.
+
+ Float4 is four lanes on every target (SSE2 on x86 whatever FloatVec is, NEON,
+ or four scalars) for state that is four wide by nature rather than by frame
+ count — the multiband band lanes. It adds the lane compare/select and the
+ Int4 bit operations the vector log2/exp2 in VX1ExtensionFastMath.hpp need.
+ */
+namespace vx1::simd {
+
+#if defined(__AVX2__)
+
+struct FloatVec {
+    static constexpr int width = 8;
+    __m256 v;
+};
+
+inline FloatVec load(const float* p)               { return { _mm256_loadu_ps(p) }; }
+inline void     store(float* p, FloatVec a)        { _mm256_storeu_ps(p, a.v); }
+inline FloatVec broadcast(float x)                 { return { _mm256_set1_ps(x) }; }
+inline FloatVec operator+(FloatVec a, FloatVec b)  { return { _mm256_add_ps(a.v, b.v) }; }
+inline FloatVec operator-(FloatVec a, FloatVec b)  { return { _mm256_sub_ps(a.v, b.v) }; }
+inline FloatVec operator*(FloatVec a, FloatVec b)  { return { _mm256_mul_ps(a.v, b.v) }; }
+inline FloatVec operator/(FloatVec a, FloatVec b)  { return { _mm256_div_ps(a.v, b.v) }; }
+inline FloatVec min(FloatVec a, FloatVec b)        { return { _mm256_min_ps(a.v, b.v) }; }
+inline FloatVec max(FloatVec a, FloatVec b)        { return { _mm256_max_ps(a.v, b.v) }; }
+inline FloatVec abs(FloatVec a)                    { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct FloatVec {
+    static constexpr int width = 4;
+    __m128 v;
+};
+
+inline FloatVec load(const float* p)               { return { _mm_loadu_ps(p) }; }
+inline void     store(float* p, FloatVec a)        { _mm_storeu_ps(p, a.v); }
+inline FloatVec broadcast(float x)                 { return { _mm_set1_ps(x) }; }
+inline FloatVec operator+(FloatVec a, FloatVec b)  { return { _mm_add_ps(a.v, b.v) }; }
+inline FloatVec operator-(FloatVec a, FloatVec b)  { return { _mm_sub_ps(a.v, b.v) }; }
+inline FloatVec operator*(FloatVec a, FloatVec b)  { return { _mm_mul_ps(a.v, b.v) }; }
+inline FloatVec operator/(FloatVec a, FloatVec b)  { return { _mm_div_ps(a.v, b.v) }; }
+inline FloatVec min(FloatVec a, FloatVec b)        { return { _mm_min_ps(a.v, b.v) }; }
+inline FloatVec max(FloatVec a, FloatVec b)        { return { _mm_max_ps(a.v, b.v) }; }
+inline FloatVec abs(FloatVec a)                    { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+struct FloatVec {
+    static constexpr int width = 4;
+    float32x4_t v;
+};
+
+inline FloatVec load(const float* p)               { return { vld1q_f32(p) }; }
+inline void     store(float* p, FloatVec a)        { vst1q_f32(p, a.v); }
+inline FloatVec broadcast(float x)                 { return { vdupq_n_f32(x) }; }
+inline FloatVec operator+(FloatVec a, FloatVec b)  { return { vaddq_f32(a.v, b.v) }; }
+inline FloatVec operator-(FloatVec a, FloatVec b)  { return { vsubq_f32(a.v, b.v) }; }
+inline FloatVec operator*(FloatVec a, FloatVec b)  { return { vmulq_f32(a.v, b.v) }; }
+inline FloatVec operator/(FloatVec a, FloatVec b)  { return { vdivq_f32(a.v, b.v) }; }
+inline FloatVec min(FloatVec a, FloatVec b)        { return { vminq_f32(a.v, b.v) }; }
+inline FloatVec max(FloatVec a, FloatVec b)        { return { vmaxq_f32(a.v, b.v) }; }
+inline FloatVec abs(FloatVec a)                    { return { vabsq_f32(a.v) }; }
+
+#else
+
+struct FloatVec {
+    static constexpr int width = 1;
+    float v;
+};
+
+inline FloatVec load(const float* p)               { return { *p }; }
+inline void     store(float* p, FloatVec a)        { *p = a.v; }
+inline FloatVec broadcast(float x)                 { return { x }; }
+inline FloatVec operator+(FloatVec a, FloatVec b)  { return { a.v + b.v }; }
+inline FloatVec operator-(FloatVec a, FloatVec b)  { return { a.v - b.v }; }
+inline FloatVec operator*(FloatVec a, FloatVec b)  { return { a.v * b.v }; }
+inline FloatVec operator/(FloatVec a, FloatVec b)  { return { a.v / b.v }; }
+inline FloatVec min(FloatVec a, FloatVec b)        { return { std::min(a.v, b.v) }; }
+inline FloatVec max(FloatVec a, FloatVec b)        { return { std::max(a.v, b.v) }; }
+inline FloatVec abs(FloatVec a)                    { return { std::fabs(a.v) }; }
+
+#endif
+
+// MARK: - Four-lane vectors
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+struct Float4 { __m128 v; };
+struct Int4   { __m128i v; };
+
+inline Float4 load4(const float* p)                { return { _mm_loadu_ps(p) }; }
+inline void   store(float* p, Float4 a)            { _mm_storeu_ps(p, a.v); }
+inline Float4 broadcast4(float x)                  { return { _mm_set1_ps(x) }; }
+inline Int4   broadcastInt4(int32_t x)             { return { _mm_set1_epi32(x) }; }
+inline Float4 operator+(Float4 a, Float4 b)        { return { _mm_add_ps(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b)        { return { _mm_sub_ps(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b)        { return { _mm_mul_ps(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b)        { return { _mm_div_ps(a.v, b.v) }; }
+inline Float4 min(Float4 a, Float4 b)              { return { _mm_min_ps(a.v, b.v) }; }
+inline Float4 max(Float4 a, Float4 b)              { return { _mm_max_ps(a.v, b.v) }; }
+inline Float4 abs(Float4 a)                        { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline Float4 sqrt(Float4 a)                       { return { _mm_sqrt_ps(a.v) }; }
+inline Float4 greater(Float4 a, Float4 b)          { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+inline Int4   asBits(Float4 a)                     { return { _mm_castps_si128(a.v) }; }
+inline Float4 fromBits(Int4 a)                     { return { _mm_castsi128_ps(a.v) }; }
+inline Float4 toFloat(Int4 a)                      { return { _mm_cvtepi32_ps(a.v) }; }
+inline Int4   truncate(Float4 a)                   { return { _mm_cvttps_epi32(a.v) }; }
+inline Int4   operator+(Int4 a, Int4 b)            { return { _mm_add_epi32(a.v, b.v) }; }
+inline Int4   operator&(Int4 a, Int4 b)            { return { _mm_and_si128(a.v, b.v) }; }
+inline Int4   operator|(Int4 a, Int4 b)            { return { _mm_or_si128(a.v, b.v) }; }
+template <int N> inline Int4 shiftLeft(Int4 a)     { return { _mm_slli_epi32(a.v, N) }; }
+template <int N> inline Int4 shiftRight(Int4 a)    { return { _mm_srli_epi32(a.v, N) }; }
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+struct Float4 { float32x4_t v; };
+struct Int4   { int32x4_t v; };
+
+inline Float4 load4(const float* p)                { return { vld1q_f32(p) }; }
+inline void   store(float* p, Float4 a)            { vst1q_f32(p, a.v); }
+inline Float4 broadcast4(float x)                  { return { vdupq_n_f32(x) }; }
+inline Int4   broadcastInt4(int32_t x)             { return { vdupq_n_s32(x) }; }
+inline Float4 operator+(Float4 a, Float4 b)        { return { vaddq_f32(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b)        { return { vsubq_f32(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b)        { return { vmulq_f32(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b)        { return { vdivq_f32(a.v, b.v) }; }
+inline Float4 min(Float4 a, Float4 b)              { return { vminq_f32(a.v, b.v) }; }
+inline Float4 max(Float4 a, Float4 b)              { return { vmaxq_f32(a.v, b.v) }; }
+inline Float4 abs(Float4 a)                        { return { vabsq_f32(a.v) }; }
+inline Float4 sqrt(Float4 a)                       { return { vsqrtq_f32(a.v) }; }
+inline Float4 greater(Float4 a, Float4 b)          { return { vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)) }; }
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+}
+inline Int4   asBits(Float4 a)                     { return { vreinterpretq_s32_f32(a.v) }; }
+inline Float4 fromBits(Int4 a)                     { return { vreinterpretq_f32_s32(a.v) }; }
+inline Float4 toFloat(Int4 a)                      { return { vcvtq_f32_s32(a.v) }; }
+inline Int4   truncate(Float4 a)                   { return { vcvtq_s32_f32(a.v) }; }
+inline Int4   operator+(Int4 a, Int4 b)            { return { vaddq_s32(a.v, b.v) }; }
+inline Int4   operator&(Int4 a, Int4 b)            { return { vandq_s32(a.v, b.v) }; }
+inline Int4   operator|(Int4 a, Int4 b)            { return { vorrq_s32(a.v, b.v) }; }
+template <int N> inline Int4 shiftLeft(Int4 a)     { return { vshlq_n_s32(a.v, N) }; }
+template <int N> inline Int4 shiftRight(Int4 a)    { return { vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.v), N)) }; }
+
+#else
+
+struct Float4 { float v[4]; };
+struct Int4   { int32_t v[4]; };
+
+template <typename Lanes, typename Op>
+inline Lanes eachLane(Op op) {
+    Lanes result;
+    for (int lane = 0; lane < 4; ++lane) result.v[lane] = op(lane);
+    return result;
+}
+
+inline Float4 load4(const float* p)                { return eachLane<Float4>([&](int i) { return p[i]; }); }
+inline void   store(float* p, Float4 a)            { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+inline Float4 broadcast4(float x)                  { return eachLane<Float4>([&](int) { return x; }); }
+inline Int4   broadcastInt4(int32_t x)             { return eachLane<Int4>([&](int) { return x; }); }
+inline Float4 operator+(Float4 a, Float4 b)        { return eachLane<Float4>([&](int i) { return a.v[i] + b.v[i]; }); }
+inline Float4 operator-(Float4 a, Float4 b)        { return eachLane<Float4>([&](int i) { return a.v[i] - b.v[i]; }); }
+inline Float4 operator*(Float4 a, Float4 b)        { return eachLane<Float4>([&](int i) { return a.v[i] * b.v[i]; }); }
+inline Float4 operator/(Float4 a, Float4 b)        { return eachLane<Float4>([&](int i) { return a.v[i] / b.v[i]; }); }
+inline Float4 min(Float4 a, Float4 b)              { return eachLane<Float4>([&](int i) { return std::min(a.v[i], b.v[i]); }); }
+inline Float4 max(Float4 a, Float4 b)              { return eachLane<Float4>([&](int i) { return std::max(a.v[i], b.v[i]); }); }
+inline Float4 abs(Float4 a)                        { return eachLane<Float4>([&](int i) { return std::fabs(a.v[i]); }); }
+inline Float4 sqrt(Float4 a)                       { return eachLane<Float4>([&](int i) { return std::sqrt(a.v[i]); }); }
+inline Int4   asBits(Float4 a)                     { Int4 r; std::memcpy(r.v, a.v, sizeof r.v); return r; }
+inline Float4 fromBits(Int4 a)                     { Float4 r; std::memcpy(r.v, a.v, sizeof r.v); return r; }
+inline Float4 greater(Float4 a, Float4 b)          { return fromBits(eachLane<Int4>([&](int i) { return a.v[i] > b.v[i] ? -1 : 0; })); }
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    const Int4 bits = asBits(mask);
+    return eachLane<Float4>([&](int i) { return bits.v[i] != 0 ? a.v[i] : b.v[i]; });
+}
+inline Float4 toFloat(Int4 a)                      { return eachLane<Float4>([&](int i) { return (float)a.v[i]; }); }
+inline Int4   truncate(Float4 a)                   { return eachLane<Int4>([&](int i) { return (int32_t)a.v[i]; }); }
+inline Int4   operator+(Int4 a, Int4 b)            { return eachLane<Int4>([&](int i) { return a.v[i] + b.v[i]; }); }
+inline Int4   operator&(Int4 a, Int4 b)            { return eachLane<Int4>([&](int i) { return a.v[i] & b.v[i]; }); }
+inline Int4   operator|(Int4 a, Int4 b)            { return eachLane<Int4>([&](int i) { return a.v[i] | b.v[i]; }); }
+template <int N> inline Int4 shiftLeft(Int4 a)     { return eachLane<Int4>([&](int i) { return (int32_t)((uint32_t)a.v[i] << N); }); }
+template <int N> inline Int4 shiftRight(Int4 a)    { return eachLane<Int4>([&](int i) { return (int32_t)((uint32_t)a.v[i] >> N); }); }
+
+#endif
+
+constexpr int kWidth = FloatVec::width;
+
+/// Number of leading frames that can be handled in whole vectors.
+inline int vectorFrames(int frameCount) {
+    return frameCount - (frameCount % kWidth);
+}
+
+}
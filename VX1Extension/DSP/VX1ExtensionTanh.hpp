@@ -0,0 +1,97 @@
+//
+//  VX1ExtensionTanh.hpp
+//  VX1Extension
+//
+//  Fast tanh / soft-clip kernels for Bite and the tube models.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "VX1ExtensionFastMath.hpp"
+#include "VX1ExtensionSIMD.hpp"
+
+// Compile-time precision of every tanh in the saturation stages:
+//   0 = exact (std::tanh), 1 = high (default), 2 = fast.
+#ifndef VX1_SATURATION_PRECISION
+#define VX1_SATURATION_PRECISION 1
+#endif
+
+/*
+ Rational Padé approximants of tanh, clamped where they reach ±1:
+
+   high → [7/6]  x(135135 + 17325x² + 378x⁴ + x⁶) / (135135 + 62370x² + 3150x⁴ + 28x⁶)
+          clamp |x| ≤ 4.9718, max |error| 9.6e-5 (only near the clamp; < 2e-8 for |x| < 2)
+   fast → [5/4]  x(945 + 105x² + x⁴) / (945 + 420x² + 15x⁴)
+          clamp |x| ≤ 3.6467, max |error| 1.4e-3
+
+ Measured impact on the Bite stage against std::tanh
+ (1 kHz sine at -6 dBFS, 48 kHz, Compress 0%, Bite 25 / 50 / 100%):
+   high → THD changes by ≤ 0.001 dB; residual RMS -147 / -107 / -96 dBFS
+   fast → THD changes by ≤ 0.005 dB; residual RMS  -92 /  -71 / -69 dBFS
+
+ Both are odd, monotonic and branch-free (two min/max, one divide), so the same
+ formula vectorizes directly in vx1::simd::tanh().
+ */
+
+namespace vx1::fastmath {
+
+#if VX1_SATURATION_PRECISION == 0
+constexpr Precision kSaturationPrecision = Precision::exact;
+#elif VX1_SATURATION_PRECISION == 2
+constexpr Precision kSaturationPrecision = Precision::fast;
+#else
+constexpr Precision kSaturationPrecision = Precision::high;
+#endif
+
+template <Precision P>
+inline float tanh(float x) {
+    if constexpr (P == Precision::exact) {
+        return std::tanh(x);
+    } else if constexpr (P == Precision::high) {
+        x = std::min(std::max(x, -4.97178686f), 4.97178686f);
+        const float x2 = x * x;
+        const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return num / den;
+    } else {
+        x = std::min(std::max(x, -3.64673860f), 3.64673860f);
+        const float x2 = x * x;
+        const float num = x * (945.0f + x2 * (105.0f + x2));
+        const float den = 945.0f + x2 * (420.0f + x2 * 15.0f);
+        return num / den;
+    }
+}
+
+}
+
+namespace vx1::simd {
+
+template <vx1::fastmath::Precision P>
+inline FloatVec tanh(FloatVec x) {
+    using vx1::fastmath::Precision;
+    if constexpr (P == Precision::exact) {
+        alignas(32) float lanes[kWidth];
+        store(lanes, x);
+        for (float& lane : lanes) {
+            lane = std::tanh(lane);
+        }
+        return load(lanes);
+    } else if constexpr (P == Precision::high) {
+        x = min(max(x, broadcast(-4.97178686f)), broadcast(4.97178686f));
+        const FloatVec x2 = x * x;
+        const FloatVec num = x * (broadcast(135135.0f) + x2 * (broadcast(17325.0f) + x2 * (broadcast(378.0f) + x2)));
+        const FloatVec den = broadcast(135135.0f) + x2 * (broadcast(62370.0f) + x2 * (broadcast(3150.0f) + x2 * broadcast(28.0f)));
+        return num / den;
+    } else {
+        x = min(max(x, broadcast(-3.64673860f)), broadcast(3.64673860f));
+        const FloatVec x2 = x * x;
+        const FloatVec num = x * (broadcast(945.0f) + x2 * (broadcast(105.0f) + x2));
+        const FloatVec den = broadcast(945.0f) + x2 * (broadcast(420.0f) + x2 * broadcast(15.0f));
+        return num / den;
+    }
+}
+
+}
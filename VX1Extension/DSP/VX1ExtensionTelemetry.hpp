@@ -0,0 +1,183 @@
+//
+//  VX1ExtensionTelemetry.hpp
+//  VX1Extension
+//
+//  Lock-free meter data from the render thread to the UI and loggers.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "VX1ExtensionDSPTypes.h"
+
+/**
+ VX1RelaxedAtomic
+
+ A value written on one thread and read on another without ordering against
+ anything else (meter readouts, enable flags). Unlike std::atomic it can be
+ copied, so the kernel stays a copyable value type for Swift's C++ interop; a
+ copy takes a snapshot of the value.
+ */
+template <typename T>
+class VX1RelaxedAtomic {
+public:
+    VX1RelaxedAtomic(T value = T()) : mValue(value) {}
+    VX1RelaxedAtomic(const VX1RelaxedAtomic& other) : mValue(other.load()) {}
+    VX1RelaxedAtomic& operator=(const VX1RelaxedAtomic& other) {
+        store(other.load());
+        return *this;
+    }
+
+    T load() const       { return mValue.load(std::memory_order_relaxed); }
+    void store(T value)  { mValue.store(value, std::memory_order_relaxed); }
+
+private:
+    std::atomic<T> mValue;
+};
+
+/**
+ VX1SpscRing
+
+ Wait-free single-producer / single-consumer ring of trivially copyable entries.
+ The capacity is rounded up to a power of two and allocated at construction, so
+ push() and pop() never allocate, lock or loop: each is a bounded number of loads
+ and stores. The producer publishes an entry with a release store of the write
+ index, the consumer frees it with a release store of the read index. Each side
+ keeps a cached copy of the other side's index and only re-reads it when the ring
+ looks full (producer) or empty (consumer), so the two threads rarely touch each
+ other's cache line.
+
+ When the ring is full push() drops the new entry and counts it in dropped(); the
+ render thread never waits for a slow consumer.
+
+ Copying makes an empty ring of the same capacity (a ring shared between threads
+ has no meaningful snapshot); copy only while neither thread is using it.
+ */
+template <typename T>
+class VX1SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "ring entries are copied with plain stores");
+
+public:
+    explicit VX1SpscRing(size_t capacity)
+    : mSlots(std::bit_ceil(std::max<size_t>(capacity, 2))), mMask(mSlots.size() - 1) {}
+
+    VX1SpscRing(const VX1SpscRing& other) : VX1SpscRing(other.capacity()) {}
+
+    VX1SpscRing& operator=(const VX1SpscRing& other) {
+        if (this != &other) {
+            mSlots.assign(other.capacity(), T());
+            mMask = mSlots.size() - 1;
+            reset();
+        }
+        return *this;
+    }
+
+    size_t capacity() const { return mSlots.size(); }
+
+    // MARK: - Producer
+
+    /// Appends entry. Returns false (and counts a drop) if the consumer is a full ring behind.
+    bool push(const T& entry) {
+        const uint64_t write = mWrite.load(std::memory_order_relaxed);
+        if (write - mReadCache == mSlots.size()) {
+            mReadCache = mRead.load(std::memory_order_acquire);
+            if (write - mReadCache == mSlots.size()) {
+                mDropped.store(mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        mSlots[write & mMask] = entry;
+        mWrite.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // MARK: - Consumer
+
+    /// Takes the oldest entry. Returns false if the ring is empty.
+    bool pop(T& entry) {
+        const uint64_t read = mRead.load(std::memory_order_relaxed);
+        if (read == mWriteCache) {
+            mWriteCache = mWrite.load(std::memory_order_acquire);
+            if (read == mWriteCache) return false;
+        }
+        entry = mSlots[read & mMask];
+        mRead.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Takes up to maxEntries of the oldest entries into out; returns how many.
+    size_t drain(T* out, size_t maxEntries) {
+        const uint64_t read = mRead.load(std::memory_order_relaxed);
+        mWriteCache = mWrite.load(std::memory_order_acquire);
+        const size_t count = (size_t)std::min<uint64_t>(mWriteCache - read, maxEntries);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = mSlots[(read + i) & mMask];
+        }
+        mRead.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Entries pushed but not yet taken (exact only on the consumer thread).
+    size_t size() const {
+        return (size_t)(mWrite.load(std::memory_order_acquire) - mRead.load(std::memory_order_relaxed));
+    }
+
+    /// Entries push() has dropped because the ring was full.
+    uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+    /// Empties the ring. Not thread-safe: only while neither side is running.
+    void reset() {
+        mWrite.store(0, std::memory_order_relaxed);
+        mRead.store(0, std::memory_order_relaxed);
+        mReadCache = mWriteCache = 0;
+    }
+
+private:
+    std::vector<T> mSlots;
+    size_t mMask;
+
+    // Producer line: write index, its view of the read index, drop counter
+    alignas(64) std::atomic<uint64_t> mWrite { 0 };
+    uint64_t mReadCache = 0;
+    std::atomic<uint64_t> mDropped { 0 };
+
+    // Consumer line: read index and its view of the write index
+    alignas(64) std::atomic<uint64_t> mRead { 0 };
+    uint64_t mWriteCache = 0;
+};
+
+/**
+ VX1TelemetryFrame
+
+ One host buffer as seen by the kernel. Levels are in dBFS across all channels
+ (kFloorDb for silence); gain reductions are positive dB. The pass-1,
+ pass-2 and overshoot values are the detector state at the last frame of the
+ buffer (the loudest lane when unlinked), gainReductionDb is the buffer's peak
+ including the limiter — the value the meter ballistics start from.
+ */
+struct VX1TelemetryFrame {
+    static constexpr float kFloorDb = -144.0f;
+
+    AUEventSampleTime sampleTime = 0;      // first sample of the buffer
+    AUAudioFrameCount frameCount = 0;
+    float inputPeakDb = kFloorDb;
+    float inputRmsDb = kFloorDb;
+    float outputPeakDb = kFloorDb;
+    float outputRmsDb = kFloorDb;
+    float gainReductionDb = 0.0f;          // peak over the buffer, compressor or limiter
+    float pass1GainReductionDb = 0.0f;
+    float pass2GainReductionDb = 0.0f;     // Stack second pass, 0 when Stack is off
+    float overshootDb = 0.0f;              // VCA overshoot of both passes
+    float gateGain = 1.0f;                 // 0 closed … 1 open
+    bool  gateOpen = true;
+    bool  bypassed = false;
+};
+
+using VX1TelemetryRing = VX1SpscRing<VX1TelemetryFrame>;
@@ -0,0 +1,283 @@
+//
+//  VX1ExtensionTubeStage.hpp
+//  VX1Extension
+//
+//  Post-compressor tube saturation: one engine, specialized per curve at compile time.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#include "VX1ExtensionChannelState.hpp"
+#include "VX1ExtensionDenormals.hpp"
+#include "VX1ExtensionSIMD.hpp"
+#include "VX1ExtensionTanh.hpp"
+
+/**
+ Tube curve policies. Each is a set of constants for the shared asymmetric curve
+
+   linear region   x + cubic · x³                    for -negativeThreshold ≤ x ≤ positiveThreshold
+   positive peaks  tanh((x − pT) · positiveSlope) · positiveRange added above pT
+   negative peaks  tanh((x + nT) · negativeSlope) · negativeRange added below -nT
+
+ plus the drive and output gain each model ships with. Standard is the subtle
+ analog warmth of the original TubeSaturation, Warm the "you'll definitely hear
+ it" TaylorWarmTube, Aggressive the heavy-distortion TaylorAggressiveTube.
+ */
+struct VX1TubeCurveStandard {
+    static constexpr float positiveThreshold = 0.7f;
+    static constexpr float negativeThreshold = 0.9f;
+    static constexpr float positiveSlope = 2.0f, positiveRange = 0.3f;
+    static constexpr float negativeSlope = 1.5f, negativeRange = 0.35f;
+    static constexpr float cubic = 0.05f;        // very subtle 3rd harmonic
+    static constexpr float defaultDrive = 1.5f;
+    static constexpr float defaultOutputGain = 0.92f;
+};
+
+struct VX1TubeCurveWarm {
+    static constexpr float positiveThreshold = 0.4f;
+    static constexpr float negativeThreshold = 0.6f;
+    static constexpr float positiveSlope = 2.5f, positiveRange = 0.4f;
+    static constexpr float negativeSlope = 2.0f, negativeRange = 0.45f;
+    static constexpr float cubic = 0.15f;
+    static constexpr float defaultDrive = 5.0f;
+    static constexpr float defaultOutputGain = 0.65f;
+};
+
+struct VX1TubeCurveAggressive {
+    static constexpr float positiveThreshold = 0.2f;
+    static constexpr float negativeThreshold = 0.35f;
+    static constexpr float positiveSlope = 3.0f, positiveRange = 0.5f;
+    static constexpr float negativeSlope = 2.5f, negativeRange = 0.55f;
+    static constexpr float cubic = 0.3f;
+    static constexpr float defaultDrive = 9.0f;
+    static constexpr float defaultOutputGain = 0.45f;
+};
+
+/// Tube parameter values: which curve the kernel's post-compressor stage runs.
+enum class VX1TubeModel { off, standard, warm, aggressive };
+
+/**
+ VX1TubeStage
+
+ Drive → asymmetric curve → 5 Hz DC blocker → output gain, in place on whole
+ blocks of every channel. The curve is branch-free: the input is clamped into the
+ linear region, and the clip regions add one tanh of the distance past whichever
+ threshold was crossed (zero inside), so a block runs kWidth frames per step with
+ one tanh each. The DC blocker is a one-pole recursion per channel over SoA lanes.
+
+ Unlike the three per-sample classes it replaces, the curve is continuous at the
+ thresholds: the clip regions start from the linear region's value there instead
+ of stepping back to the bare threshold, so the cubic term no longer leaves a
+ small jump (and the aliasing it caused) on every peak that crosses a threshold.
+
+ processSample() is the per-sample form of process(), for per-frame callers; the
+ two agree to float rounding (the block form unrolls the DC blocker).
+ */
+template <typename Curve>
+class VX1TubeStage {
+public:
+    static constexpr int kMaxChannels = VX1ChannelState::kMaxChannels;
+
+    VX1TubeStage() {
+        reset();
+    }
+
+    // MARK: - Configuration
+
+    void setSampleRate(double sampleRate) {
+        // High-pass at ~5 Hz removes the offset the asymmetric curve introduces
+        mSampleRate = sampleRate;
+        mDCBlockerCoeff = 1.0f - (float)(2.0 * M_PI * 5.0 / mSampleRate);
+    }
+
+    /// 1.0 = unity/clean; each curve ships with its own default.
+    void setDrive(float drive) {
+        mDrive = std::max(0.1f, drive);
+    }
+
+    float getDrive() const {
+        return mDrive;
+    }
+
+    /// Output level multiplier, typically compensating for the drive boost.
+    void setOutputGain(float gain) {
+        mOutputGain = std::max(0.0f, gain);
+    }
+
+    float getOutputGain() const {
+        return mOutputGain;
+    }
+
+    void setEnabled(bool enabled) {
+        mEnabled = enabled;
+    }
+
+    bool isEnabled() const {
+        return mEnabled;
+    }
+
+    // MARK: - Processing
+
+    /// One sample of `channel`'s lane.
+    float processSample(float input, int channel = 0) {
+        if (!mEnabled) return input;
+        return dcBlock(shape(input * mDrive), channel) * mOutputGain;
+    }
+
+    /// In place on one channel's samples.
+    void processBuffer(float* buffer, int numSamples, int channel = 0) {
+        if (!mEnabled) return;
+        shapeBlock(buffer, numSamples);
+        dcBlockBlock(buffer, numSamples, channel);
+    }
+
+    /// In place on buffers[c] for every channel c (SoA lane c), frameCount frames each.
+    void process(std::span<float* const> buffers, int frameCount) {
+        if (!mEnabled) return;
+        const int channelCount = std::min((int)buffers.size(), kMaxChannels);
+        for (int channel = 0; channel < channelCount; ++channel) {
+            shapeBlock(buffers[channel], frameCount);
+            dcBlockBlock(buffers[channel], frameCount, channel);
+        }
+    }
+
+    void reset() {
+        std::fill_n(mDCBlockerX1, kMaxChannels, 0.0f);
+        std::fill_n(mDCBlockerY1, kMaxChannels, 0.0f);
+    }
+
+    // MARK: - Silence
+
+    /// True if the DC blocker history of lanes [0, channelCount) is within ±floor.
+    bool isSettled(int channelCount, float floor) const {
+        for (int c = 0; c < channelCount; ++c) {
+            if (std::abs(mDCBlockerX1[c]) > floor || std::abs(mDCBlockerY1[c]) > floor) return false;
+        }
+        return true;
+    }
+
+    /// Zeroes DC blocker history that has decayed below vx1::denormals::kFlushFloor.
+    void flushDecayingState(int channelCount) {
+        vx1::denormals::flush(mDCBlockerX1, channelCount);
+        vx1::denormals::flush(mDCBlockerY1, channelCount);
+    }
+
+    bool hasDenormals(int channelCount) const {
+        for (int c = 0; c < channelCount; ++c) {
+            for (float x : { mDCBlockerX1[c], mDCBlockerY1[c] }) {
+                if (std::fpclassify(x) == FP_SUBNORMAL) return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    // MARK: - Curve
+
+    static float shape(float x) {
+        constexpr auto P = vx1::fastmath::kSaturationPrecision;
+        const float linear = std::min(std::max(x, -Curve::negativeThreshold), Curve::positiveThreshold);
+        // Past a threshold exactly one term is non-zero, so one tanh covers both sides
+        const float excess = std::max(x - Curve::positiveThreshold, 0.0f) * Curve::positiveSlope
+                           + std::min(x + Curve::negativeThreshold, 0.0f) * Curve::negativeSlope;
+        const float clipped = vx1::fastmath::tanh<P>(excess);
+        return linear + linear * linear * linear * Curve::cubic
+             + std::max(clipped, 0.0f) * Curve::positiveRange + std::min(clipped, 0.0f) * Curve::negativeRange;
+    }
+
+    static vx1::simd::FloatVec shape(vx1::simd::FloatVec x) {
+        using namespace vx1::simd;
+        constexpr auto P = vx1::fastmath::kSaturationPrecision;
+        const FloatVec zero = broadcast(0.0f);
+        const FloatVec positiveThreshold = broadcast(Curve::positiveThreshold);
+        const FloatVec negativeThreshold = broadcast(Curve::negativeThreshold);
+        const FloatVec linear = min(max(x, zero - negativeThreshold), positiveThreshold);
+        const FloatVec excess = max(x - positiveThreshold, zero) * broadcast(Curve::positiveSlope)
+                              + min(x + negativeThreshold, zero) * broadcast(Curve::negativeSlope);
+        const FloatVec clipped = vx1::simd::tanh<P>(excess);
+        return linear + linear * linear * linear * broadcast(Curve::cubic)
+             + max(clipped, zero) * broadcast(Curve::positiveRange) + min(clipped, zero) * broadcast(Curve::negativeRange);
+    }
+
+    /// Drive and curve in place, kWidth frames per step.
+    void shapeBlock(float* buffer, int frameCount) const {
+        using namespace vx1::simd;
+        const FloatVec drive = broadcast(mDrive);
+        const int vecEnd = vectorFrames(frameCount);
+        for (int i = 0; i < vecEnd; i += kWidth) {
+            store(buffer + i, shape(load(buffer + i) * drive));
+        }
+        for (int i = vecEnd; i < frameCount; ++i) {
+            buffer[i] = shape(buffer[i] * mDrive);
+        }
+    }
+
+    // MARK: - DC Blocker
+
+    /// 1st-order high-pass: y = x − x₁ + coeff · y₁.
+    float dcBlock(float input, int channel) {
+        const float output = input - mDCBlockerX1[channel] + mDCBlockerCoeff * mDCBlockerY1[channel];
+        mDCBlockerX1[channel] = input;
+        mDCBlockerY1[channel] = output;
+        return output;
+    }
+
+    /**
+     DC blocker and output gain in place. With d[n] = x[n] − x[n−1] the recursion is
+     y[n] = d[n] + c · y[n−1]; it is unrolled four frames deep so every output of a step
+     comes from the y carried in from the previous step,
+
+       y[n+k] = c^(k+1) · y[n−1] + Σ_{m≤k} c^(k−m) · d[n+m]
+
+     and the loop-carried chain is one multiply-add per four frames instead of per frame.
+     Equal to dcBlock() up to float rounding.
+     */
+    void dcBlockBlock(float* buffer, int frameCount, int channel) {
+        const float c = mDCBlockerCoeff, c2 = c * c, c3 = c2 * c, c4 = c2 * c2;
+        const float gain = mOutputGain;
+        float x1 = mDCBlockerX1[channel];
+        float y1 = mDCBlockerY1[channel];
+        int i = 0;
+        for (; i + 4 <= frameCount; i += 4) {
+            const float d0 = buffer[i] - x1;
+            const float d1 = buffer[i + 1] - buffer[i];
+            const float d2 = buffer[i + 2] - buffer[i + 1];
+            const float d3 = buffer[i + 3] - buffer[i + 2];
+            x1 = buffer[i + 3];
+            const float y0 = d0 + c * y1;
+            const float yA = d1 + c * d0 + c2 * y1;
+            const float yB = d2 + c * d1 + c2 * d0 + c3 * y1;
+            const float yC = d3 + c * d2 + c2 * d1 + c3 * d0 + c4 * y1;
+            buffer[i] = y0 * gain;
+            buffer[i + 1] = yA * gain;
+            buffer[i + 2] = yB * gain;
+            buffer[i + 3] = yC * gain;
+            y1 = yC;
+        }
+        for (; i < frameCount; ++i) {
+            const float input = buffer[i];
+            const float output = input - x1 + c * y1;
+            x1 = input;
+            y1 = output;
+            buffer[i] = output * gain;
+        }
+        mDCBlockerX1[channel] = x1;
+        mDCBlockerY1[channel] = y1;
+    }
+
+    // MARK: - Member Variables
+
+    double mSampleRate = 44100.0;
+    float mDrive = Curve::defaultDrive;
+    float mOutputGain = Curve::defaultOutputGain;
+    float mDCBlockerCoeff = 0.99f;
+    bool mEnabled = true;
+
+    // DC blocker history, one SoA lane per channel
+    alignas(64) float mDCBlockerX1[kMaxChannels];
+    alignas(64) float mDCBlockerY1[kMaxChannels];
+};
@@ -91,6 +91,101 @@ let VX1ExtensionParameterSpecs = ParameterTreeSpec {
             valueRange: -80.0...(-20.0),
             defaultValue: -80.0
         )
+        ParameterSpec(
+            address: .oversampling,
+            identifier: "oversampling",
+            name: "Bite Oversampling",
+            units: .indexed,
+            valueRange: 0.0...3.0,
+            defaultValue: 0.0,
+            valueStrings: ["Off", "2x", "4x", "8x"]
+        )
+        ParameterSpec(
+            address: .sidechainLink,
+            identifier: "sidechainLink",
+            name: "Sidechain Link",
+            units: .indexed,
+            valueRange: 0.0...3.0,
+            defaultValue: 0.0,
+            valueStrings: ["All", "LCR", "Unlinked", "Max"]
+        )
+        ParameterSpec(
+            address: .limiter,
+            identifier: "limiter",
+            name: "Limiter",
+            units: .indexed,
+            valueRange: 0.0...1.0,
+            defaultValue: 0.0,
+            valueStrings: ["Off", "On"]
+        )
+        ParameterSpec(
+            address: .limiterCeiling,
+            identifier: "limiterCeiling",
+            name: "Ceiling",
+            units: .decibels,
+            valueRange: -12.0...0.0,
+            defaultValue: -1.0
+        )
+        ParameterSpec(
+            address: .tube,
+            identifier: "tube",
+            name: "Tube",
+            units: .indexed,
+            valueRange: 0.0...3.0,
+            defaultValue: 0.0,
+            valueStrings: ["Off", "Standard", "Warm", "Aggressive"]
+        )
+        ParameterSpec(
+            address: .multiband,
+            identifier: "multiband",
+            name: "Multiband",
+            units: .indexed,
+            valueRange: 0.0...3.0,
+            defaultValue: 0.0,
+            valueStrings: ["Off", "2 Bands", "3 Bands", "4 Bands"]
+        )
+        ParameterSpec(
+            address: .crossoverLow,
+            identifier: "crossoverLow",
+            name: "Low Crossover",
+            units: .hertz,
+            valueRange: 40.0...1000.0,
+            defaultValue: 200.0
+        )
+        ParameterSpec(
+            address: .crossoverMid,
+            identifier: "crossoverMid",
+            name: "Mid Crossover",
+            units: .hertz,
+            valueRange: 300.0...5000.0,
+            defaultValue: 1500.0
+        )
+        ParameterSpec(
+            address: .crossoverHigh,
+            identifier: "crossoverHigh",
+            name: "High Crossover",
+            units: .hertz,
+            valueRange: 1000.0...16000.0,
+            defaultValue: 5000.0
+        )
+        ParameterSpec(
+            address: .sidechainSource,
+            identifier: "sidechainSource",
+            name: "Sidechain Source",
+            units: .indexed,
+            valueRange: 0.0...2.0,
+            defaultValue: 0.0,
+            valueStrings: ["Internal", "External", "Mix"]
+        )
+        ParameterSpec(
+            address: .sidechainRate,
+            identifier: "sidechainRate",
+            name: "Sidechain Rate",
+            units: .indexed,
+            valueRange: 0.0...1.0,
+            defaultValue: 0.0,
+            valueStrings: ["Full", "Reduced"]
+        )
     }
 }
 
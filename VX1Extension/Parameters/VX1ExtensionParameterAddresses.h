@@ -7,9 +7,18 @@
 
 #pragma once
 
+#include "VX1ExtensionDSPTypes.h"
+
+// Swift imports the enum through NS_ENUM; the C++ DSP core sees the same
+// enumerators as a plain scoped-underlying-type enum.
+#if defined(__OBJC__)
 #include <AudioToolbox/AUParameters.h>
+#define VX1_PARAMETER_ADDRESS_ENUM(name) typedef NS_ENUM(AUParameterAddress, name)
+#else
+#define VX1_PARAMETER_ADDRESS_ENUM(name) enum name : AUParameterAddress
+#endif
 
-typedef NS_ENUM(AUParameterAddress, VX1ExtensionParameterAddress) {
+VX1_PARAMETER_ADDRESS_ENUM(VX1ExtensionParameterAddress) {
     compress = 0,             // Combined threshold+ratio control: 0% = no compression, 100% = max compression
     speed = 2,                // Speed (ms): sets attack; release = speed * 10
     makeupGain = 4,
@@ -19,5 +28,16 @@ typedef NS_ENUM(AUParameterAddress, VX1ExtensionParameterAddress) {
     bite = 9,
     stack = 10,               // Double-compression blend: 0% = single pass, 100% = double pass
     gainReductionMeter = 11,  // Read-only meter value
-    gateThreshold = 14        // Noise gate threshold: -80 to -20 dB (-80 dB default = off)
+    gateThreshold = 14,       // Noise gate threshold: -80 to -20 dB (-80 dB default = off)
+    oversampling = 15,        // Bite oversampling: 0 = off, 1 = 2x, 2 = 4x, 3 = 8x
+    sidechainLink = 16,       // Detector channel link: 0 = all, 1 = L/R/C, 2 = unlinked, 3 = max of channels
+    limiter = 17,             // Lookahead output limiter: 0 = off, 1 = on (adds 1.5 ms latency)
+    limiterCeiling = 18,      // Limiter ceiling: -12 to 0 dBFS
+    tube = 19,                // Post-compressor tube stage: 0 = off, 1 = standard, 2 = warm, 3 = aggressive
+    multiband = 20,           // Band count: 0 = off (single band), 1 = 2 bands, 2 = 3 bands, 3 = 4 bands
+    crossoverLow = 21,        // Multiband low crossover (Hz): 3 and 4 bands
+    crossoverMid = 22,        // Multiband mid crossover (Hz): 4 bands
+    crossoverHigh = 23,       // Multiband high crossover (Hz): every band count
+    sidechainSource = 24,     // Detector source: 0 = internal, 1 = external key, 2 = mix of both
+    sidechainRate = 25        // Linked detector rate: 0 = full, 1 = reduced (decimated from 176.4 kHz up)
 };